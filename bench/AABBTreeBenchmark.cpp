@@ -0,0 +1,151 @@
+// Measures one tick of a collider tree as the share of the bodies moving per tick grows from 1% to
+// 100%. A tick moves the bodies and then finds every overlapping pair. Moving the leaves of the
+// tree is compared against rebuilding the whole tree every tick, which is what a static index
+// would have to do.
+// Usage: ./AABBTreeBenchmark [bodies] [ticks]
+
+#include "AABBTree.hpp"
+#include "Helpers.hpp"
+#include "Logger.hpp"
+#include "Timetools.hpp"
+
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <utility>
+#include <vector>
+
+
+namespace
+{
+    constexpr float WORLD_SIZE = 4000.0f;
+    constexpr float MAX_SIZE   = 40.0f;
+    constexpr float MAX_SPEED  = 2.0f; // Per tick
+    constexpr float MARGIN     = 4.0f;
+
+    struct Bodies
+    {
+        std::vector<RectangleF> Rects;
+        std::vector<Point2DF>   Velocities;
+    };
+
+    Bodies createBodies(size_t count)
+    {
+        Helpers::random::Generator random(1);
+        Bodies bodies;
+        for (size_t i = 0; i < count; ++i)
+        {
+            bodies.Rects.push_back({
+                random.FloatInRange(0.0f, WORLD_SIZE), random.FloatInRange(0.0f, WORLD_SIZE),
+                random.FloatInRange(4.0f, MAX_SIZE),   random.FloatInRange(4.0f, MAX_SIZE)
+            });
+            bodies.Velocities.push_back({
+                random.FloatInRange(-MAX_SPEED, MAX_SPEED), random.FloatInRange(-MAX_SPEED, MAX_SPEED)
+            });
+        }
+        return bodies;
+    }
+
+    /// Moves every stride:th body, starting from a different body every tick.
+    void moveBodies(Bodies& bodies, size_t stride, size_t tick)
+    {
+        for (size_t i = tick % stride; i < bodies.Rects.size(); i += stride)
+        {
+            RectangleF& rect = bodies.Rects[i];
+            Point2DF&   v    = bodies.Velocities[i];
+            rect.X += v.X;
+            rect.Y += v.Y;
+            if (rect.X < 0.0f || rect.X > WORLD_SIZE) { v.X = -v.X; }
+            if (rect.Y < 0.0f || rect.Y > WORLD_SIZE) { v.Y = -v.Y; }
+        }
+    }
+
+    struct Measurement
+    {
+        double MoveUs;
+        double PairsUs;
+        double RebuildUs;
+        double Reinserted; // Per tick
+        double Pairs;      // Per tick
+    };
+
+    Measurement measure(size_t count, size_t percent, size_t ticks)
+    {
+        const size_t stride = 100 / percent;
+        Bodies bodies = createBodies(count);
+        std::vector<std::pair<size_t, size_t>> pairs;
+
+        AABBTree tree(MARGIN);
+        std::vector<AABBTree::Proxy> proxies;
+        for (size_t i = 0; i < count; ++i) {
+            proxies.push_back(tree.Insert(bodies.Rects[i], i));
+        }
+
+        int64_t moveNs = 0, pairsNs = 0, rebuildNs = 0;
+        size_t  reinserted = 0, pairsCount = 0;
+        Timer timer(false);
+        for (size_t tick = 0; tick < ticks; ++tick)
+        {
+            moveBodies(bodies, stride, tick);
+
+            timer.Reset();
+            for (size_t i = tick % stride; i < count; i += stride) {
+                if (tree.Move(proxies[i], bodies.Rects[i])) {
+                    ++reinserted;
+                }
+            }
+            moveNs += timer.Elapsed<std::chrono::nanoseconds>();
+
+            timer.Reset();
+            pairs.clear();
+            tree.QueryPairs(pairs);
+            pairsNs    += timer.Elapsed<std::chrono::nanoseconds>();
+            pairsCount += pairs.size();
+        }
+
+        // The same ticks, with the tree rebuilt from scratch every tick
+        bodies = createBodies(count);
+        AABBTree rebuilt(MARGIN);
+        for (size_t tick = 0; tick < ticks; ++tick)
+        {
+            moveBodies(bodies, stride, tick);
+
+            timer.Reset();
+            rebuilt.Clear();
+            for (size_t i = 0; i < count; ++i) {
+                rebuilt.Insert(bodies.Rects[i], i);
+            }
+            rebuildNs += timer.Elapsed<std::chrono::nanoseconds>();
+        }
+
+        const double t = static_cast<double>(ticks);
+        return {
+            static_cast<double>(moveNs) / 1000.0 / t,
+            static_cast<double>(pairsNs) / 1000.0 / t,
+            static_cast<double>(rebuildNs) / 1000.0 / t,
+            static_cast<double>(reinserted) / t,
+            static_cast<double>(pairsCount) / t
+        };
+    }
+} // end anonymous namespace
+
+int main(int argc, char* argv[])
+{
+    const size_t count = argc > 1 ? std::max<size_t>(std::strtoul(argv[1], nullptr, 10), 1) : 10000;
+    const size_t ticks = argc > 2 ? std::max<size_t>(std::strtoul(argv[2], nullptr, 10), 1) : 200;
+    Logger::SetLogLevel(Logger::Level::CRITICAL);
+
+    fmt::print("{} bodies, {} ticks per measurement, margin {}\n", count, ticks, MARGIN);
+    fmt::print("{:>8} {:>10} {:>12} {:>10} {:>10} {:>12}\n", "Moving", "Move us", "Reinserted", "Pairs us", "Pairs", "Rebuild us");
+
+    for (size_t percent : { 1u, 5u, 10u, 25u, 50u, 100u })
+    {
+        const Measurement m = measure(count, percent, ticks);
+        fmt::print("{:>7}% {:>10.1f} {:>12.1f} {:>10.1f} {:>10.0f} {:>12.1f}\n",
+            percent, m.MoveUs, m.Reinserted, m.PairsUs, m.Pairs, m.RebuildUs);
+    }
+
+    return EXIT_SUCCESS;
+}
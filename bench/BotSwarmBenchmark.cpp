@@ -0,0 +1,91 @@
+// Measures how long one fixed update of a swarm of bots takes in a FIXED level, for growing amounts of
+// bots and threads. Input is handled every TARGET_UPS / TARGET_FPS updates as in the game. The average
+// and the worst update are compared against the update budget of 1 / TARGET_UPS seconds.
+// Usage: ./BotSwarmBenchmark [seconds]
+
+#include "BotSwarm.hpp"
+#include "Constants.hpp"
+#include "GameLevel.hpp"
+#include "GameObject.hpp"
+#include "Input.hpp"
+#include "Logger.hpp"
+#include "Timetools.hpp"
+
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <thread>
+#include <vector>
+
+
+namespace
+{
+    struct Measurement
+    {
+        double AvgUs;
+        double MaxUs;
+    };
+
+    Measurement measure(const GameLevel& level, size_t count, size_t threadsCount, size_t updates)
+    {
+        BotSwarm bots(count, Constants::Player::MOVE_FORCE, Constants::Player::RADIUS, 1, threadsCount);
+        const Timestep dt(1.0 / static_cast<double>(Constants::TARGET_UPS));
+        const size_t   updatesPerInput = Constants::TARGET_UPS / Constants::TARGET_FPS;
+
+        int64_t totalNs = 0, maxNs = 0;
+        Timer timer(false);
+        for (size_t i = 0; i < updates; ++i)
+        {
+            timer.Reset();
+            bots.Step(level.GetPhysics(), Constants::Level::ARENA_SIZE, level.GetTerrain(), dt, i % updatesPerInput == 0);
+            const int64_t ns = timer.Elapsed<std::chrono::nanoseconds>();
+            totalNs += ns;
+            maxNs    = std::max(maxNs, ns);
+        }
+
+        return {
+            static_cast<double>(totalNs) / 1000.0 / static_cast<double>(updates),
+            static_cast<double>(maxNs) / 1000.0
+        };
+    }
+} // end anonymous namespace
+
+int main(int argc, char* argv[])
+{
+    const size_t seconds  = argc > 1 ? std::max<size_t>(std::strtoul(argv[1], nullptr, 10), 1) : 30;
+    const size_t updates  = seconds * Constants::TARGET_UPS;
+    const double budgetUs = 1.0e6 / static_cast<double>(Constants::TARGET_UPS);
+    const size_t hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+    Logger::SetLogLevel(Logger::Level::CRITICAL);
+
+    Input input;
+    std::unique_ptr<PlayerObject> player = GameObject::CreatePlayer(
+        input, 0.0f, 0.0f, Constants::Player::MOVE_FORCE, Constants::Player::RADIUS, nullptr, Constants::Colors::LIGHT
+    );
+    std::unique_ptr<GameLevel> level = GameLevel::CreateHeadlessLevel(
+        input, GameLevel::Mode::FIXED, Constants::Level::SEED, Constants::Level::ARENA_SIZE,
+        Constants::Level::GRAVITY, Constants::Level::FRICTION, Constants::Level::INITIAL_TIME,
+        player.get()
+    );
+    fmt::print("{}s of game time ({} updates), {} blocks, update budget {:.0f}us\n", seconds, updates, level->GetTerrain().GetCount(), budgetUs);
+    fmt::print("{:>8} {:>8} {:>10} {:>10} {:>10} {:>8}\n", "Bots", "Threads", "Avg us", "Max us", "ns/bot", "Budget");
+
+    for (size_t count : { 1000u, 10000u, 100000u })
+    {
+        for (size_t threadsCount : { size_t(1), hardwareThreads })
+        {
+            const Measurement m = measure(*level, count, threadsCount, updates);
+            fmt::print("{:>8} {:>8} {:>10.1f} {:>10.1f} {:>10.1f} {:>7.1f}%\n",
+                count, threadsCount, m.AvgUs, m.MaxUs, 1000.0 * m.AvgUs / static_cast<double>(count),
+                100.0 * m.AvgUs / budgetUs);
+            if (hardwareThreads == 1) {
+                break;
+            }
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
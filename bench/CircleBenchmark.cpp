@@ -0,0 +1,88 @@
+// Measures the filled circles drawn per millisecond as the radius grows. Drawing every radius from
+// the full radius down to 1 as the outline of a circle, where every pixel is a separate point, is
+// compared against DrawCircleFilled, which fills one span per row of pixels with one call.
+// Usage: ./CircleBenchmark [circles]
+
+#include "Constants.hpp"
+#include "Geometry.hpp"
+#include "Logger.hpp"
+#include "Renderer.hpp"
+#include "Timetools.hpp"
+#include "Window.hpp"
+
+#include <SDL.h>
+#include <algorithm>
+#include <cstdlib>
+
+
+namespace
+{
+    struct Measurement
+    {
+        double ConcentricPerMs;
+        double FilledPerMs;
+        size_t ConcentricCalls; // Per circle
+        size_t FilledCalls;
+    };
+
+    double perMs(int circles, int64_t us)
+    {
+        return static_cast<double>(circles) * 1000.0 / static_cast<double>(std::max<int64_t>(us, 1));
+    }
+
+    Measurement measure(const Renderer& renderer, int radius, int circles)
+    {
+        const Point2D centre = { Constants::RENDER_SIZE.W / 2, Constants::RENDER_SIZE.H / 2 };
+        Measurement m = {};
+        Timer timer(false);
+
+        renderer.SetRenderDrawColor(Constants::Colors::LIGHTEST);
+        for (int i = 0; i < circles; ++i) {
+            for (int r = radius; r > 0; --r) {
+                renderer.DrawCircle(centre, r);
+            }
+        }
+        m.ConcentricPerMs = perMs(circles, timer.Elapsed<std::chrono::microseconds>(true));
+        renderer.RenderPresent();
+        m.ConcentricCalls = renderer.GetFrameDrawCalls() / static_cast<size_t>(circles);
+
+        timer.Reset();
+        for (int i = 0; i < circles; ++i) {
+            renderer.DrawCircleFilled(centre, radius);
+        }
+        m.FilledPerMs = perMs(circles, timer.Elapsed<std::chrono::microseconds>());
+        renderer.RenderPresent();
+        m.FilledCalls = renderer.GetFrameDrawCalls() / static_cast<size_t>(circles);
+
+        return m;
+    }
+} // end anonymous namespace
+
+int main(int argc, char* argv[])
+{
+    const int circles = argc > 1 ? std::max(1, std::atoi(argv[1])) : 1000;
+
+    if (SDL_Init(SDL_INIT_VIDEO) != 0) {
+        Logger::Critical("Unable to initialize SDL: {}", SDL_GetError());
+        return EXIT_FAILURE;
+    }
+
+    {
+        Window   window("CircleBenchmark", Constants::RENDER_SIZE);
+        Renderer renderer(window, false);
+
+        fmt::print("{} circles per measurement\n", circles);
+        fmt::print("{:>8} {:>18} {:>18} {:>14} {:>14}\n",
+            "Radius", "Concentric per ms", "Concentric calls", "Filled per ms", "Filled calls");
+
+        for (int radius : { 8, 16, 32, 64, 128, 256 })
+        {
+            const Measurement m = measure(renderer, radius, circles);
+            fmt::print("{:>8} {:>18.1f} {:>18} {:>14.1f} {:>14}\n",
+                radius, m.ConcentricPerMs, m.ConcentricCalls, m.FilledPerMs, m.FilledCalls);
+        }
+    }
+
+    SDL_Quit();
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,166 @@
+// Measures the collision queries of a player against terrain of growing width. Every block of the
+// terrain stands on the bottom of the level, like the blocks generated by GameLevel. A query finds
+// the blocks overlapping the collision rectangle of the player, in ascending order of x, which is
+// compared between testing the rectangle of every block, querying a collider tree and sorting the
+// hits, and searching the heightfield. The ground height under the player is measured the same way.
+// Usage: ./HeightfieldBenchmark [queries]
+
+#include "AABBTree.hpp"
+#include "Heightfield.hpp"
+#include "Helpers.hpp"
+#include "Logger.hpp"
+#include "Timetools.hpp"
+
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+
+namespace
+{
+    constexpr float BOTTOM = 1000.0f;
+    constexpr float PLAYER = 30.0f; // The size of the collision rectangle of the player
+
+    std::vector<RectangleF> createBlocks(size_t count)
+    {
+        Helpers::random::Generator random(1);
+        std::vector<RectangleF> blocks;
+        float x = 0.0f;
+        for (size_t i = 0; i < count; ++i)
+        {
+            const float width  = random.FloatInRange(60.0f, 250.0f);
+            const float height = random.FloatInRange(30.0f, 400.0f);
+            blocks.push_back({ x, BOTTOM - height, width, height });
+            x += width + random.FloatInRange(0.0f, 300.0f);
+        }
+        return blocks;
+    }
+
+    std::vector<RectangleF> createQueries(const std::vector<RectangleF>& blocks, size_t count)
+    {
+        Helpers::random::Generator random(2);
+        const float width = blocks.back().X + blocks.back().W;
+        std::vector<RectangleF> queries;
+        for (size_t i = 0; i < count; ++i) {
+            queries.push_back({ random.FloatInRange(0.0f, width), random.FloatInRange(0.0f, BOTTOM), PLAYER, PLAYER });
+        }
+        return queries;
+    }
+
+    struct Measurement
+    {
+        double RectsNs; // Per query
+        double TreeNs;
+        double HeightfieldNs;
+        double GroundRectsNs;
+        double GroundHeightfieldNs;
+    };
+
+    double perQuery(int64_t ns, size_t queries)
+    {
+        return static_cast<double>(ns) / static_cast<double>(queries);
+    }
+
+    Measurement measure(size_t blocksCount, size_t queriesCount)
+    {
+        const std::vector<RectangleF> blocks  = createBlocks(blocksCount);
+        const std::vector<RectangleF> queries = createQueries(blocks, queriesCount);
+
+        AABBTree    tree(4.0f);
+        Heightfield heightfield(BOTTOM);
+        for (size_t i = 0; i < blocks.size(); ++i)
+        {
+            tree.Insert(blocks[i], i);
+            heightfield.Add(blocks[i], i);
+        }
+
+        Measurement m = {};
+        std::vector<size_t> hits;
+        size_t rectsHits = 0, treeHits = 0, heightfieldHits = 0;
+        float  rectsGround = 0.0f, heightfieldGround = 0.0f;
+        Timer  timer(false);
+
+        timer.Reset();
+        for (const RectangleF& query : queries) {
+            for (const RectangleF& block : blocks) {
+                if (block.Overlaps(query)) {
+                    ++rectsHits;
+                }
+            }
+        }
+        m.RectsNs = perQuery(timer.Elapsed<std::chrono::nanoseconds>(), queriesCount);
+
+        timer.Reset();
+        for (const RectangleF& query : queries)
+        {
+            hits.clear();
+            tree.QueryOverlaps(query, [&tree, &hits](AABBTree::Proxy proxy)
+            {
+                hits.push_back(tree.GetId(proxy));
+                return true;
+            });
+            std::sort(hits.begin(), hits.end());
+            treeHits += hits.size();
+        }
+        m.TreeNs = perQuery(timer.Elapsed<std::chrono::nanoseconds>(), queriesCount);
+
+        timer.Reset();
+        for (const RectangleF& query : queries)
+        {
+            heightfield.QueryOverlaps(query, [&heightfieldHits](const Heightfield::Span&)
+            {
+                ++heightfieldHits;
+                return true;
+            });
+        }
+        m.HeightfieldNs = perQuery(timer.Elapsed<std::chrono::nanoseconds>(), queriesCount);
+
+        timer.Reset();
+        for (const RectangleF& query : queries)
+        {
+            float ground = BOTTOM;
+            for (const RectangleF& block : blocks) {
+                if (block.X <= query.X && query.X <= block.X + block.W) {
+                    ground = std::min(ground, block.Y);
+                }
+            }
+            rectsGround += ground;
+        }
+        m.GroundRectsNs = perQuery(timer.Elapsed<std::chrono::nanoseconds>(), queriesCount);
+
+        timer.Reset();
+        for (const RectangleF& query : queries) {
+            heightfieldGround += heightfield.GetGroundY(query.X);
+        }
+        m.GroundHeightfieldNs = perQuery(timer.Elapsed<std::chrono::nanoseconds>(), queriesCount);
+
+        if (rectsHits != treeHits || rectsHits != heightfieldHits || rectsGround != heightfieldGround) {
+            Logger::Critical("The queries disagree with {} blocks", blocksCount);
+        }
+        return m;
+    }
+} // end anonymous namespace
+
+int main(int argc, char* argv[])
+{
+    const size_t queries = argc > 1 ? std::max<size_t>(std::strtoul(argv[1], nullptr, 10), 1) : 100000;
+    Logger::SetLogLevel(Logger::Level::CRITICAL);
+
+    fmt::print("{} queries of a {}x{} player per measurement, ns per query\n", queries, PLAYER, PLAYER);
+    fmt::print("{:>8} {:>10} {:>10} {:>12} {:>14} {:>18}\n",
+        "Blocks", "Rects", "Tree", "Heightfield", "Ground rects", "Ground heightfield");
+
+    for (size_t blocks : { 100u, 1000u, 10000u })
+    {
+        // The rectangle tests of every block take too long with many queries
+        const size_t count = blocks >= 10000u ? std::max<size_t>(queries / 10, 1) : queries;
+        const Measurement m = measure(blocks, count);
+        fmt::print("{:>8} {:>10.1f} {:>10.1f} {:>12.1f} {:>14.1f} {:>18.1f}\n",
+            blocks, m.RectsNs, m.TreeNs, m.HeightfieldNs, m.GroundRectsNs, m.GroundHeightfieldNs);
+    }
+
+    return EXIT_SUCCESS;
+}
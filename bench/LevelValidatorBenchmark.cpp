@@ -0,0 +1,75 @@
+// Measures how long it takes to validate the reachability of every block of a very wide level,
+// with one thread and with all the hardware threads.
+// Usage: ./LevelValidatorBenchmark [levelWidth]
+
+#include "Constants.hpp"
+#include "LevelValidator.hpp"
+#include "Physics.hpp"
+#include "Timetools.hpp"
+
+#include <fmt/core.h>
+
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+
+namespace
+{
+    /// Generates random blocks with the same limits as GameLevel, without repairing them.
+    std::vector<RectangleF> generateBlocks(float levelWidth, float levelHeight)
+    {
+        std::mt19937 rng(1337);
+        std::uniform_real_distribution<float> width(60.0f, 250.0f);
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+        std::uniform_real_distribution<float> spacing(100.0f, 400.0f);
+
+        std::vector<RectangleF> blocks;
+        for (float x = 0.0f; x < levelWidth; x += spacing(rng))
+        {
+            const float w = width(rng);
+            const float h = 30.0f + unit(rng) * (400.0f - 0.5f * w - 30.0f);
+            blocks.push_back({ x, levelHeight - h, w, h });
+            x += w;
+        }
+        return blocks;
+    }
+
+    double validate(const LevelValidator& validator, const std::vector<RectangleF>& blocks, size_t& unreachable)
+    {
+        Timer timer(false);
+        unreachable = validator.FindUnreachable(blocks).size();
+        return static_cast<double>(timer.Elapsed<std::chrono::microseconds>()) / 1000.0;
+    }
+} // end anonymous namespace
+
+int main(int argc, char* argv[])
+{
+    const float levelWidth  = argc > 1 ? std::strtof(argv[1], nullptr) : 1.0e7f;
+    const float levelHeight = static_cast<float>(Constants::RENDER_SIZE.H);
+
+    const std::vector<RectangleF> blocks = generateBlocks(levelWidth, levelHeight);
+
+    Timer timer(false);
+    const Physics      physics(100.0f, 0.9f);
+    const JumpEnvelope envelope(
+        physics, 75.0f, 30.0f,
+        1.0 / static_cast<double>(Constants::TARGET_UPS), Constants::TARGET_UPS / Constants::TARGET_FPS,
+        levelHeight
+    );
+    const double envelopeMs = static_cast<double>(timer.Elapsed<std::chrono::microseconds>()) / 1000.0;
+
+    const LevelValidator singleThreaded(envelope, 1);
+    const LevelValidator multiThreaded(envelope);
+
+    size_t unreachableSingle = 0, unreachableMulti = 0;
+    const double singleMs = validate(singleThreaded, blocks, unreachableSingle);
+    const double multiMs  = validate(multiThreaded,  blocks, unreachableMulti);
+
+    fmt::print("Level width {:.0f}px, {} blocks, {} unreachable\n", levelWidth, blocks.size(), unreachableSingle);
+    fmt::print("{:>24} {:>10.3f} ms\n", "Jump envelope sampling", envelopeMs);
+    fmt::print("{:>24} {:>10.3f} ms\n", "Validation, 1 thread", singleMs);
+    fmt::print("{:>24} {:>10.3f} ms\n", fmt::format("Validation, {} threads", multiThreaded.GetThreadsCount()), multiMs);
+
+    return unreachableSingle == unreachableMulti ? EXIT_SUCCESS : EXIT_FAILURE;
+}
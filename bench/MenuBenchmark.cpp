@@ -0,0 +1,126 @@
+// Measures the latency of entering the pause menu, from entering it to presenting its first frame.
+// Building the menu on every entry, as Game::handlePaused did before the menus were kept in Game,
+// is compared against reactivating a menu that was built once. Needs the real SDL2, SDL_ttf and
+// SDL_image, and the resources of the game, run it from the directory the game is run from.
+// Usage: ./MenuBenchmark [entries]
+
+#include "Constants.hpp"
+#include "Font.hpp"
+#include "Image.hpp"
+#include "Input.hpp"
+#include "Logger.hpp"
+#include "Menu.hpp"
+#include "Renderer.hpp"
+#include "ResourceManager.hpp"
+#include "Sdl2.hpp"
+#include "Timetools.hpp"
+#include "Window.hpp"
+
+#include <SDL.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+
+namespace
+{
+    struct Measurement
+    {
+        double AvgUs;
+        double MaxUs;
+    };
+
+    std::unique_ptr<Menu> createPauseMenu(ResourceManager& resMgr)
+    {
+        auto menu = std::make_unique<Menu>(
+            resMgr.GetFont(Constants::Fonts::TTF::RUBIKBUBBLES, 128), Color::WithAlpha(Constants::Colors::RED, 180),
+            resMgr.GetFont(Constants::Fonts::TTF::RUBIKBUBBLES, 64),  Color::WithAlpha(Constants::Colors::RED, 150),
+            resMgr.GetImage(Constants::Images::PIXNIO_RED),
+            "Game Paused !"
+        );
+        menu->AddLabel("Continue",  [](){});
+        menu->AddLabel("Restart",   [](){});
+        menu->AddLabel("Quit game", [](){});
+        return menu;
+    }
+
+    Measurement summarize(const std::vector<int64_t>& latencies)
+    {
+        int64_t sum = 0;
+        for (int64_t us : latencies) {
+            sum += us;
+        }
+        return {
+            static_cast<double>(sum) / static_cast<double>(latencies.size()),
+            static_cast<double>(*std::max_element(latencies.begin(), latencies.end()))
+        };
+    }
+
+    /// Builds, rasterizes and uploads the menu on every entry.
+    Measurement measureRebuilt(const Renderer& renderer, ResourceManager& resMgr, Input& input, int entries)
+    {
+        std::vector<int64_t> latencies;
+        for (int i = 0; i < entries; ++i)
+        {
+            Timer entryTimer(false);
+            std::unique_ptr<Menu> menu = createPauseMenu(resMgr);
+            menu->ActivateCallbacks(input);
+            menu->UpdateTextures(renderer);
+            menu->Render(renderer);
+            renderer.RenderPresent(true);
+            latencies.push_back(entryTimer.Elapsed<std::chrono::microseconds>());
+        }
+        return summarize(latencies);
+    }
+
+    /// Reactivates the menu that was built once, as Game::handlePaused does.
+    Measurement measureKept(const Renderer& renderer, ResourceManager& resMgr, Input& input, int entries)
+    {
+        std::unique_ptr<Menu> menu = createPauseMenu(resMgr);
+        menu->UpdateTextures(renderer);
+
+        std::vector<int64_t> latencies;
+        for (int i = 0; i < entries; ++i)
+        {
+            Timer entryTimer(false);
+            menu->ResetSelection();
+            menu->ActivateCallbacks(input);
+            menu->UpdateTextures(renderer);
+            menu->Render(renderer);
+            renderer.RenderPresent(true);
+            latencies.push_back(entryTimer.Elapsed<std::chrono::microseconds>());
+        }
+        return summarize(latencies);
+    }
+} // end anonymous namespace
+
+int main(int argc, char* argv[])
+{
+    const int entries = argc > 1 ? std::max(1, std::atoi(argv[1])) : 50;
+
+    if (!Sdl2::Initialize()) {
+        return EXIT_FAILURE;
+    }
+
+    {
+        Window          window("MenuBenchmark", Constants::RENDER_SIZE);
+        Renderer        renderer(window, false);
+        ResourceManager resMgr;
+        Input           input;
+
+        // The fonts and the image are loaded once by the game too, they are not part of the entry
+        createPauseMenu(resMgr);
+
+        fmt::print("{} entries per measurement\n", entries);
+        fmt::print("{:>10} {:>12} {:>12}\n", "Menu", "Avg us", "Max us");
+
+        const Measurement rebuilt = measureRebuilt(renderer, resMgr, input, entries);
+        fmt::print("{:>10} {:>12.0f} {:>12.0f}\n", "Rebuilt", rebuilt.AvgUs, rebuilt.MaxUs);
+        const Measurement kept = measureKept(renderer, resMgr, input, entries);
+        fmt::print("{:>10} {:>12.0f} {:>12.0f}\n", "Kept", kept.AvgUs, kept.MaxUs);
+    }
+
+    return EXIT_SUCCESS;
+}
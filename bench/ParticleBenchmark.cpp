@@ -0,0 +1,96 @@
+// Measures the frametime of a particle emitter as the amount of live particles grows. Every frame the
+// emitter is refilled to its capacity and updated TARGET_UPS / TARGET_FPS times, then drawn with one
+// RenderGeometry call. The update and the draw are compared against the frame budget of 1 / TARGET_FPS
+// seconds, 100k particles should fit in it on one core.
+// Usage: ./ParticleBenchmark [frames]
+
+#include "Camera.hpp"
+#include "Constants.hpp"
+#include "Logger.hpp"
+#include "ParticleEmitter.hpp"
+#include "Renderer.hpp"
+#include "Timetools.hpp"
+#include "Window.hpp"
+
+#include <SDL.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+
+
+namespace
+{
+    struct Measurement
+    {
+        double UpdateMs;
+        double DrawMs;
+    };
+
+    Measurement measure(const Renderer& renderer, const Camera& camera, size_t capacity, int frames)
+    {
+        const ParticleEmitter::Properties properties = {
+            Constants::Colors::LIGHTEST, Color::WithAlpha(Constants::Colors::LIGHT, 0),
+            40.0f, 400.0f, 0.0f, 360.0f, 1.0f, 2.0f, 200.0f, 0.5f, 2.0f
+        };
+        ParticleEmitter emitter(capacity, properties, 1);
+        const Point2DF center  = { 0.5f * Constants::RENDER_SIZE.W, 0.5f * Constants::RENDER_SIZE.H };
+        const Timestep dt(1.0 / static_cast<double>(Constants::TARGET_UPS));
+        const size_t   updatesPerFrame = Constants::TARGET_UPS / Constants::TARGET_FPS;
+
+        int64_t updateUs = 0, drawUs = 0;
+        Timer timer(false);
+        for (int i = 0; i < frames; ++i)
+        {
+            timer.Reset();
+            emitter.Emit(center, capacity - emitter.GetCount());
+            for (size_t u = 0; u < updatesPerFrame; ++u) {
+                emitter.Update(dt);
+            }
+            updateUs += timer.Elapsed<std::chrono::microseconds>();
+
+            timer.Reset();
+            emitter.Draw(renderer, camera);
+            renderer.RenderPresent();
+            drawUs += timer.Elapsed<std::chrono::microseconds>();
+        }
+
+        return {
+            static_cast<double>(updateUs) / frames / 1000.0,
+            static_cast<double>(drawUs) / frames / 1000.0
+        };
+    }
+} // end anonymous namespace
+
+int main(int argc, char* argv[])
+{
+    const int    frames   = argc > 1 ? std::max(1, std::atoi(argv[1])) : 600;
+    const double budgetMs = 1000.0 / static_cast<double>(Constants::TARGET_FPS);
+
+    if (SDL_Init(SDL_INIT_VIDEO) != 0) {
+        Logger::Critical("Unable to initialize SDL: {}", SDL_GetError());
+        return EXIT_FAILURE;
+    }
+
+    {
+        Window   window("ParticleBenchmark", Constants::RENDER_SIZE);
+        Renderer renderer(window, false);
+        Camera   camera;
+        camera.SetDimensions(Constants::RENDER_SIZE);
+        camera.SetCenterPosition(glm::vec3(0.5f * Constants::RENDER_SIZE.W, 0.5f * Constants::RENDER_SIZE.H, 0.0f));
+
+        fmt::print("{} frames per measurement, frame budget {:.1f}ms\n", frames, budgetMs);
+        fmt::print("{:>10} {:>10} {:>10} {:>10} {:>8}\n", "Particles", "Update ms", "Draw ms", "ns/part", "Budget");
+
+        for (size_t capacity : { size_t(1000), size_t(10000), size_t(100000) })
+        {
+            const Measurement m = measure(renderer, camera, capacity, frames);
+            fmt::print("{:>10} {:>10.3f} {:>10.3f} {:>10.1f} {:>7.1f}%\n",
+                capacity, m.UpdateMs, m.DrawMs,
+                1.0e6 * (m.UpdateMs + m.DrawMs) / static_cast<double>(capacity),
+                100.0 * (m.UpdateMs + m.DrawMs) / budgetMs);
+        }
+    }
+
+    SDL_Quit();
+    return EXIT_SUCCESS;
+}
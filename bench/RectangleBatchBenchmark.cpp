@@ -0,0 +1,106 @@
+// Measures the frametime and the draw calls per frame of drawing filled rectangles of random colors,
+// as the amount of rectangles grows. Setting the draw color and filling every rectangle separately,
+// with Renderer::FillRectangle, is compared against filling them through a RenderQueue, which merges them into
+// one RenderGeometry call.
+// Usage: ./RectangleBatchBenchmark [frames]
+
+#include "Color.hpp"
+#include "Constants.hpp"
+#include "Geometry.hpp"
+#include "Helpers.hpp"
+#include "Logger.hpp"
+#include "RenderQueue.hpp"
+#include "Renderer.hpp"
+#include "Timetools.hpp"
+#include "Window.hpp"
+
+#include <SDL.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+
+namespace
+{
+    struct Measurement
+    {
+        double SeparateMs;
+        double BatchedMs;
+        size_t SeparateCalls; // Per frame
+        size_t BatchedCalls;
+    };
+
+    Measurement measure(const Renderer& renderer, size_t count, int frames)
+    {
+        Helpers::random::Generator random(1);
+        const float maxX = static_cast<float>(Constants::RENDER_SIZE.W - 64);
+        const float maxY = static_cast<float>(Constants::RENDER_SIZE.H - 64);
+        std::vector<Rectangle> rects;
+        std::vector<Color>     colors;
+        for (size_t i = 0; i < count; ++i)
+        {
+            rects.push_back({
+                static_cast<int>(random.FloatInRange(0.0f, maxX)), static_cast<int>(random.FloatInRange(0.0f, maxY)),
+                static_cast<int>(random.FloatInRange(8.0f, 64.0f)), static_cast<int>(random.FloatInRange(8.0f, 64.0f))
+            });
+            colors.push_back(Color::Tinted(Constants::Colors::LIGHTEST, static_cast<double>(random.FloatInRange(0.2f, 1.0f))));
+        }
+
+        Measurement m = {};
+        RenderQueue queue;
+        Timer timer(false);
+        for (int i = 0; i < frames; ++i)
+        {
+            for (size_t r = 0; r < count; ++r)
+            {
+                renderer.SetRenderDrawColor(colors[r]);
+                renderer.FillRectangle(rects[r]);
+            }
+            renderer.RenderPresent();
+        }
+        m.SeparateMs    = static_cast<double>(timer.Elapsed<std::chrono::microseconds>(true)) / frames / 1000.0;
+        m.SeparateCalls = renderer.GetFrameDrawCalls();
+
+        for (int i = 0; i < frames; ++i)
+        {
+            for (size_t r = 0; r < count; ++r) {
+                queue.FillRectangle(RenderQueue::Layer::TERRAIN, rects[r], colors[r]);
+            }
+            queue.Flush(renderer);
+            renderer.RenderPresent();
+        }
+        m.BatchedMs    = static_cast<double>(timer.Elapsed<std::chrono::microseconds>()) / frames / 1000.0;
+        m.BatchedCalls = renderer.GetFrameDrawCalls();
+
+        return m;
+    }
+} // end anonymous namespace
+
+int main(int argc, char* argv[])
+{
+    const int frames = argc > 1 ? std::max(1, std::atoi(argv[1])) : 300;
+
+    if (SDL_Init(SDL_INIT_VIDEO) != 0) {
+        Logger::Critical("Unable to initialize SDL: {}", SDL_GetError());
+        return EXIT_FAILURE;
+    }
+
+    {
+        Window   window("RectangleBatchBenchmark", Constants::RENDER_SIZE);
+        Renderer renderer(window, false);
+
+        fmt::print("{} frames per measurement\n", frames);
+        fmt::print("{:>10} {:>12} {:>14} {:>12} {:>14}\n", "Rects", "Separate ms", "Separate calls", "Batched ms", "Batched calls");
+
+        for (size_t count : { size_t(100), size_t(1000), size_t(10000) })
+        {
+            const Measurement m = measure(renderer, count, frames);
+            fmt::print("{:>10} {:>12.3f} {:>14} {:>12.3f} {:>14}\n",
+                count, m.SeparateMs, m.SeparateCalls, m.BatchedMs, m.BatchedCalls);
+        }
+    }
+
+    SDL_Quit();
+    return EXIT_SUCCESS;
+}
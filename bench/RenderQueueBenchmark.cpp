@@ -0,0 +1,125 @@
+// Measures a frame of objects that each fill a rectangle in their own color and outline it, like
+// the level objects when DRAW_COLLIDERS is defined, and a few filled circles. Issuing the calls
+// in scene order, setting the draw color before every call, is compared against submitting the
+// same commands to a RenderQueue, which sorts them by state and merges the filled rectangles.
+// Usage: ./RenderQueueBenchmark [frames]
+
+#include "Color.hpp"
+#include "Constants.hpp"
+#include "Geometry.hpp"
+#include "Helpers.hpp"
+#include "Logger.hpp"
+#include "RenderQueue.hpp"
+#include "Renderer.hpp"
+#include "Timetools.hpp"
+#include "Window.hpp"
+
+#include <SDL.h>
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+
+namespace
+{
+    constexpr size_t CIRCLES = 8;
+
+    struct Measurement
+    {
+        double ImmediateMs;
+        double QueuedMs;
+        size_t ImmediateStateChanges; // Per frame
+        size_t QueuedStateChanges;
+        size_t ImmediateCalls;
+        size_t QueuedCalls;
+    };
+
+    Measurement measure(const Renderer& renderer, RenderQueue& queue, size_t count, int frames)
+    {
+        Helpers::random::Generator random(1);
+        const float maxX = static_cast<float>(Constants::RENDER_SIZE.W - 64);
+        const float maxY = static_cast<float>(Constants::RENDER_SIZE.H - 64);
+        const Color outline = { Constants::Colors::WHITE };
+        std::vector<Rectangle> rects;
+        std::vector<Color>     colors;
+        for (size_t i = 0; i < count; ++i)
+        {
+            rects.push_back({
+                static_cast<int>(random.FloatInRange(0.0f, maxX)), static_cast<int>(random.FloatInRange(0.0f, maxY)),
+                static_cast<int>(random.FloatInRange(8.0f, 64.0f)), static_cast<int>(random.FloatInRange(8.0f, 64.0f))
+            });
+            colors.push_back(Color::Tinted(Constants::Colors::LIGHTEST, static_cast<double>(random.FloatInRange(0.2f, 1.0f))));
+        }
+
+        Measurement m = {};
+        Timer timer(false);
+        for (int i = 0; i < frames; ++i)
+        {
+            for (size_t r = 0; r < count; ++r)
+            {
+                renderer.SetRenderDrawColor(colors[r]);
+                renderer.FillRectangle(rects[r]);
+                renderer.SetRenderDrawColor(outline);
+                renderer.DrawRectangle(rects[r]);
+            }
+            for (size_t c = 0; c < CIRCLES; ++c)
+            {
+                renderer.SetRenderDrawColor(colors[c % count]);
+                renderer.DrawCircleFilled({ rects[c % count].X, rects[c % count].Y }, 15);
+            }
+            renderer.RenderPresent();
+        }
+        m.ImmediateMs           = static_cast<double>(timer.Elapsed<std::chrono::microseconds>(true)) / frames / 1000.0;
+        m.ImmediateStateChanges = 2 * count + CIRCLES;
+        m.ImmediateCalls        = renderer.GetFrameDrawCalls();
+
+        for (int i = 0; i < frames; ++i)
+        {
+            for (size_t r = 0; r < count; ++r)
+            {
+                queue.FillRectangle(RenderQueue::Layer::TERRAIN, rects[r], colors[r]);
+                queue.DrawRectangle(RenderQueue::Layer::DEBUG, rects[r], outline);
+            }
+            for (size_t c = 0; c < CIRCLES; ++c) {
+                queue.FillCircle(RenderQueue::Layer::PLAYER, { rects[c % count].X, rects[c % count].Y }, 15, colors[c % count]);
+            }
+            queue.Flush(renderer);
+            renderer.RenderPresent();
+        }
+        m.QueuedMs           = static_cast<double>(timer.Elapsed<std::chrono::microseconds>()) / frames / 1000.0;
+        m.QueuedStateChanges = queue.GetFrameStats().StateChanges;
+        m.QueuedCalls        = renderer.GetFrameDrawCalls();
+
+        return m;
+    }
+} // end anonymous namespace
+
+int main(int argc, char* argv[])
+{
+    const int frames = argc > 1 ? std::max(1, std::atoi(argv[1])) : 300;
+
+    if (SDL_Init(SDL_INIT_VIDEO) != 0) {
+        Logger::Critical("Unable to initialize SDL: {}", SDL_GetError());
+        return EXIT_FAILURE;
+    }
+
+    {
+        Window      window("RenderQueueBenchmark", Constants::RENDER_SIZE);
+        Renderer    renderer(window, false);
+        RenderQueue queue;
+
+        fmt::print("{} frames per measurement, {} circles per frame\n", frames, CIRCLES);
+        fmt::print("{:>8} {:>13} {:>16} {:>15} {:>10} {:>13} {:>12}\n", "Objects",
+            "Immediate ms", "Immediate states", "Immediate calls", "Queued ms", "Queued states", "Queued calls");
+
+        for (size_t count : { size_t(100), size_t(1000), size_t(10000) })
+        {
+            const Measurement m = measure(renderer, queue, count, frames);
+            fmt::print("{:>8} {:>13.3f} {:>16} {:>15} {:>10.3f} {:>13} {:>12}\n", count,
+                m.ImmediateMs, m.ImmediateStateChanges, m.ImmediateCalls, m.QueuedMs, m.QueuedStateChanges, m.QueuedCalls);
+        }
+    }
+
+    SDL_Quit();
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,167 @@
+// Measures the frametime and its deviation, and the latency from polling the input to the end of
+// the present of the frame showing it, for a game loop that simulates for updateMs and draws a frame
+// of filled rectangles with vsync. Flushing and presenting on the loop thread is compared against
+// handing the recorded frames to a RenderThread. The present only blocks with a real vsynced display.
+// Usage: ./RenderThreadBenchmark [frames] [updateMs]
+
+#include "Color.hpp"
+#include "Constants.hpp"
+#include "Geometry.hpp"
+#include "Helpers.hpp"
+#include "Logger.hpp"
+#include "RenderQueue.hpp"
+#include "RenderThread.hpp"
+#include "Renderer.hpp"
+#include "Timetools.hpp"
+#include "Window.hpp"
+
+#include <SDL.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+
+namespace
+{
+    using Clock = RenderThread::Clock;
+
+    constexpr size_t RECTANGLES = 2000;
+
+    struct Deviation
+    {
+        double MeanMs;
+        double StddevMs;
+    };
+
+    Deviation deviation(const std::vector<double>& samplesMs)
+    {
+        double mean = 0.0;
+        for (double sample : samplesMs) {
+            mean += sample;
+        }
+        mean /= static_cast<double>(std::max<size_t>(samplesMs.size(), 1));
+
+        double variance = 0.0;
+        for (double sample : samplesMs) {
+            variance += (sample - mean) * (sample - mean);
+        }
+        variance /= static_cast<double>(std::max<size_t>(samplesMs.size(), 1));
+        return { mean, std::sqrt(variance) };
+    }
+
+    double toMs(Clock::duration duration)
+    {
+        return std::chrono::duration<double, std::milli>(duration).count();
+    }
+
+    /// Busy waits like a simulation step taking updateMs.
+    void simulate(double updateMs)
+    {
+        const Clock::time_point end = Clock::now() + std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<double, std::milli>(updateMs));
+        while (Clock::now() < end) { }
+    }
+
+    void record(RenderQueue& queue, const std::vector<Rectangle>& rects, const std::vector<Color>& colors)
+    {
+        for (size_t i = 0; i < rects.size(); ++i) {
+            queue.FillRectangle(RenderQueue::Layer::TERRAIN, rects[i], colors[i]);
+        }
+    }
+
+    struct Measurement
+    {
+        Deviation Frametime;
+        Deviation Latency;
+    };
+
+    Measurement measure(const Renderer& renderer, bool useThread, int frames, double updateMs)
+    {
+        Helpers::random::Generator random(1);
+        std::vector<Rectangle> rects;
+        std::vector<Color>     colors;
+        for (size_t i = 0; i < RECTANGLES; ++i)
+        {
+            rects.push_back({
+                static_cast<int>(random.FloatInRange(0.0f, static_cast<float>(Constants::RENDER_SIZE.W - 64))),
+                static_cast<int>(random.FloatInRange(0.0f, static_cast<float>(Constants::RENDER_SIZE.H - 64))),
+                static_cast<int>(random.FloatInRange(8.0f, 64.0f)), static_cast<int>(random.FloatInRange(8.0f, 64.0f))
+            });
+            colors.push_back(Color::Tinted(Constants::Colors::LIGHTEST, static_cast<double>(random.FloatInRange(0.2f, 1.0f))));
+        }
+
+        std::vector<double> frametimes, latencies;
+        RenderQueue         queue;
+        std::unique_ptr<RenderThread> thread = useThread ? std::make_unique<RenderThread>(renderer, Constants::Colors::BLACK) : nullptr;
+
+        Clock::time_point previous = Clock::now();
+        for (int i = 0; i < frames; ++i)
+        {
+            const Clock::time_point inputTime = Clock::now();
+            frametimes.push_back(toMs(inputTime - previous));
+            previous = inputTime;
+
+            simulate(updateMs);
+
+            if (thread != nullptr)
+            {
+                record(thread->GetRecordQueue(), rects, colors);
+                thread->Submit(inputTime);
+                if (i > 0) { // The stats are of the previous frame, which Submit waited for
+                    latencies.push_back(static_cast<double>(thread->GetFrameStats().LatencyUs) / 1000.0);
+                }
+            }
+            else
+            {
+                record(queue, rects, colors);
+                queue.Flush(renderer);
+                renderer.SetRenderDrawColor(Constants::Colors::BLACK);
+                renderer.RenderPresent(true);
+                latencies.push_back(toMs(Clock::now() - inputTime));
+            }
+        }
+        thread.reset();
+
+        frametimes.erase(frametimes.begin()); // Not a whole frame
+        return { deviation(frametimes), deviation(latencies) };
+    }
+} // end anonymous namespace
+
+int main(int argc, char* argv[])
+{
+    const int    frames   = argc > 1 ? std::max(2, std::atoi(argv[1])) : 600;
+    const double updateMs = argc > 2 ? std::max(0.0, std::atof(argv[2])) : 8.0;
+
+    if (SDL_Init(SDL_INIT_VIDEO) != 0) {
+        Logger::Critical("Unable to initialize SDL: {}", SDL_GetError());
+        return EXIT_FAILURE;
+    }
+
+    {
+        Window   window("RenderThreadBenchmark", Constants::RENDER_SIZE);
+        Renderer renderer(window, true);
+
+        fmt::print("{} frames of {} rectangles per measurement, {:.1f} ms of simulation per frame, vsync {}\n",
+            frames, RECTANGLES, updateMs, renderer.GetIsVsyncced() ? "on" : "off");
+        fmt::print("{:>14} {:>14} {:>17} {:>12} {:>15}\n", "", "Frametime ms", "Frametime stddev", "Latency ms", "Latency stddev");
+
+        for (bool useThread : { false, true })
+        {
+            if (useThread && !renderer.IsOpenGL())
+            {
+                fmt::print("{:>14} skipped, the \"{}\" renderer cannot present from another thread\n",
+                           "Render thread", renderer.GetName());
+                continue;
+            }
+            const Measurement m = measure(renderer, useThread, frames, updateMs);
+            fmt::print("{:>14} {:>14.3f} {:>17.3f} {:>12.3f} {:>15.3f}\n", useThread ? "Render thread" : "Loop thread",
+                m.Frametime.MeanMs, m.Frametime.StddevMs, m.Latency.MeanMs, m.Latency.StddevMs);
+        }
+    }
+
+    SDL_Quit();
+    return EXIT_SUCCESS;
+}
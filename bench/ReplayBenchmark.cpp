@@ -0,0 +1,153 @@
+// Records a long headless session into a replay file, then measures the size of the file, how long
+// opening it takes and how long seeking to random points of it takes, for both level modes.
+// Usage: ./ReplayBenchmark [minutes] [seeks]
+
+#include "Constants.hpp"
+#include "GameLevel.hpp"
+#include "GameObject.hpp"
+#include "Input.hpp"
+#include "Logger.hpp"
+#include "Replay.hpp"
+#include "Timetools.hpp"
+
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <string>
+
+
+namespace
+{
+    const std::string REPLAY_FILEPATH = "ReplayBenchmark.bin";
+
+    struct Measurement
+    {
+        size_t Bytes;
+        size_t Keyframes;
+        double RecordMs;
+        double OpenUs;
+        double SeekAvgMs;
+        double SeekMaxMs;
+    };
+
+    struct HeadlessLevel
+    {
+        HeadlessLevel(GameLevel::Mode mode)
+            : input()
+            , player(GameObject::CreatePlayer(
+                input, 0.0f, 0.0f, Constants::Player::MOVE_FORCE, Constants::Player::RADIUS, nullptr, Constants::Colors::LIGHT
+            ))
+            , level(GameLevel::CreateHeadlessLevel(
+                input, mode, Constants::Level::SEED, Constants::Level::ARENA_SIZE,
+                Constants::Level::GRAVITY, Constants::Level::FRICTION, Constants::Level::INITIAL_TIME,
+                player.get()
+            ))
+        {
+            //
+        }
+
+        Input                         input;
+        std::unique_ptr<PlayerObject> player;
+        std::unique_ptr<GameLevel>    level;
+    };
+
+    /// Plays like a human would, holding the keys for a while, at a frame rate that occasionally
+    /// stutters. Every frame is followed by 2 updates, except for every 50th which is followed by 3.
+    void record(GameLevel::Mode mode, size_t minutes)
+    {
+        HeadlessLevel headless(mode);
+        ReplayRecorder recorder(*headless.level, REPLAY_FILEPATH);
+        const Timestep dt(1.0 / static_cast<double>(Constants::TARGET_UPS));
+        const size_t   updates = minutes * 60 * Constants::TARGET_UPS;
+
+        for (size_t i = 0; recorder.GetUpdatesCount() < updates; ++i)
+        {
+            headless.input.SetKeyPressed(Input::KeyCode::RIGHT, i % 300 < 240);
+            headless.input.SetKeyPressed(Input::KeyCode::LEFT,  i % 300 >= 270);
+            headless.input.SetKeyPressed(Input::KeyCode::UP,    i % 90 < 20);
+            headless.input.SetKeyPressed(Input::KeyCode::SPACE, i % 120 < 10);
+
+            headless.level->HandleInput();
+            recorder.RecordInput(headless.input);
+            for (size_t u = 0; u < (i % 50 == 0 ? 3 : 2); ++u)
+            {
+                headless.level->Update(dt);
+                headless.level->HandleCollisions();
+                recorder.RecordUpdate();
+            }
+        }
+
+        if (!recorder.Finish()) {
+            std::exit(EXIT_FAILURE);
+        }
+    }
+
+    Measurement measure(GameLevel::Mode mode, size_t minutes, size_t seeks)
+    {
+        Measurement m = {};
+        Timer timer(false);
+        record(mode, minutes);
+        m.RecordMs = static_cast<double>(timer.Elapsed<std::chrono::microseconds>()) / 1000.0;
+
+        timer.Reset();
+        std::unique_ptr<Replay> replay = Replay::Open(REPLAY_FILEPATH);
+        m.OpenUs = static_cast<double>(timer.Elapsed<std::chrono::nanoseconds>()) / 1000.0;
+        if (replay == nullptr) {
+            std::exit(EXIT_FAILURE);
+        }
+        m.Bytes     = replay->GetFileSize();
+        m.Keyframes = replay->GetKeyframesCount();
+
+        HeadlessLevel headless(mode);
+        ReplayPlayer  replayPlayer(*replay, *headless.level, headless.input);
+        const Timestep dt(1.0 / static_cast<double>(Constants::TARGET_UPS));
+        std::mt19937_64 random(1);
+        std::uniform_int_distribution<size_t> update(0, replay->GetUpdatesCount());
+
+        int64_t totalNs = 0, maxNs = 0;
+        for (size_t i = 0; i < seeks; ++i)
+        {
+            const size_t target = update(random);
+            timer.Reset();
+            if (!replayPlayer.Seek(target, dt)) {
+                std::exit(EXIT_FAILURE);
+            }
+            const int64_t ns = timer.Elapsed<std::chrono::nanoseconds>();
+            totalNs += ns;
+            maxNs    = std::max(maxNs, ns);
+        }
+        m.SeekAvgMs = static_cast<double>(totalNs) / 1.0e6 / static_cast<double>(seeks);
+        m.SeekMaxMs = static_cast<double>(maxNs) / 1.0e6;
+
+        std::remove(REPLAY_FILEPATH.c_str());
+        return m;
+    }
+
+    void print(const char* mode, size_t minutes, const Measurement& m)
+    {
+        fmt::print("{:>8} {:>10} {:>10.1f} {:>10} {:>10.1f} {:>10.1f} {:>10.2f} {:>10.2f}\n",
+            mode, m.Bytes, static_cast<double>(m.Bytes) / 1024.0 / static_cast<double>(minutes),
+            m.Keyframes, m.RecordMs, m.OpenUs, m.SeekAvgMs, m.SeekMaxMs);
+    }
+} // end anonymous namespace
+
+int main(int argc, char* argv[])
+{
+    const size_t minutes = argc > 1 ? std::max<size_t>(std::strtoul(argv[1], nullptr, 10), 1) : 60;
+    const size_t seeks   = argc > 2 ? std::max<size_t>(std::strtoul(argv[2], nullptr, 10), 1) : 100;
+    Logger::SetLogLevel(Logger::Level::CRITICAL);
+
+    fmt::print("{} minutes of play, {} random seeks, a keyframe every {}s\n", minutes, seeks, Replay::KEYFRAME_SECONDS);
+    fmt::print("{:>8} {:>10} {:>10} {:>10} {:>10} {:>10} {:>10} {:>10}\n",
+        "Mode", "Bytes", "KiB/min", "Keyframes", "Record ms", "Open us", "Seek ms", "Max ms");
+
+    print("FIXED",   minutes, measure(GameLevel::Mode::FIXED,   minutes, seeks));
+    print("ENDLESS", minutes, measure(GameLevel::Mode::ENDLESS, minutes, seeks));
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,114 @@
+// Measures the cost of rolling back and resimulating a headless level whose inputs arrive late from
+// a stand-in peer, for a range of network delays. The inputs change often, so that most of them are
+// mispredicted. The worst frame (TARGET_UPS / TARGET_FPS ticks, including the rollbacks) is compared
+// against the frame budget. The worst frame also includes any preemption by the OS, the worst rollback
+// alone is the cost of the resimulation.
+// Usage: ./RollbackBenchmark [frames]
+
+#include "Constants.hpp"
+#include "GameLevel.hpp"
+#include "GameObject.hpp"
+#include "Input.hpp"
+#include "Logger.hpp"
+#include "Rollback.hpp"
+#include "Timetools.hpp"
+
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+
+
+namespace
+{
+    struct Measurement
+    {
+        size_t Rollbacks;
+        double ResimulatedPerFrame; // Average
+        size_t MaxResimulated;
+        double MaxRollbackMs;
+        double AvgFrameMs;
+        double MaxFrameMs;
+    };
+
+    /// Changes the held keys every 8 ticks.
+    uint8_t getKeys(size_t tick)
+    {
+        constexpr std::array<uint8_t, 4> keys = { 0b01000, 0b01001, 0b10000, 0b11000 }; // RIGHT, RIGHT+UP, SPACE, RIGHT+SPACE
+        return keys[(tick / 8) % keys.size()];
+    }
+
+    Measurement measure(GameLevel::Mode mode, size_t delay, size_t jitter, size_t frames)
+    {
+        Input input;
+        std::unique_ptr<PlayerObject> player = GameObject::CreatePlayer(
+            input, 0.0f, 0.0f, Constants::Player::MOVE_FORCE, Constants::Player::RADIUS, nullptr, Constants::Colors::LIGHT
+        );
+        std::unique_ptr<GameLevel> level = GameLevel::CreateHeadlessLevel(
+            input, mode, Constants::Level::SEED, Constants::Level::ARENA_SIZE,
+            Constants::Level::GRAVITY, Constants::Level::FRICTION, Constants::Level::INITIAL_TIME,
+            player.get()
+        );
+
+        const Timestep  dt(1.0 / static_cast<double>(Constants::TARGET_UPS));
+        const size_t    ticksPerFrame = Constants::TARGET_UPS / Constants::TARGET_FPS;
+        RollbackSession session(*level, input);
+        LocalPeer       peer(delay, jitter, 1);
+
+        int64_t totalNs = 0, maxNs = 0;
+        Timer timer(false);
+        for (size_t frame = 0; frame < frames; ++frame)
+        {
+            timer.Reset();
+            for (size_t i = 0; i < ticksPerFrame; ++i)
+            {
+                const size_t tick = session.GetTick();
+                peer.Send(tick, getKeys(tick));
+                peer.Deliver(tick, session);
+                session.AdvanceTick(dt);
+            }
+            const int64_t ns = timer.Elapsed<std::chrono::nanoseconds>();
+            totalNs += ns;
+            maxNs    = std::max(maxNs, ns);
+        }
+
+        const RollbackSession::Stats& stats = session.GetStats();
+        return {
+            stats.Rollbacks,
+            static_cast<double>(stats.ResimulatedTicks) / static_cast<double>(frames),
+            stats.MaxResimulatedTicks,
+            static_cast<double>(stats.MaxRollbackNs) / 1.0e6,
+            static_cast<double>(totalNs) / 1.0e6 / static_cast<double>(frames),
+            static_cast<double>(maxNs) / 1.0e6
+        };
+    }
+} // end anonymous namespace
+
+int main(int argc, char* argv[])
+{
+    const size_t frames = argc > 1 ? std::max<size_t>(std::strtoul(argv[1], nullptr, 10), 1) : 3600;
+    const double budgetMs = 1000.0 / static_cast<double>(Constants::TARGET_FPS);
+    Logger::SetLogLevel(Logger::Level::CRITICAL);
+
+    fmt::print("{} frames, at most {} ticks rolled back, frame budget {:.1f}ms\n",
+        frames, RollbackSession::MAX_ROLLBACK_TICKS, budgetMs);
+    fmt::print("{:>8} {:>6} {:>6} {:>10} {:>12} {:>8} {:>12} {:>10} {:>10} {:>8}\n",
+        "Mode", "Delay", "Jitter", "Rollbacks", "Resim/frame", "MaxResim", "Rollback ms", "Avg ms", "Max ms", "Budget");
+
+    constexpr std::array<std::array<size_t, 2>, 4> peers = {{ { 2, 1 }, { 6, 4 }, { 12, 8 }, { 28, 1 } }};
+    for (GameLevel::Mode mode : { GameLevel::Mode::FIXED, GameLevel::Mode::ENDLESS })
+    {
+        for (const std::array<size_t, 2>& peer : peers)
+        {
+            const Measurement m = measure(mode, peer[0], peer[1], frames);
+            fmt::print("{:>8} {:>6} {:>6} {:>10} {:>12.1f} {:>8} {:>12.3f} {:>10.3f} {:>10.3f} {:>7.1f}%\n",
+                mode == GameLevel::Mode::FIXED ? "FIXED" : "ENDLESS", peer[0], peer[1], m.Rollbacks,
+                m.ResimulatedPerFrame, m.MaxResimulated, m.MaxRollbackMs, m.AvgFrameMs, m.MaxFrameMs, 100.0 * m.MaxFrameMs / budgetMs);
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
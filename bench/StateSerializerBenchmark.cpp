@@ -0,0 +1,92 @@
+// Measures the cost of saving and loading the whole simulation state of a headless level on
+// every update, as a quick-save, crash recovery or rollback would, for both level modes.
+// Usage: ./StateSerializerBenchmark [updates]
+
+#include "Constants.hpp"
+#include "GameLevel.hpp"
+#include "GameObject.hpp"
+#include "Input.hpp"
+#include "Logger.hpp"
+#include "Timetools.hpp"
+
+#include <fmt/core.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+
+namespace
+{
+    struct Measurement
+    {
+        size_t Bytes;
+        double SaveUs; // Average per update
+        double LoadUs; // Average per update
+    };
+
+    Measurement measure(GameLevel::Mode mode, size_t updates)
+    {
+        Input input;
+        input.SetKeyPressed(Input::KeyCode::RIGHT, true);
+        input.SetKeyPressed(Input::KeyCode::UP,    true);
+        input.SetKeyPressed(Input::KeyCode::SPACE, true);
+
+        std::unique_ptr<PlayerObject> player = GameObject::CreatePlayer(
+            input, 0.0f, 0.0f, Constants::Player::MOVE_FORCE, Constants::Player::RADIUS, nullptr, Constants::Colors::LIGHT
+        );
+        std::unique_ptr<GameLevel> level = GameLevel::CreateHeadlessLevel(
+            input, mode, Constants::Level::SEED, Constants::Level::ARENA_SIZE,
+            Constants::Level::GRAVITY, Constants::Level::FRICTION, Constants::Level::INITIAL_TIME,
+            player.get()
+        );
+
+        const Timestep dt(1.0 / static_cast<double>(Constants::TARGET_UPS));
+        std::vector<uint8_t> state;
+        int64_t saveNs = 0, loadNs = 0;
+        Timer timer(false);
+
+        for (size_t i = 0; i < updates; ++i)
+        {
+            if (i % (Constants::TARGET_UPS / Constants::TARGET_FPS) == 0) {
+                level->HandleInput();
+            }
+            level->Update(dt);
+            level->HandleCollisions();
+
+            timer.Reset();
+            level->SaveState(state);
+            saveNs += timer.Elapsed<std::chrono::nanoseconds>();
+
+            timer.Reset();
+            if (!level->LoadState(state)) {
+                std::exit(EXIT_FAILURE);
+            }
+            loadNs += timer.Elapsed<std::chrono::nanoseconds>();
+        }
+
+        return {
+            state.size(),
+            static_cast<double>(saveNs) / 1000.0 / static_cast<double>(updates),
+            static_cast<double>(loadNs) / 1000.0 / static_cast<double>(updates)
+        };
+    }
+} // end anonymous namespace
+
+int main(int argc, char* argv[])
+{
+    const size_t updates = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 12000;
+    Logger::SetLogLevel(Logger::Level::CRITICAL);
+
+    fmt::print("{} updates, state version {}\n", updates, GameLevel::STATE_VERSION);
+    fmt::print("{:>8} {:>10} {:>12} {:>12}\n", "Mode", "Bytes", "Save us", "Load us");
+
+    const Measurement fixed   = measure(GameLevel::Mode::FIXED,   updates);
+    fmt::print("{:>8} {:>10} {:>12.2f} {:>12.2f}\n", "FIXED", fixed.Bytes, fixed.SaveUs, fixed.LoadUs);
+
+    const Measurement endless = measure(GameLevel::Mode::ENDLESS, updates);
+    fmt::print("{:>8} {:>10} {:>12.2f} {:>12.2f}\n", "ENDLESS", endless.Bytes, endless.SaveUs, endless.LoadUs);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,113 @@
+// Measures the frametime of drawing one screen of tiles as the tile density grows. The batched
+// TileMap::Draw is compared against drawing every tile with its own filled rectangle, which is
+// how the terrain used to be drawn. The batched frametime should stay (nearly) flat.
+// Usage: ./TileMapBenchmark [frames]
+
+#include "Camera.hpp"
+#include "Constants.hpp"
+#include "Logger.hpp"
+#include "Renderer.hpp"
+#include "TileMap.hpp"
+#include "Tileset.hpp"
+#include "Timetools.hpp"
+#include "Window.hpp"
+
+#include <SDL.h>
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+
+
+namespace
+{
+    constexpr Dimensions2D SCREEN_SIZE = { 1280, 720 };
+    constexpr float        TILE_SIZE   = 10.0f;
+
+    /// Fills the tilemap column by column until density percent of the tiles are solid.
+    void fillTiles(TileMap& map, int densityPercent)
+    {
+        map.Reset({ 0.0f, 0.0f }, map.GetColumns(), map.GetRows(), map.GetTileSize());
+        const int height = map.GetRows() * densityPercent / 100;
+        for (int col = 0; col < map.GetColumns(); ++col) {
+            for (int row = map.GetRows() - height; row < map.GetRows(); ++row) {
+                map.SetTile(col, row, row == map.GetRows() - height ? Tileset::GROUND_TOP : Tileset::GROUND_FILL);
+            }
+        }
+    }
+
+    double frameTimeBatched(const Renderer& renderer, const Camera& camera,
+                            const TileMap& map, const Tileset& tileset, int frames)
+    {
+        Timer timer(false);
+        for (int i = 0; i < frames; ++i)
+        {
+            map.Draw(renderer, camera, tileset);
+            renderer.RenderPresent();
+        }
+        return static_cast<double>(timer.Elapsed<std::chrono::microseconds>()) / frames / 1000.0;
+    }
+
+    double frameTimePerTile(const Renderer& renderer, const TileMap& map, int frames)
+    {
+        const int tileSize = static_cast<int>(map.GetTileSize());
+        Timer timer(false);
+        for (int i = 0; i < frames; ++i)
+        {
+            renderer.SetRenderDrawColor(Constants::Colors::DARK);
+            for (int row = 0; row < map.GetRows(); ++row) {
+                for (int col = 0; col < map.GetColumns(); ++col) {
+                    if (map.GetTile(col, row) != Tileset::EMPTY) {
+                        renderer.FillRectangle({ col * tileSize, row * tileSize, tileSize, tileSize });
+                    }
+                }
+            }
+            renderer.RenderPresent();
+        }
+        return static_cast<double>(timer.Elapsed<std::chrono::microseconds>()) / frames / 1000.0;
+    }
+} // end anonymous namespace
+
+int main(int argc, char* argv[])
+{
+    const int frames = argc > 1 ? std::max(1, std::atoi(argv[1])) : 200;
+
+    if (SDL_Init(SDL_INIT_VIDEO) != 0) {
+        Logger::Critical("Unable to initialize SDL: {}", SDL_GetError());
+        return EXIT_FAILURE;
+    }
+
+    {
+        Window   window("TileMapBenchmark", SCREEN_SIZE);
+        Renderer renderer(window, false);
+        Camera   camera;
+        Tileset  tileset(32);
+        TileMap  map;
+
+        camera.SetDimensions(SCREEN_SIZE);
+        camera.SetCenterPosition(glm::vec3(0.5f * SCREEN_SIZE.W, 0.5f * SCREEN_SIZE.H, 0.0f));
+        tileset.UpdateTexture(renderer);
+        map.Reset(
+            { 0.0f, 0.0f },
+            static_cast<int>(SCREEN_SIZE.W / TILE_SIZE),
+            static_cast<int>(SCREEN_SIZE.H / TILE_SIZE),
+            TILE_SIZE
+        );
+
+        fmt::print("{} frames per measurement, {}x{} tiles\n", frames, map.GetColumns(), map.GetRows());
+        fmt::print("{:>8} {:>8} {:>14} {:>14}\n", "density", "tiles", "batched ms", "per tile ms");
+
+        for (int density : { 0, 10, 25, 50, 75, 100 })
+        {
+            fillTiles(map, density);
+            const int tiles = map.GetColumns() * (map.GetRows() * density / 100);
+            fmt::print("{:>7}% {:>8} {:>14.3f} {:>14.3f}\n",
+                density, tiles,
+                frameTimeBatched(renderer, camera, map, tileset, frames),
+                frameTimePerTile(renderer, map, frames)
+            );
+        }
+    }
+
+    SDL_Quit();
+    return EXIT_SUCCESS;
+}
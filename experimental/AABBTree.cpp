@@ -0,0 +1,556 @@
+#include "AABBTree.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+
+
+namespace
+{
+    using Bounds = AABBTree::Bounds;
+
+    Bounds toBounds(const RectangleF& rect)
+    {
+        return { rect.X, rect.Y, rect.X + rect.W, rect.Y + rect.H };
+    }
+
+    Bounds unite(const Bounds& a, const Bounds& b)
+    {
+        return { std::min(a.MinX, b.MinX), std::min(a.MinY, b.MinY), std::max(a.MaxX, b.MaxX), std::max(a.MaxY, b.MaxY) };
+    }
+
+    float perimeter(const Bounds& bounds)
+    {
+        return 2.0f * ((bounds.MaxX - bounds.MinX) + (bounds.MaxY - bounds.MinY));
+    }
+
+    bool contains(const Bounds& outer, const Bounds& inner)
+    {
+        return outer.MinX <= inner.MinX && inner.MaxX <= outer.MaxX
+            && outer.MinY <= inner.MinY && inner.MaxY <= outer.MaxY;
+    }
+
+    /// Inclusive like RectangleF::Overlaps.
+    bool overlaps(const Bounds& a, const Bounds& b)
+    {
+        return a.MinX <= b.MaxX && b.MinX <= a.MaxX
+            && a.MinY <= b.MaxY && b.MinY <= a.MaxY;
+    }
+
+    /// Grows rect by margin on every side and stretches it by the displacement of its last move,
+    /// so that a collider moving steadily stays inside its fat bounds for a few more moves.
+    Bounds fatten(const RectangleF& rect, float margin, Point2DF displacement)
+    {
+        const Bounds bounds = toBounds(rect);
+        return {
+            bounds.MinX - margin + std::min(displacement.X, 0.0f),
+            bounds.MinY - margin + std::min(displacement.Y, 0.0f),
+            bounds.MaxX + margin + std::max(displacement.X, 0.0f),
+            bounds.MaxY + margin + std::max(displacement.Y, 0.0f)
+        };
+    }
+
+    /// Clips the segment origin + t * delta, t in [0, maxFraction], to the slab [min, max] of one axis.
+    bool clipSlab(float origin, float delta, float min, float max, float& tMin, float& tMax)
+    {
+        if (std::abs(delta) < 1.0e-9f) {
+            return min <= origin && origin <= max;
+        }
+
+        float t1 = (min - origin) / delta;
+        float t2 = (max - origin) / delta;
+        if (t1 > t2) {
+            std::swap(t1, t2);
+        }
+        tMin = std::max(tMin, t1);
+        tMax = std::min(tMax, t2);
+        return tMin <= tMax;
+    }
+
+    /// @return The fraction of delta at which the segment enters bounds, if it does before maxFraction.
+    std::optional<float> intersectRay(const Bounds& bounds, Point2DF origin, Point2DF delta, float maxFraction)
+    {
+        float tMin = 0.0f, tMax = maxFraction;
+        if (!clipSlab(origin.X, delta.X, bounds.MinX, bounds.MaxX, tMin, tMax) ||
+            !clipSlab(origin.Y, delta.Y, bounds.MinY, bounds.MaxY, tMin, tMax))
+        {
+            return std::nullopt;
+        }
+        return tMin;
+    }
+} // end anonymous namespace
+
+
+AABBTree::AABBTree(float margin)
+    : _nodes()
+    , _root(NULL_PROXY)
+    , _freeList(NULL_PROXY)
+    , _count(0)
+    , _margin(margin)
+{
+    assert(margin >= 0.0f);
+}
+
+AABBTree::Proxy
+AABBTree::Insert(const RectangleF& rect, size_t id)
+{
+    const Proxy leaf = allocateNode();
+    Node& node  = _nodes[static_cast<size_t>(leaf)];
+    node.Fat    = fatten(rect, _margin, { 0.0f, 0.0f });
+    node.Rect   = rect;
+    node.Id     = id;
+    node.Height = 0;
+
+    insertLeaf(leaf);
+    ++_count;
+
+    return leaf;
+}
+
+void
+AABBTree::Remove(Proxy proxy)
+{
+    assert(isLeaf(proxy));
+    removeLeaf(proxy);
+    freeNode(proxy);
+    --_count;
+}
+
+bool
+AABBTree::Move(Proxy proxy, const RectangleF& rect)
+{
+    assert(isLeaf(proxy));
+    Node& node = _nodes[static_cast<size_t>(proxy)];
+    const Point2DF displacement = { rect.X - node.Rect.X, rect.Y - node.Rect.Y };
+    node.Rect = rect;
+    if (contains(node.Fat, toBounds(rect))) {
+        return false;
+    }
+
+    removeLeaf(proxy);
+    _nodes[static_cast<size_t>(proxy)].Fat = fatten(rect, _margin, displacement);
+    insertLeaf(proxy);
+
+    return true;
+}
+
+void
+AABBTree::Clear(void)
+{
+    _nodes.clear();
+    _root     = NULL_PROXY;
+    _freeList = NULL_PROXY;
+    _count    = 0;
+}
+
+void
+AABBTree::TranslateX(float dx)
+{
+    for (Node& node : _nodes)
+    {
+        node.Fat.MinX += dx;
+        node.Fat.MaxX += dx;
+        node.Rect.X   += dx;
+    }
+}
+
+void
+AABBTree::QueryOverlaps(const RectangleF& rect, const QueryCallback& callback) const
+{
+    const Bounds bounds = toBounds(rect);
+    std::array<Proxy, MAX_DEPTH> stack;
+    size_t size = 0;
+    if (_root != NULL_PROXY) {
+        stack[size++] = _root;
+    }
+
+    while (size > 0)
+    {
+        const Proxy proxy = stack[--size];
+        const Node& node  = _nodes[static_cast<size_t>(proxy)];
+        if (!overlaps(node.Fat, bounds)) {
+            continue;
+        }
+
+        if (node.Left == NULL_PROXY)
+        {
+            if (node.Rect.Overlaps(rect) && !callback(proxy)) {
+                return;
+            }
+            continue;
+        }
+
+        assert(size + 2 <= stack.size());
+        stack[size++] = node.Left;
+        stack[size++] = node.Right;
+    }
+}
+
+void
+AABBTree::QueryPairs(std::vector<std::pair<size_t, size_t>>& pairs) const
+{
+    // Descends the tree against itself: a node is paired with itself to find the pairs within it, and
+    // two overlapping nodes to find the pairs between them. Pairs of nodes that do not overlap are
+    // pruned along with every pair of leaves below them.
+    std::array<std::pair<Proxy, Proxy>, MAX_DEPTH> stack;
+    size_t size = 0;
+    if (_root != NULL_PROXY) {
+        stack[size++] = { _root, _root };
+    }
+
+    while (size > 0)
+    {
+        const auto [a, b] = stack[--size];
+        const Node& nodeA = _nodes[static_cast<size_t>(a)];
+        const Node& nodeB = _nodes[static_cast<size_t>(b)];
+        assert(size + 3 <= stack.size());
+
+        if (a == b)
+        {
+            if (nodeA.Left != NULL_PROXY)
+            {
+                stack[size++] = { nodeA.Left,  nodeA.Left };
+                stack[size++] = { nodeA.Right, nodeA.Right };
+                stack[size++] = { nodeA.Left,  nodeA.Right };
+            }
+            continue;
+        }
+
+        if (!overlaps(nodeA.Fat, nodeB.Fat)) {
+            continue;
+        }
+
+        const bool leafA = nodeA.Left == NULL_PROXY;
+        const bool leafB = nodeB.Left == NULL_PROXY;
+        if (leafA && leafB)
+        {
+            if (nodeA.Rect.Overlaps(nodeB.Rect)) {
+                pairs.emplace_back(std::min(nodeA.Id, nodeB.Id), std::max(nodeA.Id, nodeB.Id));
+            }
+            continue;
+        }
+
+        // Descend into the bigger node, so that both sides shrink at the same pace
+        if (leafB || (!leafA && perimeter(nodeA.Fat) > perimeter(nodeB.Fat)))
+        {
+            stack[size++] = { nodeA.Left,  b };
+            stack[size++] = { nodeA.Right, b };
+        }
+        else
+        {
+            stack[size++] = { a, nodeB.Left };
+            stack[size++] = { a, nodeB.Right };
+        }
+    }
+}
+
+std::optional<AABBTree::RayHit>
+AABBTree::RayCast(Point2DF origin, Point2DF end) const
+{
+    const Point2DF delta = { end.X - origin.X, end.Y - origin.Y };
+    std::optional<RayHit> hit;
+    float maxFraction = 1.0f;
+
+    std::array<Proxy, MAX_DEPTH> stack;
+    size_t size = 0;
+    if (_root != NULL_PROXY) {
+        stack[size++] = _root;
+    }
+
+    while (size > 0)
+    {
+        const Proxy proxy = stack[--size];
+        const Node& node  = _nodes[static_cast<size_t>(proxy)];
+        if (!intersectRay(node.Fat, origin, delta, maxFraction).has_value()) {
+            continue;
+        }
+
+        if (node.Left == NULL_PROXY)
+        {
+            // The ray is shortened to every hit, so the hits are getting closer
+            const std::optional<float> fraction = intersectRay(toBounds(node.Rect), origin, delta, maxFraction);
+            if (fraction.has_value())
+            {
+                maxFraction = *fraction;
+                hit = RayHit{
+                    proxy, maxFraction,
+                    { origin.X + maxFraction * delta.X, origin.Y + maxFraction * delta.Y }
+                };
+            }
+            continue;
+        }
+
+        assert(size + 2 <= stack.size());
+        stack[size++] = node.Left;
+        stack[size++] = node.Right;
+    }
+
+    return hit;
+}
+
+size_t
+AABBTree::GetId(Proxy proxy) const
+{
+    assert(isLeaf(proxy));
+    return _nodes[static_cast<size_t>(proxy)].Id;
+}
+
+const RectangleF&
+AABBTree::GetRect(Proxy proxy) const
+{
+    assert(isLeaf(proxy));
+    return _nodes[static_cast<size_t>(proxy)].Rect;
+}
+
+AABBTree::Bounds
+AABBTree::GetFatBounds(Proxy proxy) const
+{
+    assert(isLeaf(proxy));
+    return _nodes[static_cast<size_t>(proxy)].Fat;
+}
+
+size_t
+AABBTree::GetCount(void) const { return _count; }
+
+int
+AABBTree::GetHeight(void) const
+{
+    return _root == NULL_PROXY ? 0 : _nodes[static_cast<size_t>(_root)].Height;
+}
+
+bool
+AABBTree::IsValid(void) const
+{
+    return _root == NULL_PROXY ? _count == 0 : isValid(_root, NULL_PROXY);
+}
+
+// Private methods
+AABBTree::Proxy
+AABBTree::allocateNode(void)
+{
+    if (_freeList == NULL_PROXY)
+    {
+        _nodes.push_back({});
+        _nodes.back().Parent = NULL_PROXY;
+        _nodes.back().Height = -1;
+        _freeList = static_cast<Proxy>(_nodes.size() - 1);
+    }
+
+    const Proxy proxy = _freeList;
+    Node& node = _nodes[static_cast<size_t>(proxy)];
+    _freeList   = node.Parent;
+    node.Parent = NULL_PROXY;
+    node.Left   = NULL_PROXY;
+    node.Right  = NULL_PROXY;
+    node.Height = 0;
+
+    return proxy;
+}
+
+void
+AABBTree::freeNode(Proxy proxy)
+{
+    Node& node  = _nodes[static_cast<size_t>(proxy)];
+    node.Parent = _freeList;
+    node.Height = -1;
+    _freeList   = proxy;
+}
+
+void
+AABBTree::insertLeaf(Proxy leaf)
+{
+    if (_root == NULL_PROXY)
+    {
+        _root = leaf;
+        _nodes[static_cast<size_t>(leaf)].Parent = NULL_PROXY;
+        return;
+    }
+
+    // Walk down to the sibling that is cheapest to pair the leaf with. The cost of a node is the
+    // perimeter it adds to the tree, descending into a child also grows the node itself.
+    const Bounds fat = _nodes[static_cast<size_t>(leaf)].Fat;
+    Proxy sibling = _root;
+    while (_nodes[static_cast<size_t>(sibling)].Left != NULL_PROXY)
+    {
+        const Node& node = _nodes[static_cast<size_t>(sibling)];
+        const float combined    = perimeter(unite(node.Fat, fat));
+        const float pairCost    = 2.0f * combined;
+        const float descendCost = 2.0f * (combined - perimeter(node.Fat));
+
+        const auto childCost = [this, &fat, descendCost](Proxy child)
+        {
+            const Node& c = _nodes[static_cast<size_t>(child)];
+            const float grown = perimeter(unite(c.Fat, fat));
+            return descendCost + (c.Left == NULL_PROXY ? grown : grown - perimeter(c.Fat));
+        };
+        const float leftCost  = childCost(node.Left);
+        const float rightCost = childCost(node.Right);
+
+        if (pairCost < leftCost && pairCost < rightCost) {
+            break;
+        }
+        sibling = leftCost < rightCost ? node.Left : node.Right;
+    }
+
+    // Allocating may reallocate the nodes, so they are only referred to by their proxies
+    const Proxy parent    = allocateNode();
+    const Proxy oldParent = _nodes[static_cast<size_t>(sibling)].Parent;
+    Node& node  = _nodes[static_cast<size_t>(parent)];
+    node.Parent = oldParent;
+    node.Left   = sibling;
+    node.Right  = leaf;
+    node.Fat    = unite(_nodes[static_cast<size_t>(sibling)].Fat, fat);
+    node.Height = _nodes[static_cast<size_t>(sibling)].Height + 1;
+
+    replaceChild(oldParent, sibling, parent);
+    _nodes[static_cast<size_t>(sibling)].Parent = parent;
+    _nodes[static_cast<size_t>(leaf)].Parent    = parent;
+
+    refit(oldParent);
+}
+
+void
+AABBTree::removeLeaf(Proxy leaf)
+{
+    if (leaf == _root)
+    {
+        _root = NULL_PROXY;
+        return;
+    }
+
+    const Proxy parent      = _nodes[static_cast<size_t>(leaf)].Parent;
+    const Proxy grandParent = _nodes[static_cast<size_t>(parent)].Parent;
+    const Proxy sibling     = _nodes[static_cast<size_t>(parent)].Left == leaf
+                            ? _nodes[static_cast<size_t>(parent)].Right
+                            : _nodes[static_cast<size_t>(parent)].Left;
+
+    replaceChild(grandParent, parent, sibling);
+    _nodes[static_cast<size_t>(sibling)].Parent = grandParent;
+    freeNode(parent);
+
+    refit(grandParent);
+}
+
+void
+AABBTree::refit(Proxy proxy)
+{
+    while (proxy != NULL_PROXY)
+    {
+        proxy = balance(proxy);
+
+        Node& node = _nodes[static_cast<size_t>(proxy)];
+        const Node& left  = _nodes[static_cast<size_t>(node.Left)];
+        const Node& right = _nodes[static_cast<size_t>(node.Right)];
+        node.Height = 1 + std::max(left.Height, right.Height);
+        node.Fat    = unite(left.Fat, right.Fat);
+
+        proxy = node.Parent;
+    }
+}
+
+AABBTree::Proxy
+AABBTree::balance(Proxy a)
+{
+    Node& nodeA = _nodes[static_cast<size_t>(a)];
+    if (nodeA.Left == NULL_PROXY || nodeA.Height < 2) {
+        return a;
+    }
+
+    const Proxy b = nodeA.Left;
+    const Proxy c = nodeA.Right;
+    Node& nodeB = _nodes[static_cast<size_t>(b)];
+    Node& nodeC = _nodes[static_cast<size_t>(c)];
+    const int32_t difference = nodeC.Height - nodeB.Height;
+
+    // The taller child takes the place of a, a keeps its shorter child and gets the shorter
+    // grandchild, the taller grandchild stays with the child.
+    const auto rotateUp = [this, a, &nodeA](Proxy up, Proxy other, bool upWasRight)
+    {
+        Node& nodeUp = _nodes[static_cast<size_t>(up)];
+        const Proxy f = nodeUp.Left;
+        const Proxy g = nodeUp.Right;
+        const Node& nodeF = _nodes[static_cast<size_t>(f)];
+        const Node& nodeG = _nodes[static_cast<size_t>(g)];
+        const Node& nodeOther = _nodes[static_cast<size_t>(other)];
+
+        nodeUp.Left   = a;
+        nodeUp.Parent = nodeA.Parent;
+        nodeA.Parent  = up;
+        replaceChild(nodeUp.Parent, a, up);
+
+        const Proxy taller  = nodeF.Height > nodeG.Height ? f : g;
+        const Proxy shorter = taller == f ? g : f;
+        Node& nodeShorter   = _nodes[static_cast<size_t>(shorter)];
+        const Node& nodeTaller = _nodes[static_cast<size_t>(taller)];
+
+        nodeUp.Right = taller;
+        if (upWasRight) {
+            nodeA.Right = shorter;
+        } else {
+            nodeA.Left  = shorter;
+        }
+        nodeShorter.Parent = a;
+
+        nodeA.Fat     = unite(nodeOther.Fat, nodeShorter.Fat);
+        nodeA.Height  = 1 + std::max(nodeOther.Height, nodeShorter.Height);
+        nodeUp.Fat    = unite(nodeA.Fat, nodeTaller.Fat);
+        nodeUp.Height = 1 + std::max(nodeA.Height, nodeTaller.Height);
+    };
+
+    if (difference > 1)
+    {
+        rotateUp(c, b, true);
+        return c;
+    }
+    if (difference < -1)
+    {
+        rotateUp(b, c, false);
+        return b;
+    }
+
+    return a;
+}
+
+void
+AABBTree::replaceChild(Proxy parent, Proxy oldChild, Proxy newChild)
+{
+    if (parent == NULL_PROXY)
+    {
+        _root = newChild;
+        return;
+    }
+
+    Node& node = _nodes[static_cast<size_t>(parent)];
+    if (node.Left == oldChild) {
+        node.Left  = newChild;
+    } else {
+        assert(node.Right == oldChild);
+        node.Right = newChild;
+    }
+}
+
+bool
+AABBTree::isLeaf(Proxy proxy) const
+{
+    return 0 <= proxy && static_cast<size_t>(proxy) < _nodes.size()
+        && _nodes[static_cast<size_t>(proxy)].Height == 0;
+}
+
+bool
+AABBTree::isValid(Proxy proxy, Proxy parent) const
+{
+    const Node& node = _nodes[static_cast<size_t>(proxy)];
+    if (node.Parent != parent || node.Height < 0) {
+        return false;
+    }
+    if (node.Left == NULL_PROXY) {
+        return node.Height == 0 && node.Right == NULL_PROXY && contains(node.Fat, toBounds(node.Rect));
+    }
+
+    const Node& left  = _nodes[static_cast<size_t>(node.Left)];
+    const Node& right = _nodes[static_cast<size_t>(node.Right)];
+    return node.Height == 1 + std::max(left.Height, right.Height)
+        && contains(node.Fat, left.Fat) && contains(node.Fat, right.Fat)
+        && isValid(node.Left, proxy) && isValid(node.Right, proxy);
+}
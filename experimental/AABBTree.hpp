@@ -0,0 +1,133 @@
+#ifndef AABBTREE_HPP
+#define AABBTREE_HPP
+
+#include "Geometry.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <utility>
+#include <vector>
+
+
+/// A dynamic bounding volume tree of axis aligned rectangles, for finding the colliders that overlap
+/// a rectangle or a ray without testing every one of them. Each leaf stores fat bounds of its
+/// rectangle, grown by a margin and stretched in the direction it last moved. A collider that moves
+/// within its fat bounds only updates its leaf, the others are removed and reinserted, which refits
+/// the bounds of their ancestors. The tree is kept balanced with AVL rotations, new leaves
+/// are inserted beside the sibling that grows the perimeters of the tree the least.
+/// The nodes live in one vector and are recycled through a free list, so a tree of a stable size
+/// does not allocate.
+/// NOTE: Not part of the game, it lives outside of src/ until there are colliders that move. The
+///       terrain is static and is queried through the Heightfield of the level. Covered by
+///       AABBTreeTest and AABBTreeBenchmark.
+class AABBTree
+{
+public:
+    using Proxy = int32_t;
+    inline static constexpr Proxy NULL_PROXY = -1;
+
+    /// Called with the proxy of every leaf found by a query.
+    /// @return false to end the query.
+    using QueryCallback = std::function<bool(Proxy proxy)>;
+
+    /// The corners of a rectangle. Uniting them is exact, unlike uniting the sizes of rectangles,
+    /// so a parent always contains its children.
+    struct Bounds
+    {
+        float MinX, MinY, MaxX, MaxY;
+    };
+
+    struct RayHit
+    {
+        Proxy    HitProxy;
+        float    Fraction; // Of the way from the origin to the end of the ray
+        Point2DF Point;
+    };
+
+public:
+    /// @param margin The amount the fat bounds are grown on every side.
+    AABBTree(float margin);
+    AABBTree(const AABBTree& other) = delete;
+    AABBTree(AABBTree&& other)      = delete;
+    ~AABBTree(void) = default;
+
+    /// @param id Identifies the collider to the caller, returned by GetId.
+    /// @return The proxy of the new leaf, valid until the leaf is removed.
+    Proxy Insert(const RectangleF& rect, size_t id);
+    void  Remove(Proxy proxy);
+
+    /// Updates the rectangle of a leaf, the leaf is reinserted if the rectangle has left its fat bounds.
+    /// @return true if the leaf was reinserted.
+    bool  Move(Proxy proxy, const RectangleF& rect);
+
+    void  Clear(void);
+
+    /// Moves every leaf dx units along the x-axis, the structure of the tree does not change.
+    void  TranslateX(float dx);
+
+    /// Calls callback for every leaf whose rectangle overlaps rect, in no particular order.
+    void  QueryOverlaps(const RectangleF& rect, const QueryCallback& callback) const;
+
+    /// Appends the ids of every pair of leaves whose rectangles overlap, the smaller id first.
+    void  QueryPairs(std::vector<std::pair<size_t, size_t>>& pairs) const;
+
+    /// @return The first leaf hit by the segment from origin to end, if any.
+    std::optional<RayHit> RayCast(Point2DF origin, Point2DF end) const;
+
+    size_t            GetId(Proxy proxy)        const;
+    const RectangleF& GetRect(Proxy proxy)      const;
+    Bounds            GetFatBounds(Proxy proxy) const;
+
+    /// @return The amount of leaves.
+    size_t GetCount(void)  const;
+    int    GetHeight(void) const;
+
+    /// @return true if every parent link, height and fat bounds of the tree are consistent.
+    bool   IsValid(void)   const;
+
+private:
+    // The size of the stacks of the queries, far more than the height of a balanced tree ever gets
+    inline static constexpr size_t MAX_DEPTH = 256;
+
+    struct Node
+    {
+        Bounds     Fat;    // Contains the rectangles of every leaf below the node
+        RectangleF Rect;   // Leaves only
+        size_t     Id;     // Leaves only
+        Proxy      Parent; // The next free node while the node is free
+        Proxy      Left;   // NULL_PROXY for leaves
+        Proxy      Right;
+        int32_t    Height; // 0 for leaves, -1 for free nodes
+    };
+
+    Proxy allocateNode(void);
+    void  freeNode(Proxy node);
+
+    void  insertLeaf(Proxy leaf);
+    void  removeLeaf(Proxy leaf);
+
+    /// Recomputes the heights and the fat bounds from node up to the root, balancing on the way.
+    void  refit(Proxy node);
+
+    /// Rotates the taller child of node up if the heights of its children differ by more than one.
+    /// @return The node that took the place of node.
+    Proxy balance(Proxy node);
+
+    /// Replaces the child oldChild of parent, or the root if parent is NULL_PROXY, with newChild.
+    void  replaceChild(Proxy parent, Proxy oldChild, Proxy newChild);
+
+    bool  isLeaf(Proxy node) const;
+    bool  isValid(Proxy node, Proxy parent) const;
+
+private:
+    std::vector<Node> _nodes;
+    Proxy             _root;
+    Proxy             _freeList;
+    size_t            _count;
+    float             _margin;
+
+};
+
+#endif // AABBTREE_HPP
@@ -16,10 +16,27 @@
 _BUILDDIR="build/debug"
 _BINDIR="bin"
 _TESTS=(
+    "AABBTreeTest"
+    "BatchRunnerTest"
+    "BotSwarmTest"
     "ColorTest"
+    "GameLevelTest"
     "GeometryTest"
+    "HeightfieldTest"
+    "HelpersTest"
+    "LevelValidatorTest"
     "LoggerTest"
+    "ParticleEmitterTest"
     "PhysicsTest"
+    "RenderQueueTest"
+    "RenderThreadTest"
+    "ReplayTest"
+    "RollbackTest"
+    "RingBufferTest"
+    "SkylinePackerTest"
+    "TaskSchedulerTest"
+    "TerrainCacheTest"
+    "TileMapTest"
     "TimetoolsTest"
 )
 
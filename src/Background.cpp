@@ -37,7 +37,7 @@ const SDL_Texture*
 Background::GetTexture(void) const { return _imageTexture.GetTexture(); }
 
 void
-Background::Draw(const Renderer& renderer, const Camera& camera, [[maybe_unused]] Timestep it) const
+Background::Draw(RenderQueue& queue, const Camera& camera, [[maybe_unused]] Timestep it) const
 {
     // TODO: Interpolate bg position, is it needed?
     assert(_imageRect.w == camera.GetDimensions().W); // background image must be of same width as the camera viewport width
@@ -49,5 +49,5 @@ Background::Draw(const Renderer& renderer, const Camera& camera, [[maybe_unused]
         _imageRect.h
     };
 
-    _imageTexture.Render(renderer, &transformed, nullptr);
+    queue.Copy(RenderQueue::Layer::BACKGROUND, _imageTexture.GetTexture(), &transformed, nullptr);
 }
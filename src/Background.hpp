@@ -2,6 +2,7 @@
 #define BACKGROUND_HPP
 
 #include "Camera.hpp"
+#include "RenderQueue.hpp"
 #include "Renderer.hpp"
 #include "Texture.hpp"
 #include "Timetools.hpp"
@@ -24,7 +25,7 @@ public:
     const SDL_Surface* GetSurface(void) const;
     const SDL_Texture* GetTexture(void) const;
 
-    void Draw(const Renderer& renderer, const Camera& camera, Timestep it) const;
+    void Draw(RenderQueue& queue, const Camera& camera, Timestep it) const;
 
 private:
     const std::string _filepath;
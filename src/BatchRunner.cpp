@@ -0,0 +1,119 @@
+#include "BatchRunner.hpp"
+#include "Constants.hpp"
+#include "GameObject.hpp"
+#include "Logger.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <fstream>
+#include <thread>
+
+
+BatchRunner::BatchRunner(size_t threadsCount)
+    : _threadsCount(threadsCount > 0 ? threadsCount : std::max(1u, std::thread::hardware_concurrency()))
+{
+    //
+}
+
+std::vector<BatchRunner::Result>
+BatchRunner::Run(unsigned int firstSeed, size_t seedsCount) const
+{
+    std::vector<Result>      results(seedsCount);
+    std::atomic<size_t>      nextIndex(0);
+    std::vector<std::thread> workers;
+
+    // The seeds take different times to simulate, so the workers take the next seed when they are done
+    const auto work = [&results, &nextIndex, firstSeed, seedsCount]() {
+        for (size_t i = nextIndex++; i < seedsCount; i = nextIndex++) {
+            results[i] = RunSeed(firstSeed + static_cast<unsigned int>(i));
+        }
+    };
+
+    const size_t threadsCount = std::min(_threadsCount, std::max(seedsCount, size_t(1)));
+    workers.reserve(threadsCount);
+    for (size_t t = 0; t < threadsCount; ++t) {
+        workers.emplace_back(work);
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+
+    return results;
+}
+
+size_t
+BatchRunner::GetThreadsCount(void) const { return _threadsCount; }
+
+BatchRunner::Result
+BatchRunner::RunSeed(unsigned int seed)
+{ // Static function
+    Input input;
+    std::unique_ptr<PlayerObject> player = GameObject::CreatePlayer(
+        input, 0.0f, 0.0f,
+        Constants::Player::MOVE_FORCE,
+        Constants::Player::RADIUS,
+        nullptr,
+        Constants::Colors::LIGHT
+    );
+    std::unique_ptr<GameLevel> level = GameLevel::CreateHeadlessLevel(
+        input, GameLevel::Mode::FIXED, seed, Constants::Level::ARENA_SIZE,
+        Constants::Level::GRAVITY, Constants::Level::FRICTION, Constants::Level::INITIAL_TIME,
+        player.get()
+    );
+
+    // Same rates as in the game, input is handled once for every few updates
+    const Timestep dt(1.0 / static_cast<double>(Constants::TARGET_UPS));
+    const size_t   updatesPerInput = Constants::TARGET_UPS / Constants::TARGET_FPS;
+    size_t         updates = 0;
+
+    pressBotKeys(input);
+    while (!level->IsCompleted() && !level->IsTimeUp())
+    {
+        level->HandleInput();
+        for (size_t i = 0; i < updatesPerInput; ++i)
+        {
+            level->Update(dt);
+            level->HandleCollisions();
+            ++updates;
+        }
+    }
+
+    return {
+        seed,
+        level->IsCompleted(),
+        Constants::Level::INITIAL_TIME - level->GetTimeLeft().GetSeconds(),
+        level->GetFallsCount(),
+        level->GetScore(),
+        updates
+    };
+}
+
+bool
+BatchRunner::WriteCsv(const std::string& filepath, const std::vector<Result>& results)
+{ // Static function
+    std::ofstream file(filepath);
+    if (!file) {
+        Logger::Critical("Unable to open \"{}\" for writing", filepath);
+        return false;
+    }
+
+    file << "seed,completed,time_used,falls,score,updates\n";
+    for (const Result& r : results)
+    {
+        file << fmt::format("{},{},{:.3f},{},{},{}\n",
+            r.Seed, r.Completed ? 1 : 0, r.TimeUsed, r.Falls, r.Score, r.Updates
+        );
+    }
+
+    return static_cast<bool>(file);
+}
+
+// Private methods
+void
+BatchRunner::pressBotKeys(Input& input)
+{ // Static function
+    input.SetKeyPressed(Input::KeyCode::RIGHT, true);
+    input.SetKeyPressed(Input::KeyCode::UP,    true);
+    input.SetKeyPressed(Input::KeyCode::SPACE, true);
+}
@@ -0,0 +1,56 @@
+#ifndef BATCHRUNNER_HPP
+#define BATCHRUNNER_HPP
+
+#include "GameLevel.hpp"
+#include "Input.hpp"
+
+#include <string>
+#include <vector>
+
+
+/// Plays FIXED levels generated from many different seeds in headless simulations, with a scripted
+/// player. Every seed is simulated by one worker thread from start to end, and the simulations
+/// share no mutable state, so the throughput scales with the amount of threads.
+class BatchRunner
+{
+public:
+    struct Result
+    {
+        unsigned int Seed;
+        bool         Completed;
+        double       TimeUsed;  // Simulated seconds
+        int          Falls;
+        int          Score;
+        size_t       Updates;
+    };
+
+public:
+    /// @param threadsCount The amount of worker threads, 0 = the amount of hardware threads.
+    BatchRunner(size_t threadsCount = 0);
+    BatchRunner(const BatchRunner& other) = delete;
+    BatchRunner(BatchRunner&& other)      = delete;
+    ~BatchRunner(void) = default;
+
+    /// Simulates the seeds [firstSeed, firstSeed + seedsCount).
+    /// @return The results ordered by the seed.
+    std::vector<Result> Run(unsigned int firstSeed, size_t seedsCount) const;
+
+    size_t GetThreadsCount(void) const;
+
+    /// Simulates one seed until the level is completed or the time runs out.
+    static Result RunSeed(unsigned int seed);
+
+    /// Writes the results as comma separated values, with a header row.
+    /// @return true if the file was written successfully.
+    static bool WriteCsv(const std::string& filepath, const std::vector<Result>& results);
+
+private:
+    /// The scripted player: holds the keys to run right and to jump as high as possible whenever it can.
+    static void pressBotKeys(Input& input);
+
+private:
+    size_t _threadsCount;
+
+};
+
+#endif // BATCHRUNNER_HPP
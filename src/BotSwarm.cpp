@@ -0,0 +1,441 @@
+#include "BotSwarm.hpp"
+#include "GameObject.hpp"
+#include "Helpers.hpp"
+#include "Motion.hpp"
+#include "Replay.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <thread>
+
+
+namespace
+{
+    // The bits of a key bitmask, in the order of Replay::KEYS
+    constexpr uint8_t KEY_UP    = 1 << 0;
+    constexpr uint8_t KEY_RIGHT = 1 << 3;
+    constexpr uint8_t KEY_SPACE = 1 << 4;
+    static_assert(Replay::KEYS[0] == Input::KeyCode::UP    && Replay::KEYS[1] == Input::KeyCode::DOWN);
+    static_assert(Replay::KEYS[2] == Input::KeyCode::LEFT  && Replay::KEYS[3] == Input::KeyCode::RIGHT);
+    static_assert(Replay::KEYS[4] == Input::KeyCode::SPACE);
+} // end anonymous namespace
+
+
+BotSwarm::BotSwarm(size_t count, float moveForce, float radius, unsigned int seed, size_t threadsCount)
+    : _moveForce(moveForce)
+    , _radius(radius)
+    , _seed(seed)
+    , _threadsCount(threadsCount > 0 ? threadsCount : std::max(1u, std::thread::hardware_concurrency()))
+    , _fallingKeys(createKeyForces(FallingState::KEYS))
+    , _jumpingKeys(createKeyForces(JumpingState::KEYS))
+    , _jumpingKeysWithJumps(createKeyForces(JumpingState::KEYS_WITH_JUMPS))
+    , _onGroundKeys(createKeyForces(OnGroundState::KEYS))
+    , _positionX(count)
+    , _positionY(count)
+    , _velocityX(count)
+    , _velocityY(count)
+    , _frictionX(count)
+    , _frictionY(count)
+    , _forceX(count)
+    , _forceY(count)
+    , _state(count)
+    , _jumpsLeft(count)
+    , _groundY(count)
+    , _groundBegin(count)
+    , _groundEnd(count)
+    , _lookahead(count)
+    , _keys(count)
+    , _workers()
+    , _mutex()
+    , _jobCondition()
+    , _doneCondition()
+    , _job()
+    , _generation(0)
+    , _pending(0)
+    , _quit(false)
+{
+    Reset();
+}
+
+BotSwarm::~BotSwarm(void)
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _quit = true;
+    }
+    _jobCondition.notify_all();
+    for (std::thread& worker : _workers) {
+        worker.join();
+    }
+}
+
+void
+BotSwarm::Reset(void)
+{
+    // The same initial state as the player of a new level, spread out so that the bots take different paths
+    std::fill(_positionY.begin(), _positionY.end(), 2.0f * _radius);
+    std::fill(_velocityX.begin(), _velocityX.end(), 0.0f);
+    std::fill(_velocityY.begin(), _velocityY.end(), 0.0f);
+    std::fill(_frictionX.begin(), _frictionX.end(), 1.0f);
+    std::fill(_frictionY.begin(), _frictionY.end(), 1.0f);
+    std::fill(_forceX.begin(),    _forceX.end(),    1.0f);
+    std::fill(_forceY.begin(),    _forceY.end(),    1.0f);
+    std::fill(_state.begin(),     _state.end(),     State::FALLING);
+    std::fill(_jumpsLeft.begin(), _jumpsLeft.end(), uint8_t(0));
+    std::fill(_groundY.begin(),   _groundY.end(),   0.0f);
+    std::fill(_groundBegin.begin(), _groundBegin.end(), 0.0f);
+    std::fill(_groundEnd.begin(),   _groundEnd.end(),   0.0f);
+    std::fill(_keys.begin(),      _keys.end(),      uint8_t(0));
+
+    Helpers::random::Generator random(_seed);
+    for (size_t i = 0; i < GetCount(); ++i)
+    {
+        _positionX[i] = random.FloatInRange(2.0f * _radius, 6.0f * _radius);
+        _lookahead[i] = random.FloatInRange(0.5f * _radius, 3.0f * _radius);
+    }
+}
+
+void
+BotSwarm::HandleInput(void)
+{
+    dispatch({ Phase::INPUT, nullptr, { 0, 0 }, nullptr, 0.0, true, 0, 0 });
+}
+
+void
+BotSwarm::HandleInput(uint8_t keys)
+{
+    std::fill(_keys.begin(), _keys.end(), keys);
+    handleInput(0, GetCount(), _keys.data());
+}
+
+void
+BotSwarm::Update(const Physics& physics, Dimensions2D boundaries, Timestep dt)
+{
+    dispatch({ Phase::UPDATE, &physics, boundaries, nullptr, static_cast<double>(dt), false, 0, 0 });
+}
+
+void
+BotSwarm::HandleCollisions(const Heightfield& terrain)
+{
+    dispatch({ Phase::COLLISIONS, nullptr, { 0, 0 }, &terrain, 0.0, false, 0, 0 });
+}
+
+void
+BotSwarm::Step(const Physics& physics, Dimensions2D boundaries, const Heightfield& terrain,
+               Timestep dt, bool handleInput)
+{
+    dispatch({ Phase::STEP, &physics, boundaries, &terrain, static_cast<double>(dt), handleInput, 0, 0 });
+}
+
+void
+BotSwarm::Draw(RenderQueue& queue, const Camera& camera, Timestep it, Color color) const
+{
+    const float diameter = 2.0f * _radius;
+    const int   radius   = static_cast<int>(_radius + 0.5f);
+    for (size_t i = 0; i < GetCount(); ++i)
+    {
+        // Interpolated like Transform::GetScreenCoords
+        const float x = _positionX[i] + static_cast<float>(it) * _velocityX[i];
+        const float y = _positionY[i] + static_cast<float>(it) * _velocityY[i];
+        if (!camera.RectangleIsInViewport({ x - _radius, y - _radius, diameter, diameter })) {
+            continue;
+        }
+
+        const Point2D centre = { static_cast<int>(x + 0.5f), static_cast<int>(y + 0.5f) };
+        queue.FillCircle(RenderQueue::Layer::PARTICLES, camera.Transform(centre), radius, color);
+    }
+}
+
+void
+BotSwarm::TranslateX(float dx)
+{
+    for (size_t i = 0; i < GetCount(); ++i)
+    {
+        _positionX[i]   += dx;
+        _groundBegin[i] += dx;
+        _groundEnd[i]   += dx;
+    }
+}
+
+void
+BotSwarm::SetPosition(size_t bot, Point2DF position)
+{
+    _positionX[bot] = position.X;
+    _positionY[bot] = position.Y;
+}
+
+size_t
+BotSwarm::GetCount(void) const { return _positionX.size(); }
+
+size_t
+BotSwarm::GetThreadsCount(void) const { return _threadsCount; }
+
+Point2DF
+BotSwarm::GetPosition(size_t bot) const { return { _positionX[bot], _positionY[bot] }; }
+
+Point2DF
+BotSwarm::GetVelocity(size_t bot) const { return { _velocityX[bot], _velocityY[bot] }; }
+
+bool
+BotSwarm::IsOnGround(size_t bot) const { return _state[bot] == State::ON_GROUND; }
+
+float
+BotSwarm::GetMaxX(void) const
+{
+    return _positionX.empty() ? 0.0f : *std::max_element(_positionX.begin(), _positionX.end());
+}
+
+// Private methods
+std::vector<BotSwarm::KeyForce>
+BotSwarm::createKeyForces(const std::vector<Input::KeyCode>& keys) const
+{
+    // The commands that an InputComponent binds to the keys
+    std::vector<KeyForce> keyForces;
+    for (Input::KeyCode key : keys)
+    {
+        const auto index = std::find(Replay::KEYS.begin(), Replay::KEYS.end(), key) - Replay::KEYS.begin();
+        const uint8_t bit = static_cast<uint8_t>(1 << index);
+        switch (key)
+        {
+            case Input::KeyCode::UP:    keyForces.push_back({ bit, Physics::Direction::NORTH, Motion::GetMoveForce(Physics::Direction::NORTH, _moveForce) }); break;
+            case Input::KeyCode::DOWN:  keyForces.push_back({ bit, Physics::Direction::SOUTH, Motion::GetMoveForce(Physics::Direction::SOUTH, _moveForce) }); break;
+            case Input::KeyCode::LEFT:  keyForces.push_back({ bit, Physics::Direction::WEST,  Motion::GetMoveForce(Physics::Direction::WEST,  _moveForce) }); break;
+            case Input::KeyCode::RIGHT: keyForces.push_back({ bit, Physics::Direction::EAST,  Motion::GetMoveForce(Physics::Direction::EAST,  _moveForce) }); break;
+            case Input::KeyCode::SPACE: keyForces.push_back({ bit, Physics::Direction::NORTH, Motion::GetJumpForce(_moveForce) });                          break;
+            default:
+                assert(false); // A key that no state handles
+                break;
+        }
+    }
+    return keyForces;
+}
+
+void
+BotSwarm::handleInput(size_t begin, size_t end, const uint8_t* keys)
+{
+    // The same keys and state changes as the states of a PlayerObject
+    for (size_t i = begin; i < end; ++i)
+    {
+        const uint8_t pressed = keys[i];
+        switch (_state[i])
+        {
+            case State::FALLING:
+                applyKeys(i, pressed, _fallingKeys);
+                break;
+
+            case State::JUMPING:
+                if (_jumpsLeft[i] == 0) {
+                    applyKeys(i, pressed, _jumpingKeys);
+                } else if (applyKeys(i, pressed, _jumpingKeysWithJumps)) {
+                    --_jumpsLeft[i];
+                }
+                break;
+
+            case State::ON_GROUND:
+                if (applyKeys(i, pressed, _onGroundKeys))
+                {
+                    _state[i]     = State::JUMPING;
+                    _jumpsLeft[i] = Motion::JUMPS_COUNT;
+                }
+                break;
+        }
+    }
+}
+
+void
+BotSwarm::chooseKeys(size_t begin, size_t end)
+{
+    // Runs right, glides in the air and jumps when the end of the ground approaches
+    for (size_t i = begin; i < end; ++i)
+    {
+        const bool nearEdge = _positionX[i] + _lookahead[i] > _groundEnd[i];
+        switch (_state[i])
+        {
+            case State::ON_GROUND: _keys[i] = nearEdge ? KEY_RIGHT | KEY_UP | KEY_SPACE : KEY_RIGHT; break;
+            case State::JUMPING:   _keys[i] = KEY_RIGHT | KEY_UP;                                   break;
+            case State::FALLING:   _keys[i] = KEY_RIGHT | KEY_UP;                                   break;
+        }
+    }
+}
+
+void
+BotSwarm::update(const Physics& physics, Dimensions2D boundaries, Timestep dt, size_t begin, size_t end)
+{
+    const float deltaTime   = static_cast<float>(dt);
+    const float gravityX    = physics.GetGravity().x;
+    const float gravityY    = physics.GetGravity().y;
+    const float scaleX      = physics.GetFriction().x;
+    const float scaleY      = physics.GetFriction().y;
+    const float left        = _radius;
+    const float top         = _radius;
+    const float right       = static_cast<float>(boundaries.W) - _radius;
+    const float arenaBottom = static_cast<float>(boundaries.H) - _radius;
+    const float diameter    = 2.0f * _radius;
+
+    // The HandleUpdate of the states of a PlayerObject, on the XY-plane
+    for (size_t i = begin; i < end; ++i)
+    {
+        const float bottom = _state[i] == State::ON_GROUND ? _groundY[i] : arenaBottom;
+        const float vx = Motion::StepAxis(gravityX, scaleX, deltaTime, _frictionX[i], _forceX[i], _velocityX[i]);
+        const float vy = Motion::StepAxis(gravityY, scaleY, deltaTime, _frictionY[i], _forceY[i], _velocityY[i]);
+        _velocityX[i]  = Motion::LimitX(_positionX[i], vx, left, right);
+        _velocityY[i]  = Motion::LimitY(_positionY[i], vy, top, bottom);
+        _positionX[i] += _velocityX[i];
+        _positionY[i] += _velocityY[i];
+
+        if (_state[i] == State::JUMPING && Motion::StartsFalling(_velocityY[i])) {
+            _state[i] = State::FALLING;
+        } else if (_state[i] == State::ON_GROUND) {
+            const RectangleF bot = { _positionX[i] - _radius, _positionY[i] - _radius, diameter, diameter };
+            if (Motion::LeavesGround(bot, _groundBegin[i], _groundEnd[i])) {
+                _state[i] = State::FALLING;
+            }
+        }
+    }
+}
+
+void
+BotSwarm::handleCollisions(const Heightfield& terrain, size_t begin, size_t end)
+{
+    const float diameter = 2.0f * _radius;
+    for (size_t i = begin; i < end; ++i)
+    {
+        // Only the FallingState of a PlayerObject collides
+        if (_state[i] != State::FALLING) {
+            continue;
+        }
+
+        // Only the first block hit counts, as GameLevel does for the player
+        const RectangleF bot = { _positionX[i] - _radius, _positionY[i] - _radius, diameter, diameter };
+        const Heightfield::Span* hit = nullptr;
+        terrain.QueryOverlaps(bot, [&hit](const Heightfield::Span& span) {
+            hit = &span;
+            return false;
+        });
+        if (hit == nullptr) {
+            continue;
+        }
+
+        if (Motion::Lands(_velocityY[i]))
+        {
+            const auto [groundBegin, groundEnd] = terrain.GetRunBounds(*hit);
+            _velocityY[i]   = 0.0f;
+            _state[i]       = State::ON_GROUND;
+            _groundY[i]     = _positionY[i];
+            _groundBegin[i] = groundBegin;
+            _groundEnd[i]   = groundEnd;
+        }
+        else
+        {
+            _velocityY[i] = Motion::Bounce(_velocityY[i]);
+            _state[i]     = State::JUMPING;
+            _jumpsLeft[i] = Motion::JUMPS_COUNT;
+        }
+    }
+}
+
+void
+BotSwarm::run(const Job& job, size_t begin, size_t end)
+{
+    if (job.JobPhase == Phase::INPUT || (job.JobPhase == Phase::STEP && job.WithInput))
+    {
+        chooseKeys(begin, end);
+        handleInput(begin, end, _keys.data());
+    }
+    if (job.JobPhase == Phase::UPDATE || job.JobPhase == Phase::STEP) {
+        update(*job.StepPhysics, job.Boundaries, Timestep(job.Dt), begin, end);
+    }
+    if (job.JobPhase == Phase::COLLISIONS || job.JobPhase == Phase::STEP) {
+        handleCollisions(*job.Terrain, begin, end);
+    }
+}
+
+void
+BotSwarm::dispatch(const Job& job)
+{
+    const size_t count         = GetCount();
+    const size_t threadsCount  = std::clamp(count / MIN_BOTS_PER_THREAD, size_t(1), _threadsCount);
+    const size_t botsPerThread = (count + threadsCount - 1) / threadsCount;
+    if (threadsCount == 1)
+    {
+        run(job, 0, count);
+        return;
+    }
+
+    startWorkers(threadsCount - 1);
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _job = job;
+        _job.BotsPerThread = botsPerThread;
+        _job.ThreadsCount  = threadsCount;
+        ++_generation;
+        _pending = _workers.size();
+    }
+    _jobCondition.notify_all();
+
+    // The calling thread simulates the first range
+    run(job, 0, std::min(count, botsPerThread));
+
+    std::unique_lock<std::mutex> lock(_mutex);
+    _doneCondition.wait(lock, [this]() { return _pending == 0; });
+}
+
+bool
+BotSwarm::applyKeys(size_t bot, uint8_t pressed, const std::vector<KeyForce>& keys)
+{
+    // As PhysicsObject::ApplyForce
+    bool jumped = false;
+    for (const KeyForce& key : keys)
+    {
+        if ((pressed & key.Bit) == 0) {
+            continue;
+        }
+        jumped = jumped || key.Bit == KEY_SPACE;
+        switch (key.ForceDirection)
+        {
+            case Physics::Direction::WEST:  _forceX[bot] -= key.Force; break;
+            case Physics::Direction::NORTH: _forceY[bot] -= key.Force; break;
+            case Physics::Direction::EAST:  _forceX[bot] += key.Force; break;
+            case Physics::Direction::SOUTH: _forceY[bot] += key.Force; break;
+        }
+    }
+    return jumped;
+}
+
+void
+BotSwarm::startWorkers(size_t count)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    while (_workers.size() < count) {
+        _workers.emplace_back(&BotSwarm::runWorker, this, _workers.size() + 1, _generation);
+    }
+}
+
+void
+BotSwarm::runWorker(size_t index, uint64_t generation)
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    while (true)
+    {
+        _jobCondition.wait(lock, [this, generation]() { return _quit || _generation != generation; });
+        if (_quit) {
+            return;
+        }
+        generation = _generation;
+        const Job job = _job;
+        lock.unlock();
+
+        // Workers beyond the threads the job needs only report that they are done
+        if (index < job.ThreadsCount)
+        {
+            const size_t begin = std::min(GetCount(), index * job.BotsPerThread);
+            const size_t end   = std::min(GetCount(), begin + job.BotsPerThread);
+            run(job, begin, end);
+        }
+
+        lock.lock();
+        if (--_pending == 0) {
+            _doneCondition.notify_all();
+        }
+    }
+}
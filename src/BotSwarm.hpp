@@ -0,0 +1,180 @@
+#ifndef BOTSWARM_HPP
+#define BOTSWARM_HPP
+
+#include "Camera.hpp"
+#include "Color.hpp"
+#include "Geometry.hpp"
+#include "Heightfield.hpp"
+#include "Input.hpp"
+#include "Physics.hpp"
+#include "RenderQueue.hpp"
+#include "Timetools.hpp"
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+/// Any amount of bot players that share a level with the player, see GameLevel::SetBotsCount. A bot
+/// runs right and jumps when the edge of the block it stands on comes within its lookahead distance.
+/// The bots handle the keys of the states of a PlayerObject and move and collide with the same Motion
+/// functions, so a bot moves exactly like the player does. They do not collide with each other or
+/// with the player, and they do not color the blocks they land on.
+///
+/// The state of the bots is stored as a structure of arrays, one contiguous array per field, and the
+/// input, the physics and the collisions of all bots are handled in batches, without any virtual
+/// calls or allocations. The bots are independent of each other, so every batch is split between
+/// worker threads, which are started by the first batch that needs them and wait for the next one.
+/// In ENDLESS levels the bots must be translated along with the level.
+class BotSwarm
+{
+public:
+    /// @param count     The amount of bots.
+    /// @param moveForce The move force of every bot, the same as the one of the player.
+    /// @param radius    The radius of every bot.
+    /// @param seed      Seeds the start positions and the lookahead distances.
+    /// @param threadsCount The amount of threads used by Step, 0 = the amount of hardware threads.
+    BotSwarm(size_t count, float moveForce, float radius, unsigned int seed, size_t threadsCount = 0);
+    BotSwarm(const BotSwarm& other) = delete;
+    BotSwarm(BotSwarm&& other)      = delete;
+    ~BotSwarm(void);
+
+    /// Returns every bot to where it started.
+    void Reset(void);
+
+    /// Every bot chooses its keys and handles them.
+    void HandleInput(void);
+
+    /// Every bot handles the same keys instead of choosing them.
+    /// @param keys A key bitmask in the format of Replay::GetKeys.
+    void HandleInput(uint8_t keys);
+
+    void Update(const Physics& physics, Dimensions2D boundaries, Timestep dt);
+
+    /// @param terrain The blocks of the level, read by every thread at the same time.
+    void HandleCollisions(const Heightfield& terrain);
+
+    /// Handles the input if handleInput is true, then updates the bots and handles their collisions,
+    /// in one batch.
+    void Step(const Physics& physics, Dimensions2D boundaries, const Heightfield& terrain,
+              Timestep dt, bool handleInput);
+
+    /// Submits the bots within the view of camera, below the player.
+    /// @param it Interpolation timestep for correcting the positions between updates.
+    void Draw(RenderQueue& queue, const Camera& camera, Timestep it, Color color) const;
+
+    /// Moves every bot dx units along the x-axis.
+    void TranslateX(float dx);
+    void SetPosition(size_t bot, Point2DF position);
+
+    size_t   GetCount(void)          const;
+    size_t   GetThreadsCount(void)   const;
+    Point2DF GetPosition(size_t bot) const;
+    Point2DF GetVelocity(size_t bot) const;
+    bool     IsOnGround(size_t bot)  const;
+
+    /// @return The x-coordinate of the rightmost bot.
+    float    GetMaxX(void)           const;
+
+private:
+    enum class State : uint8_t { FALLING = 0, JUMPING, ON_GROUND };
+
+    /// The parts of an update that a batch runs.
+    enum class Phase : uint8_t { INPUT, UPDATE, COLLISIONS, STEP };
+
+    /// A key handled by a state, and the force its command applies.
+    struct KeyForce
+    {
+        uint8_t            Bit; // In the key bitmasks
+        Physics::Direction ForceDirection;
+        float              Force;
+    };
+
+    // Waking a worker costs more than simulating a few hundred bots
+    inline static constexpr size_t MIN_BOTS_PER_THREAD = 512;
+
+    /// The arguments of the batch that the workers are running.
+    struct Job
+    {
+        Phase              JobPhase;
+        const Physics*     StepPhysics;
+        Dimensions2D       Boundaries;
+        const Heightfield* Terrain;
+        double             Dt;
+        bool               WithInput;
+        size_t             BotsPerThread;
+        size_t             ThreadsCount; // The caller included
+    };
+
+    /// @return The keys of the states of a PlayerObject with the forces of their commands.
+    std::vector<KeyForce> createKeyForces(const std::vector<Input::KeyCode>& keys) const;
+
+    void handleInput(size_t begin, size_t end, const uint8_t* keys);
+    void chooseKeys(size_t begin, size_t end);
+    void update(const Physics& physics, Dimensions2D boundaries, Timestep dt, size_t begin, size_t end);
+    void handleCollisions(const Heightfield& terrain, size_t begin, size_t end);
+
+    /// Runs the phase of job for the bots [begin, end).
+    void run(const Job& job, size_t begin, size_t end);
+
+    /// Runs job for every bot, with the bots split evenly between the threads.
+    void dispatch(const Job& job);
+
+    /// Applies the forces of the pressed keys the same way as the commands of an InputComponent do.
+    /// @return true if the jump key was pressed.
+    bool applyKeys(size_t bot, uint8_t pressed, const std::vector<KeyForce>& keys);
+
+    /// Starts workers until there are count of them.
+    void startWorkers(size_t count);
+
+    /// Runs the range of the bots of worker index in every job, until the swarm is destroyed.
+    void runWorker(size_t index, uint64_t generation);
+
+private:
+    float        _moveForce;
+    float        _radius;
+    unsigned int _seed;
+    size_t       _threadsCount;
+
+    // The keys of FallingState, JumpingState and OnGroundState
+    std::vector<KeyForce> _fallingKeys;
+    std::vector<KeyForce> _jumpingKeys;
+    std::vector<KeyForce> _jumpingKeysWithJumps;
+    std::vector<KeyForce> _onGroundKeys;
+
+    // The translation column of the acceleration matrix of a PhysicsObject is the force, and its
+    // diagonal the friction. Only the x and y components change on the XY-plane.
+    std::vector<float>   _positionX;
+    std::vector<float>   _positionY;
+    std::vector<float>   _velocityX;
+    std::vector<float>   _velocityY;
+    std::vector<float>   _frictionX;
+    std::vector<float>   _frictionY;
+    std::vector<float>   _forceX;
+    std::vector<float>   _forceY;
+
+    std::vector<State>   _state;
+    std::vector<uint8_t> _jumpsLeft;   // JUMPING
+    std::vector<float>   _groundY;     // ON_GROUND, the y-coordinate the bot stands on
+    std::vector<float>   _groundBegin; // ON_GROUND, the x-coordinates of the block the bot stands on
+    std::vector<float>   _groundEnd;   // Also kept while in the air, for choosing when to jump
+
+    std::vector<float>   _lookahead;
+    std::vector<uint8_t> _keys;
+
+    // The workers of the batches, the calling thread simulates the first range itself
+    std::vector<std::thread> _workers;
+    std::mutex               _mutex;
+    std::condition_variable  _jobCondition;  // Signaled when a job is posted or the swarm is destroyed
+    std::condition_variable  _doneCondition; // Signaled when the last worker finishes a job
+    Job                      _job;
+    uint64_t                 _generation;    // Incremented for every job
+    size_t                   _pending;       // Workers that have not finished the job yet
+    bool                     _quit;
+
+};
+
+#endif // BOTSWARM_HPP
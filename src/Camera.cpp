@@ -35,6 +35,12 @@ Camera::TrackPosition(const glm::vec4& targetPos, float alpha)
     TrackPosition(glm::vec3(targetPos), alpha);
 }
 
+void
+Camera::TranslateX(float dx)
+{
+    _position.x += dx;
+}
+
 void
 Camera::SetDimensions(Dimensions2D widthHeight)
 {
@@ -71,6 +77,12 @@ Camera::GetCenterPosition(void) const
     };
 }
 
+Point2DF
+Camera::GetCenterPositionF(void) const
+{
+    return { _position.x, _position.y };
+}
+
 Point2D
 Camera::GetTopLeftPosition(void) const { return { GetX(), GetY() }; }
 
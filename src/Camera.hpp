@@ -26,11 +26,15 @@ public:
     /// @param alpha A value in the range [0,1].
     void TrackPosition(const glm::vec3& targetPos, float alpha);
     void TrackPosition(const glm::vec4& targetPos, float alpha);
+
+    /// Moves the camera dx units along the x-axis, used when the world origin is moved.
+    void TranslateX(float dx);
     void SetDimensions(Dimensions2D widthHeight);
 
     Rectangle    TransformRectangle(RectangleF rect) const;
     Point2D      Transform(Point2D screenCoords) const;
     Point2D      GetCenterPosition(void)  const;
+    Point2DF     GetCenterPositionF(void) const;
     Point2D      GetTopLeftPosition(void) const;
     Dimensions2D GetDimensions(void)      const;
     RectangleF   GetRectangleF(void)      const;
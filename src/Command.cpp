@@ -0,0 +1,27 @@
+#include "Command.hpp"
+#include "Motion.hpp"
+
+
+void
+NullCommand::ExecuteMovement([[maybe_unused]] Transform& transform) const
+{
+    // Does nothing, command is not bound to anything.
+}
+
+void
+JumpCommand::ExecuteMovement(Transform& transform) const
+{
+    transform.ApplyForce(Physics::Direction::NORTH, Motion::GetJumpForce(transform.GetMoveForce()));
+}
+
+MoveCommand::MoveCommand(Physics::Direction direction)
+    : _direction(direction)
+{
+    //
+}
+
+void
+MoveCommand::ExecuteMovement(Transform& transform) const
+{
+    transform.ApplyForce(_direction, Motion::GetMoveForce(_direction, transform.GetMoveForce()));
+}
@@ -0,0 +1,50 @@
+#ifndef COMMAND_HPP
+#define COMMAND_HPP
+
+#include "Physics.hpp"
+#include "Transform.hpp"
+
+
+/// Movement commands that are bound to the player input. Every command applies its force to a Transform,
+/// which lets the same commands be executed without any input, for example when simulating jumps.
+class Command
+{
+public:
+    Command(void) = default;
+    Command(const Command& other) = delete;
+    Command(Command&& other)      = delete;
+    virtual ~Command(void) = default;
+    virtual void ExecuteMovement(Transform& transform) const = 0;
+
+private:
+
+};
+
+class NullCommand : public Command
+{
+public:
+    virtual void ExecuteMovement(Transform& transform) const override;
+private:
+
+};
+
+class JumpCommand : public Command
+{
+public:
+    virtual void ExecuteMovement(Transform& transform) const override;
+private:
+
+};
+
+class MoveCommand : public Command
+{
+public:
+    MoveCommand(Physics::Direction direction);
+    virtual void ExecuteMovement(Transform& transform) const override;
+
+private:
+    Physics::Direction _direction;
+
+};
+
+#endif // COMMAND_HPP
@@ -5,6 +5,37 @@ const std::string  Constants::SCREEN_TITLE = "Game Project";
 
 // ( TODO: Implement bg scaling) // Render size width must be of the same size as the width of the used background image, no scaling implemented
 const Dimensions2D Constants::RENDER_SIZE = { 1000, 750 };
+const size_t       Constants::TARGET_FPS  = 60;
+const size_t       Constants::TARGET_UPS  = 120;
+const size_t       Constants::FAST_FORWARD_RENDER_INTERVAL = 60;
+
+namespace Constants::Level
+{
+
+const Dimensions2D ARENA_SIZE         = { 100 * 1280, Constants::RENDER_SIZE.H };
+const float        GRAVITY            = 100.0f;
+const float        FRICTION           = 0.9f;
+const double       INITIAL_TIME       = 300.0;
+const unsigned int SEED               = 1337;
+
+} // end namespace Constants::Level
+
+namespace Constants::Player
+{
+
+const float MOVE_FORCE                = 75.0f;
+const float RADIUS                    = 30.0f;
+
+} // end namespace Constants::Player
+
+namespace Constants::Particles
+{
+
+const size_t CAPACITY                 = 4096;
+const size_t JUMP                     = 24;
+const size_t LANDING                  = 48;
+
+} // end namespace Constants::Particles
 
 namespace Constants::Paths
 {
@@ -15,6 +46,9 @@ const std::string TILESETS            = BASEPATH + "tilesets/";
 const std::string IMAGES              = BASEPATH + "images/";
 const std::string MUSICS              = BASEPATH + "musics/";
 const std::string SOUNDS              = BASEPATH + "sounds/";
+const std::string QUICKSAVE           = "quicksave.bin";
+const std::string REPLAY              = "replay.bin";
+const std::string RECORDING           = "replay.bin.part";
 
 } // end namespace Constants::Paths
 
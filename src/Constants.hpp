@@ -12,6 +12,31 @@ namespace Constants
 {
     extern const std::string  SCREEN_TITLE;
     extern const Dimensions2D RENDER_SIZE;
+    extern const size_t       TARGET_FPS; // Gameloop iterations per second, input is handled once per iteration
+    extern const size_t       TARGET_UPS; // Game state updates per second
+    extern const size_t       FAST_FORWARD_RENDER_INTERVAL; // Updates per rendered frame in fast-forward
+
+    namespace Level
+    {
+        extern const Dimensions2D ARENA_SIZE;   // The size of FIXED levels
+        extern const float        GRAVITY;
+        extern const float        FRICTION;
+        extern const double       INITIAL_TIME; // Seconds
+        extern const unsigned int SEED;         // The seed of the levels played in the game
+    } // end namespace Constants::Level
+
+    namespace Player
+    {
+        extern const float MOVE_FORCE;
+        extern const float RADIUS;
+    } // end namespace Constants::Player
+
+    namespace Particles
+    {
+        extern const size_t CAPACITY; // The most live particles of one emitter
+        extern const size_t JUMP;     // Particles emitted per jump
+        extern const size_t LANDING;  // Particles emitted per landing
+    } // end namespace Constants::Particles
 
     namespace Paths
     {
@@ -21,6 +46,9 @@ namespace Constants
         extern const std::string IMAGES;
         extern const std::string MUSICS;
         extern const std::string SOUNDS;
+        extern const std::string QUICKSAVE; // Written into the working directory
+        extern const std::string REPLAY;    // Written into the working directory
+        extern const std::string RECORDING; // The replay being recorded, renamed to REPLAY when finished
     } // end namespace Constants::Paths
 
     namespace Fonts::TTF
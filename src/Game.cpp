@@ -3,14 +3,17 @@
 #include "Menu.hpp"
 #include "Constants.hpp"
 #include "Mixer.hpp"
+#include "StateSerializer.hpp"
 
+#include <algorithm>
 #include <functional>
 #include <cassert>
+#include <cstdio>
 
 
 Game::Game(Sdl2& sdl, ResourceManager& resourceManager)
-    : _targetFPS(60)
-    , _targetUPS(120)
+    : _targetFPS(Constants::TARGET_FPS)
+    , _targetUPS(Constants::TARGET_UPS)
     , _maxDt(0.2) // Max amount of deltatime to consume per loop iteration
     , _state(State::QUIT)
     , _sdl(sdl)
@@ -19,13 +22,30 @@ Game::Game(Sdl2& sdl, ResourceManager& resourceManager)
     , _callbacks(std::make_shared<ObjectMappedInputCallbacks>())
     , _player(nullptr)
     , _currentLevel(nullptr)
+    , _levelMode(GameLevel::Mode::FIXED)
+    , _saveBuffer()
+    , _recording(nullptr)
+    , _playback(nullptr)
+    , _replayPlayer(nullptr)
+    , _fastForwardInterval(Constants::FAST_FORWARD_RENDER_INTERVAL)
+    , _tasks()
+    , _renderThread(nullptr)
+    , _botsCount(0)
+    , _mainMenu(nullptr)
+    , _settingsMenu(nullptr)
+    , _helpMenu(nullptr)
+    , _pauseMenu(nullptr)
+    , _activeMenu(nullptr)
+    , _helpTextures(TaskScheduler::NULL_TASK)
+    , _settingsTextures(TaskScheduler::NULL_TASK)
+    , _pauseTextures(TaskScheduler::NULL_TASK)
 {
     _sdl.RegisterQuitEventCallback(std::bind(&Game::handleQuitEvent, this));
 
     _sdl.GetInput().RegisterKeyCallback(
         Input::KeyCode::f,
         Input::EventType::KEYDOWN,
-        std::bind(&Renderer::ToggleFullscreen, &sdl.GetRenderer())
+        std::bind(&Game::toggleFullscreen, this)
     );
     _sdl.GetInput().RegisterKeyCallback(
         Input::KeyCode::m,
@@ -35,13 +55,17 @@ Game::Game(Sdl2& sdl, ResourceManager& resourceManager)
 
     _callbacks->AddKeyCallback(Input::KeyCode::p,      std::bind(&Game::setGameState, this, State::PAUSED));
     _callbacks->AddKeyCallback(Input::KeyCode::ESCAPE, std::bind(&Game::setGameState, this, State::PAUSED));
+    _callbacks->AddKeyCallback(Input::KeyCode::NUM_5,  std::bind(&Game::quickSave, this));
+    _callbacks->AddKeyCallback(Input::KeyCode::NUM_9,  std::bind(&Game::quickLoad, this));
+    _callbacks->AddKeyCallback(Input::KeyCode::TAB,    std::bind(&Game::toggleFastForward, this));
 
+    createMenus();
     loadMainMenu();
 }
 
 Game::~Game(void)
 {
-    //
+    _renderThread.reset(); // Presents the frame in flight before the level is destroyed
 }
 
 void
@@ -66,6 +90,73 @@ Game::Run(void)
                 break;
         }
     }
+
+    saveReplay();
+}
+
+bool
+Game::LoadReplay(const std::string& filepath, double startSeconds)
+{
+    std::unique_ptr<Replay> replay = Replay::Open(filepath);
+    if (replay == nullptr) {
+        return false;
+    }
+
+    createLevel(replay->GetMode(), replay->GetSeed());
+    _playback     = std::move(replay);
+    _replayPlayer = std::make_unique<ReplayPlayer>(*_playback, *_currentLevel, _sdl.GetInput());
+
+    const size_t startUpdate = static_cast<size_t>(std::max(startSeconds, 0.0) * static_cast<double>(Constants::TARGET_UPS));
+    Timer timer(false);
+    if (!_replayPlayer->Seek(startUpdate, _glt.GetUpdateDeltaTime())) {
+        return false;
+    }
+    Logger::Info("Playing \"{}\" from the update {} of {}, seeked in {}us", filepath,
+        _replayPlayer->GetUpdate(), _playback->GetUpdatesCount(), timer.Elapsed<std::chrono::microseconds>());
+
+    setGameState(State::RUNNING);
+    return true;
+}
+
+void
+Game::SetFastForward(size_t renderInterval)
+{
+    _fastForwardInterval = renderInterval;
+    // Without rendering the events are still polled once per simulated second
+    _glt.SetFastForward(renderInterval > 0 ? renderInterval : _targetUPS);
+    if (renderInterval > 0) {
+        Logger::Info("Fast-forward ON, rendering every {} updates", renderInterval);
+    } else {
+        Logger::Info("Fast-forward ON, rendering disabled");
+    }
+}
+
+void
+Game::SetRenderThread(bool enabled)
+{
+    if (enabled == (_renderThread != nullptr)) {
+        return;
+    }
+    // SDL renderers must be used from the thread that created them, only the OpenGL context can be handed over
+    if (enabled && !_sdl.GetRenderer().IsOpenGL())
+    {
+        Logger::Critical("The \"{}\" renderer cannot present from another thread, render thread stays OFF",
+                         _sdl.GetRenderer().GetName());
+        return;
+    }
+    _renderThread = enabled ? std::make_unique<RenderThread>(_sdl.GetRenderer(), Constants::Colors::BLACK) : nullptr;
+    Logger::Info("Render thread {}", enabled ? "ON" : "OFF");
+}
+
+void
+Game::SetBotsCount(size_t count)
+{
+    _botsCount = count;
+    if (_currentLevel != nullptr)
+    {
+        waitForFrame(); // The frame in flight draws the current bots
+        _currentLevel->SetBotsCount(count);
+    }
 }
 
 // PRIVATE methods
@@ -79,6 +170,10 @@ Game::setGameState(State state)
 void
 Game::loadMainMenu(void)
 {
+    saveReplay();
+    _replayPlayer.reset();
+    _playback.reset();
+
     _sdl.GetMixer().SetMusic(Constants::Musics::GROOVY_BOOTY);
     _sdl.GetMixer().SetMusicVolume(1.0);
     _sdl.GetMixer().PlayMusicFadeIn(2000);
@@ -87,127 +182,286 @@ Game::loadMainMenu(void)
 }
 
 void
-Game::loadLevel(void)
+Game::loadLevel(GameLevel::Mode mode)
+{
+    createLevel(mode, Constants::Level::SEED);
+    _recording = std::make_unique<ReplayRecorder>(*_currentLevel, Constants::Paths::RECORDING);
+
+    setGameState(State::RUNNING);
+}
+
+void
+Game::createLevel(GameLevel::Mode mode, unsigned int seed)
 {
+    waitForFrame(); // The frame in flight draws the textures of the current level
+    // Both refer to the current level
+    saveReplay();
+    _replayPlayer.reset();
+
     _sdl.GetMixer().SetMusic(Constants::Musics::BEATS_D);
     _sdl.GetMixer().SetMusicVolume(0.5);
     _sdl.GetMixer().PlayMusicFadeIn(2000);
 
     int levelNumber = 1;
-    Dimensions2D levelDimensions = { 100 * 1280, Constants::RENDER_SIZE.H };
-    float gravity  = 100.0f;
-    float friction = 0.9f;
-    double initialTime = 300.0;
 
     _player = GameObject::CreatePlayer(
         _sdl.GetInput(),
         75.0f, // xPos
         75.0f, // yPos
-        75.0f, // standard speed
-        30.0f,  // radius
-        _resMgr.GetSound(Constants::Sounds::JUMP),
+        Constants::Player::MOVE_FORCE,
+        Constants::Player::RADIUS,
+        &_resMgr.GetSound(Constants::Sounds::JUMP),
         Constants::Colors::LIGHT
     );
+    _levelMode    = mode;
     _currentLevel = GameLevel::CreateLevel(
-        _sdl, _resMgr, levelNumber, levelDimensions, Constants::Tilesets::FPT::BG,
-        gravity, friction, initialTime, _player.get()
+        _sdl, _resMgr, _levelMode, seed, levelNumber,
+        Constants::Level::ARENA_SIZE, Constants::Tilesets::FPT::BG,
+        Constants::Level::GRAVITY, Constants::Level::FRICTION, Constants::Level::INITIAL_TIME,
+        _player.get()
     );
+    _currentLevel->SetBotsCount(_botsCount);
+}
+
+void
+Game::restartLevel(void)
+{
+    assert(_currentLevel != nullptr);
+    _currentLevel->Restart();
+
+    // Both the playback and the recording start over along with the level
+    if (_replayPlayer != nullptr) {
+        _replayPlayer = std::make_unique<ReplayPlayer>(*_playback, *_currentLevel, _sdl.GetInput());
+    } else {
+        saveReplay();
+        _recording = std::make_unique<ReplayRecorder>(*_currentLevel, Constants::Paths::RECORDING);
+    }
 
     setGameState(State::RUNNING);
 }
 
+void
+Game::quickSave(void)
+{
+    assert(_currentLevel != nullptr);
+    _currentLevel->SaveState(_saveBuffer);
+
+    if (StateWriter::WriteFile(Constants::Paths::QUICKSAVE, _saveBuffer)) {
+        Logger::Info("Saved {} bytes to \"{}\"", _saveBuffer.size(), Constants::Paths::QUICKSAVE);
+    }
+}
+
+void
+Game::quickLoad(void)
+{
+    assert(_currentLevel != nullptr);
+    if (_replayPlayer != nullptr) {
+        return; // A replay can only be played from the start of the level
+    }
+
+    if (StateReader::ReadFile(Constants::Paths::QUICKSAVE, _saveBuffer) && _currentLevel->LoadState(_saveBuffer))
+    {
+        Logger::Info("Loaded \"{}\"", Constants::Paths::QUICKSAVE);
+        // The recording can not continue from another state
+        saveReplay();
+    }
+}
+
+void
+Game::toggleFastForward(void)
+{
+    if (!_glt.IsFastForward()) {
+        SetFastForward(_fastForwardInterval);
+        return;
+    }
+
+    Logger::Info("Fast-forward OFF, ran at {:.1f} simulated seconds per second", _glt.GetFastForwardSpeed());
+    _glt.SetFastForward(0);
+}
+
+void
+Game::toggleFullscreen(void)
+{
+    waitForFrame();
+    _sdl.GetRenderer().ToggleFullscreen();
+}
+
+void
+Game::waitForFrame(void)
+{
+    if (_renderThread != nullptr) {
+        _renderThread->Wait();
+    }
+}
+
+void
+Game::saveReplay(void)
+{
+    if (_recording == nullptr) {
+        return;
+    }
+
+    const size_t updatesCount = _recording->GetUpdatesCount();
+    const bool   written      = _recording->Finish();
+    _recording.reset();
+
+    // An empty recording does not replace the previous replay
+    if (!written || updatesCount == 0) {
+        std::remove(Constants::Paths::RECORDING.c_str());
+        return;
+    }
+
+    std::remove(Constants::Paths::REPLAY.c_str());
+    if (std::rename(Constants::Paths::RECORDING.c_str(), Constants::Paths::REPLAY.c_str()) != 0) {
+        Logger::Critical("Unable to rename \"{}\" to \"{}\"", Constants::Paths::RECORDING, Constants::Paths::REPLAY);
+        return;
+    }
+    Logger::Info("Replay of {} updates written to \"{}\"", updatesCount, Constants::Paths::REPLAY);
+}
+
 void
 Game::handleQuitEvent(void)
 {
     setGameState(State::QUIT);
 }
 
-void
-Game::handleMenu(void)
+bool
+Game::waitMenuEvents(bool redraw, MenuClock::time_point nextFrame)
 {
-    assert(_state == State::MENU);
+    int timeoutMs = MENU_IDLE_TIMEOUT_MS;
+    if (redraw || _tasks.GetPendingCount() > 0)
+    {
+        const auto untilFrame = std::chrono::ceil<std::chrono::milliseconds>(nextFrame - MenuClock::now());
+        timeoutMs = static_cast<int>(std::max<int64_t>(0, untilFrame.count()));
+    }
+    return _sdl.WaitEvents(timeoutMs);
+}
 
-    Input& input               = _sdl.GetInput();
-    const Renderer& renderer   = _sdl.GetRenderer();
-    const Font& fontTitle      = _resMgr.GetFont(Constants::Fonts::TTF::PERMANENTMARKER, 128);
-    const Font& fontLabels     = _resMgr.GetFont(Constants::Fonts::TTF::PERMANENTMARKER, 64);
-    const Font& helpFontTitle  = _resMgr.GetFont(Constants::Fonts::TTF::PERMANENTMARKER, 64);
-    const Font& helpFontLabels = _resMgr.GetFont(Constants::Fonts::TTF::PERMANENTMARKER, 32);
-    Menu mainMenu(
+void
+Game::createMenus(void)
+{
+    const Renderer& renderer    = _sdl.GetRenderer();
+    const Font& fontTitle       = _resMgr.GetFont(Constants::Fonts::TTF::PERMANENTMARKER, 128);
+    const Font& fontLabels      = _resMgr.GetFont(Constants::Fonts::TTF::PERMANENTMARKER, 64);
+    const Font& helpFontTitle   = _resMgr.GetFont(Constants::Fonts::TTF::PERMANENTMARKER, 64);
+    const Font& helpFontLabels  = _resMgr.GetFont(Constants::Fonts::TTF::PERMANENTMARKER, 32);
+    const Font& pauseFontTitle  = _resMgr.GetFont(Constants::Fonts::TTF::RUBIKBUBBLES, 128);
+    const Font& pauseFontLabels = _resMgr.GetFont(Constants::Fonts::TTF::RUBIKBUBBLES, 64);
+
+    _mainMenu = std::make_unique<Menu>(
         fontTitle, Color::WithAlpha(Constants::Colors::LIGHT, 180),
         fontLabels, Color::WithAlpha(Constants::Colors::LIGHTEST, 150),
         _resMgr.GetImage(Constants::Images::PIXNIO_DARK_BLUERED),
         "Main menu"
     );
 
-    Menu settingsMenu(
+    _settingsMenu = std::make_unique<Menu>(
         fontTitle, Color::WithAlpha(Constants::Colors::LIGHT, 180),
         fontLabels, Color::WithAlpha(Constants::Colors::LIGHTEST, 150),
         _resMgr.GetImage(Constants::Images::PIXNIO_BLUE),
         "Settings"
     );
 
-    Menu helpMenu(
+    _helpMenu = std::make_unique<Menu>(
         helpFontTitle, Constants::Colors::LIGHT,
         helpFontLabels, Constants::Colors::LIGHTEST,
         _resMgr.GetImage(Constants::Images::PIXNIO_DARK_BLUERED),
         "Stay on top of life.."
     );
 
-    Menu* activeMenu = &mainMenu;
+    _pauseMenu = std::make_unique<Menu>(
+        pauseFontTitle, Color::WithAlpha(Constants::Colors::RED, 180),
+        pauseFontLabels, Color::WithAlpha(Constants::Colors::RED, 150),
+        _resMgr.GetImage(Constants::Images::PIXNIO_RED),
+        "Game Paused !"
+    );
 
-    mainMenu.AddLabel("New Game", std::bind(&Game::loadLevel, this));
-    mainMenu.AddLabel("Settings", [&activeMenu, &settingsMenu, &input](){
-        activeMenu = &settingsMenu;
-        settingsMenu.ActivateCallbacks(input);
+    _mainMenu->AddLabel("New Game", std::bind(&Game::loadLevel, this, GameLevel::Mode::FIXED));
+    _mainMenu->AddLabel("Endless", std::bind(&Game::loadLevel, this, GameLevel::Mode::ENDLESS));
+    _mainMenu->AddLabel("Settings", [this](){
+        _tasks.Finish(_settingsTextures);
+        _activeMenu = _settingsMenu.get();
+        _settingsMenu->ActivateCallbacks(_sdl.GetInput());
     });
-    mainMenu.AddLabel("Help", [&activeMenu, &helpMenu, &input](){
-        activeMenu = &helpMenu;
-        helpMenu.ActivateCallbacks(input);
+    _mainMenu->AddLabel("Help", [this](){
+        _tasks.Finish(_helpTextures);
+        _activeMenu = _helpMenu.get();
+        _helpMenu->ActivateCallbacks(_sdl.GetInput());
     });
-    mainMenu.AddLabel("Quit", std::bind(&Game::handleQuitEvent, this));
-    mainMenu.ActivateCallbacks(input);
-
-    helpMenu.AddLabel("..And make sure to never fall!");
-    helpMenu.AddLabel("Inputs:");
-    helpMenu.AddLabel("P|ESC => pause");
-    helpMenu.AddLabel("C|V => toggle VSYNC");
-    helpMenu.AddLabel("M => Mute music");
-    helpMenu.AddLabel("SPACE => Jump");
-    helpMenu.AddLabel("Arrow keys for moving!");
-    helpMenu.AddLabel("Enjoy (Back)!", [&activeMenu, &mainMenu, &input]() {
-        activeMenu = &mainMenu;
-        mainMenu.ActivateCallbacks(input);
+    _mainMenu->AddLabel("Quit", std::bind(&Game::handleQuitEvent, this));
+
+    _helpMenu->AddLabel("..And make sure to never fall!");
+    _helpMenu->AddLabel("Inputs:");
+    _helpMenu->AddLabel("P|ESC => pause");
+    _helpMenu->AddLabel("C|V => toggle VSYNC");
+    _helpMenu->AddLabel("M => Mute music");
+    _helpMenu->AddLabel("SPACE => Jump");
+    _helpMenu->AddLabel("Arrow keys for moving!");
+    _helpMenu->AddLabel("Enjoy (Back)!", [this]() {
+        _activeMenu = _mainMenu.get();
+        _mainMenu->ActivateCallbacks(_sdl.GetInput());
     });
 
-    settingsMenu.AddLabel("Keys (NOT implemented)");
-    settingsMenu.AddLabel("Gfxs (NOT implemented)");
-    settingsMenu.AddLabel("Back", [&activeMenu, &mainMenu, &input]() {
-        activeMenu = &mainMenu;
-        mainMenu.ActivateCallbacks(input);
+    _settingsMenu->AddLabel("Keys (NOT implemented)");
+    _settingsMenu->AddLabel("Gfxs (NOT implemented)");
+    _settingsMenu->AddLabel("Back", [this]() {
+        _activeMenu = _mainMenu.get();
+        _mainMenu->ActivateCallbacks(_sdl.GetInput());
     });
 
-    mainMenu.UpdateTextures(renderer);
-    helpMenu.UpdateTextures(renderer);
-    settingsMenu.UpdateTextures(renderer);
+    _pauseMenu->AddLabel("Continue", std::bind(&Game::setGameState, this, State::RUNNING));
+    _pauseMenu->AddLabel("Restart", std::bind(&Game::restartLevel, this));
+    _pauseMenu->AddLabel("Quit game", std::bind(&Game::loadMainMenu, this));
+
+    // Only the main menu is shown right away, the others are rasterized during its first frames
+    _mainMenu->UpdateTextures(renderer);
+    _helpTextures     = _tasks.Add("Help menu textures", _helpMenu->UpdateTexturesTask(renderer));
+    _settingsTextures = _tasks.Add("Settings menu textures", _settingsMenu->UpdateTexturesTask(renderer));
+    _pauseTextures    = _tasks.Add("Pause menu textures", _pauseMenu->UpdateTexturesTask(renderer));
+}
+
+void
+Game::handleMenu(void)
+{
+    assert(_state == State::MENU);
+
+    Input& input             = _sdl.GetInput();
+    const Renderer& renderer = _sdl.GetRenderer();
+    Timer entryTimer(false);
+
+    _activeMenu = _mainMenu.get();
+    _mainMenu->ActivateCallbacks(input);
+
+    // The menu is only drawn again when an event may have changed it, at most at the target FPS
+    const MenuClock::duration framePeriod = std::chrono::microseconds(1000000 / _targetFPS);
+    MenuClock::time_point     nextFrame   = MenuClock::now();
+    bool                      redraw      = true;
+    bool                      entered     = false;
 
     while (_state == State::MENU)
     {
-        _mousePos = _sdl.PollEvents();
-        if (input.IsPressed(Input::KeyCode::DOWN)) {
-            //activeMenu->MoveSelection(Menu::SelectionDirectory::DOWN);
-            activeMenu->UpdateTextures(renderer);
-        }
-        else if (input.IsPressed(Input::KeyCode::UP)) {
-            //activeMenu->MoveSelection(Menu::SelectionDirectory::UP);
-            activeMenu->UpdateTextures(renderer);
-        }
-        // else if (input.IsPressed(Input::KeyCode::RETURN)) {
-        //    activeMenu->ActivateSelection();
-        //}
+        redraw    = waitMenuEvents(redraw, nextFrame) || redraw;
+        _mousePos = input.GetMousePos();
 
-        activeMenu->Render(renderer);
-        renderer.RenderPresent(true); // Clears the swapped buffer
+        if (redraw && MenuClock::now() >= nextFrame)
+        {
+            // The selection is moved by the callbacks of the menu, which switches between the textures
+            // of the labels. This only centres the labels again if the window has been resized.
+            _activeMenu->UpdateTextures(renderer);
+            _activeMenu->Render(renderer);
+            renderer.RenderPresent(true); // Clears the swapped buffer
+            nextFrame = MenuClock::now() + framePeriod;
+            redraw    = false;
+
+            if (!entered)
+            {
+                Logger::Debug("Main menu shown {} us after entering it, the frame period is {} us",
+                              entryTimer.Elapsed<std::chrono::microseconds>(),
+                              std::chrono::duration_cast<std::chrono::microseconds>(framePeriod).count());
+                entered = true;
+            }
+        }
+        _tasks.RunFrame(TaskScheduler::DEFAULT_BUDGET);
     }
 }
 
@@ -221,6 +475,7 @@ Game::handleGame(void)
 
     static TimeEstimate sleepEst(0.003, 0.003);
     //Sound& sndJump = _resMgr.GetSound(Constants::Sounds::JUMP);
+    Timer fastForwardReport(false);
 
     _glt.ResetFields();
     while (_state == State::RUNNING)
@@ -229,9 +484,19 @@ Game::handleGame(void)
 
         _glt.InitIteration();
 
+        // SDL's renderer reacts to the window events while they are pumped, resizing its viewport,
+        // so the frame in flight must have been presented. The renderer is ours until the Submit below.
+        IF_LOG_TIME(waitForFrame(), "Wait for frame");
         _mousePos = _sdl.PollEvents();
+        const RenderThread::Clock::time_point inputTime = RenderThread::Clock::now();
 
-        IF_LOG_TIME(_currentLevel->HandleInput(), "Input handling");
+        if (_replayPlayer == nullptr)
+        {
+            IF_LOG_TIME(_currentLevel->HandleInput(), "Input handling");
+            if (_recording != nullptr) {
+                _recording->RecordInput(input);
+            }
+        }
 
         if (input.IsPressed(Input::KeyCode::v)) {
             _sdl.GetRenderer().SetVsync(true);
@@ -247,21 +512,69 @@ Game::handleGame(void)
         //    ball->UpdateRadius(1.0f/1.1f);
         //}
 
-        while (_glt.ShouldDoUpdates()) {
+        while (_glt.ShouldDoUpdates())
+        {
+            if (_replayPlayer != nullptr) { // The replay handles the input at the recorded updates
+                IF_LOG_TIME(_replayPlayer->PlayUpdate(_glt.GetUpdateDeltaTime()), "Replay updates");
+                continue;
+            }
+
             IF_LOG_TIME(_currentLevel->Update(_glt.GetUpdateDeltaTime()), "Physic updates");
             IF_LOG_TIME(_currentLevel->HandleCollisions(), "Handle collisions");
+            if (_recording != nullptr) {
+                _recording->RecordUpdate();
+            }
         }
 
-        IF_LOG_TIME(_currentLevel->Draw(_sdl.GetRenderer(), _glt.GetLag()), "Draw to target");
-
-        IF_LOG_TIME(
-            _sdl.GetRenderer().SetRenderDrawColor({ Constants::Colors::BLACK });
-            _sdl.GetRenderer().RenderPresent(true), "Rendering trgt" // Clears the back buffer with the current color
-        );
+        if (_renderThread != nullptr && (!_glt.IsFastForward() || _fastForwardInterval > 0))
+        {
+            if (_currentLevel->NeedsBaking(_sdl.GetRenderer())) {
+                _currentLevel->Bake(_sdl.GetRenderer());
+            }
+            IF_LOG_TIME(_currentLevel->Record(_renderThread->GetRecordQueue(), _glt.GetLag()), "Record frame");
+            IF_LOG_TIME(_renderThread->Submit(inputTime), "Submit frame");
+            IF_LOG_VALUE(_renderThread->GetFrameStats().PresentUs, "Last present");
+            IF_LOG_VALUE(_renderThread->GetFrameStats().LatencyUs, "Last input latency");
+        }
+        else if (!_glt.IsFastForward() || _fastForwardInterval > 0)
+        {
+            IF_LOG_TIME(_currentLevel->Draw(_sdl.GetRenderer(), _glt.GetLag()), "Draw to target");
+
+            IF_LOG_TIME(
+                _sdl.GetRenderer().SetRenderDrawColor({ Constants::Colors::BLACK });
+                _sdl.GetRenderer().RenderPresent(true), "Rendering trgt" // Clears the back buffer with the current color
+            );
+            IF_LOG_VALUE(_currentLevel->GetRenderStats().Commands, "Draw commands");
+            IF_LOG_VALUE(_currentLevel->GetRenderStats().StateChanges, "State changes");
+            IF_LOG_VALUE(_sdl.GetRenderer().GetFrameDrawCalls(), "Draw calls");
+        }
 
-        IF_LOG_TIME(thread::PreciseSleep(_glt.GetSleeptime(), sleepEst), "Slept for");
+        if (!_glt.IsFastForward())
+        {
+            // The tasks only get the time the loop would otherwise sleep
+            const auto slack = std::chrono::duration_cast<TaskScheduler::Microseconds>(
+                std::chrono::duration<double>(_glt.GetSleeptime().GetSeconds()));
+            if (_tasks.GetPendingCount() > 0) {
+                waitForFrame(); // The tasks create and upload textures
+                IF_LOG_TIME(_tasks.RunFrame(slack), "Background tasks");
+            }
+            IF_LOG_TIME(thread::PreciseSleep(_glt.GetSleeptime(), sleepEst), "Slept for");
+        }
+        else if (fastForwardReport.Elapsed<std::chrono::milliseconds>() >= 1000)
+        {
+            Logger::Info("Fast-forward: {:.1f} simulated seconds per second", _glt.GetFastForwardSpeed());
+            fastForwardReport.Reset();
+        }
         IF_LOG_TOTAL();
+
+        if (_replayPlayer != nullptr && _replayPlayer->IsFinished())
+        {
+            Logger::Info("Replay finished, score {}", _currentLevel->GetScore());
+            loadMainMenu();
+        }
     }
+
+    waitForFrame(); // The menus draw on this thread
 }
 
 void
@@ -271,39 +584,40 @@ Game::handlePaused(void)
 
     Input& input             = _sdl.GetInput();
     const Renderer& renderer = _sdl.GetRenderer();
-    const Font& fontTitle    = _resMgr.GetFont(Constants::Fonts::TTF::RUBIKBUBBLES, 128);
-    const Font& fontLabels   = _resMgr.GetFont(Constants::Fonts::TTF::RUBIKBUBBLES, 64);
+    Timer entryTimer(false);
 
-    Menu pauseMenu(
-        fontTitle, Color::WithAlpha(Constants::Colors::RED, 180),
-        fontLabels, Color::WithAlpha(Constants::Colors::RED, 150),
-        _resMgr.GetImage(Constants::Images::PIXNIO_RED),
-        "Game Paused !"
-    );
+    // Usually rasterized long before, in the frames of the main menu
+    _tasks.Finish(_pauseTextures);
+    _pauseMenu->ResetSelection();
+    _pauseMenu->ActivateCallbacks(input);
 
-    pauseMenu.AddLabel("Continue", std::bind(&Game::setGameState, this, State::RUNNING));
-    pauseMenu.AddLabel("Restart", std::bind(&Game::loadLevel, this));
-    pauseMenu.AddLabel("Quit game", std::bind(&Game::loadMainMenu, this));
-    pauseMenu.UpdateTextures(renderer);
+    const MenuClock::duration framePeriod = std::chrono::microseconds(1000000 / _targetFPS);
+    MenuClock::time_point     nextFrame   = MenuClock::now();
+    bool                      redraw      = true;
+    bool                      entered     = false;
 
     while (_state == State::PAUSED)
     {
-        _mousePos = _sdl.PollEvents();
-        if (input.IsPressed(Input::KeyCode::DOWN))
-        {
-            pauseMenu.MoveSelection(Menu::SelectionDirectory::DOWN);
-            pauseMenu.UpdateTextures(renderer);
-        }
-        else if (input.IsPressed(Input::KeyCode::UP))
+        // The selection is moved by the callbacks of the menu, once per key press and key repeat
+        redraw    = waitMenuEvents(redraw, nextFrame) || redraw;
+        _mousePos = input.GetMousePos();
+
+        if (redraw && _state == State::PAUSED && MenuClock::now() >= nextFrame)
         {
-            pauseMenu.MoveSelection(Menu::SelectionDirectory::UP);
-            pauseMenu.UpdateTextures(renderer);
+            _pauseMenu->UpdateTextures(renderer);
+            _pauseMenu->Render(renderer);
+            renderer.RenderPresent(true); // Clears the swapped buffer
+            nextFrame = MenuClock::now() + framePeriod;
+            redraw    = false;
+
+            if (!entered)
+            {
+                Logger::Debug("Pause menu shown {} us after entering it, the frame period is {} us",
+                              entryTimer.Elapsed<std::chrono::microseconds>(),
+                              std::chrono::duration_cast<std::chrono::microseconds>(framePeriod).count());
+                entered = true;
+            }
         }
-        else if (input.IsPressed(Input::KeyCode::RETURN)) {
-            pauseMenu.ActivateSelection();
-        }
-
-        pauseMenu.Render(renderer);
-        renderer.RenderPresent(true); // Clears the swapped buffer
+        _tasks.RunFrame(TaskScheduler::DEFAULT_BUDGET);
     }
 }
@@ -8,13 +8,22 @@
 #include "GameLevel.hpp"
 #include "Timetools.hpp"
 #include "Input.hpp"
+#include "Menu.hpp"
+#include "RenderThread.hpp"
+#include "Replay.hpp"
+#include "TaskScheduler.hpp"
 
+#include <chrono>
+#include <cstdint>
 #include <memory>
+#include <string>
+#include <vector>
 
 // TODO: Move definition into cmake scripts
 //#define LOG_LOOP
 
-// If defined, time and log all IF_LOG_TIME wrapped function calls, otherwise exec them normally
+// If defined, time and log all IF_LOG_TIME wrapped function calls and log the IF_LOG_VALUE values,
+// otherwise exec them normally
 #ifdef LOG_LOOP
     #define IF_LOG_INIT() Timer t(false);                                                   \
                           Logger::Critical("Gameloop timing, all times in miscroseconds:"); \
@@ -26,11 +35,13 @@
         totalTime += currentTime;                             \
         Logger::Info(MSG " : {}", currentTime);               \
         currentTime = 0
+    #define IF_LOG_VALUE(value, MSG) Logger::Info(MSG " : {}", value)
     #define IF_LOG_TOTAL() Logger::Info("Total time: {}!\n", totalTime)
 #else
-    #define IF_LOG_INIT()          void(0)
-    #define IF_LOG_TIME(cmds, MSG) cmds
-    #define IF_LOG_TOTAL()         void(0)
+    #define IF_LOG_INIT()            void(0)
+    #define IF_LOG_TIME(cmds, MSG)   cmds
+    #define IF_LOG_VALUE(value, MSG) void(0)
+    #define IF_LOG_TOTAL()           void(0)
 #endif
 
 
@@ -44,13 +55,58 @@ public:
 
     void Run(void);
 
+    /// Starts playing a recorded replay instead of the main menu.
+    /// @param startSeconds The game time to start playing the replay from.
+    /// @return false if the file is not a valid replay.
+    bool LoadReplay(const std::string& filepath, double startSeconds = 0.0);
+
+    /// Runs the levels as fast as possible instead of in real time, until toggled off with the TAB key.
+    /// @param renderInterval The amount of updates per rendered frame, 0 renders nothing.
+    void SetFastForward(size_t renderInterval);
+
+    /// Presents the frames of the levels on a render thread, so that the next frame is simulated
+    /// while the last one is presented. The menus are always drawn on the calling thread.
+    /// Only the OpenGL renderers support this, with the other ones the render thread stays off.
+    void SetRenderThread(bool enabled);
+
+    /// Adds count bot players to the current level and to every level created from now on, see
+    /// GameLevel::SetBotsCount.
+    void SetBotsCount(size_t count);
+
 private:
     enum class State { QUIT, MENU, RUNNING, PAUSED };
 
+    using MenuClock = std::chrono::steady_clock;
+
+    // The longest a menu waits for an event when it has nothing to do, so that it never blocks for good
+    inline static constexpr int MENU_IDLE_TIMEOUT_MS = 250;
+
     void setGameState(State state);
     void loadMainMenu(void);
-    void loadLevel(void);
+    void loadLevel(GameLevel::Mode mode);
+    void createLevel(GameLevel::Mode mode, unsigned int seed);
+    void restartLevel(void);
+    void quickSave(void);
+    void quickLoad(void);
+    void toggleFastForward(void);
+    void toggleFullscreen(void);
+
+    /// Blocks until the render thread has presented the frame in flight, if there is one. Must be
+    /// called before using the renderer, or destroying anything drawn, while playing a level.
+    void waitForFrame(void);
+
+    /// Finishes the recording of the current level into the replay file.
+    void saveReplay(void);
     void handleQuitEvent(void);
+
+    /// Builds the menus, which are kept for the lifetime of the game and only activated when entered.
+    void createMenus(void);
+
+    /// Waits for the events of a menu. While a frame must be drawn or a task is pending, the wait ends
+    /// when the next frame is due, otherwise when an event arrives or after MENU_IDLE_TIMEOUT_MS.
+    /// @param redraw true if the menu has changed since it was last drawn.
+    /// @return true if an event arrived.
+    bool waitMenuEvents(bool redraw, MenuClock::time_point nextFrame);
     void handleMenu(void);
     void handleGame(void);
     void handlePaused(void);
@@ -65,8 +121,25 @@ private:
     Point2D          _mousePos;
     std::shared_ptr<ObjectMappedInputCallbacks> _callbacks;
 
-    std::unique_ptr<PlayerObject> _player;
-    std::unique_ptr<GameLevel>    _currentLevel;
+    std::unique_ptr<PlayerObject>   _player;
+    std::unique_ptr<GameLevel>      _currentLevel;
+    GameLevel::Mode                 _levelMode;
+    std::vector<uint8_t>            _saveBuffer;   // Reused by every save and load
+    std::unique_ptr<ReplayRecorder> _recording;    // The current level is recorded when not nullptr
+    std::unique_ptr<Replay>         _playback;
+    std::unique_ptr<ReplayPlayer>   _replayPlayer; // The current level plays _playback when not nullptr
+    size_t                          _fastForwardInterval; // Updates per rendered frame in fast-forward
+    TaskScheduler                   _tasks;        // Work spread across the frames of the loops
+    std::unique_ptr<RenderThread>   _renderThread; // Presents the frames of the levels when not nullptr
+    size_t                          _botsCount;    // Of every new level
+
+    // Built once, so that entering a menu does not rasterize its texts again
+    std::unique_ptr<Menu> _mainMenu;
+    std::unique_ptr<Menu> _settingsMenu;
+    std::unique_ptr<Menu> _helpMenu;
+    std::unique_ptr<Menu> _pauseMenu;
+    Menu*                 _activeMenu; // The main menu or one of its submenus
+    TaskScheduler::TaskId _helpTextures, _settingsTextures, _pauseTextures;
 
 };
 
@@ -1,48 +1,239 @@
 #include "GameLevel.hpp"
 #include "Logger.hpp"
-#include "Helpers.hpp"
 
+#include <algorithm>
+#include <array>
 #include <cassert>
+#include <cmath>
+#include <cstring>
+#include <utility>
+
+
+namespace
+{
+    constexpr uint32_t STATE_MAGIC       = 0x4750'5356; // "GPSV"
+    constexpr size_t   STATE_HEADER_SIZE = 3 * sizeof(uint32_t);
+    constexpr size_t   RECTANGLE_SIZE    = 4 * sizeof(float);
+    constexpr size_t   OBJECT_SIZE       = 24 * sizeof(float)                     // Transform
+                                         + sizeof(uint8_t) + sizeof(uint32_t) + 3 * sizeof(float) // State
+                                         + sizeof(uint32_t);                      // Color
+
+    void writeVec4(StateWriter& writer, const glm::vec4& v)
+    {
+        writer.Write(v.x);
+        writer.Write(v.y);
+        writer.Write(v.z);
+        writer.Write(v.w);
+    }
+
+    void readVec4(StateReader& reader, glm::vec4& v)
+    {
+        reader.Read(v.x);
+        reader.Read(v.y);
+        reader.Read(v.z);
+        reader.Read(v.w);
+    }
+
+    void writeRectangle(StateWriter& writer, const RectangleF& rect)
+    {
+        writer.Write(rect.X);
+        writer.Write(rect.Y);
+        writer.Write(rect.W);
+        writer.Write(rect.H);
+    }
+
+    void readRectangle(StateReader& reader, RectangleF& rect)
+    {
+        reader.Read(rect.X);
+        reader.Read(rect.Y);
+        reader.Read(rect.W);
+        reader.Read(rect.H);
+    }
+
+    void writeObject(StateWriter& writer, const GameObject::Snapshot& snapshot)
+    {
+        writeVec4(writer, snapshot.Transform.Position);
+        writeVec4(writer, snapshot.Transform.Velocity);
+        writeVec4(writer, snapshot.Transform.Acceleration[0]);
+        writeVec4(writer, snapshot.Transform.Acceleration[1]);
+        writeVec4(writer, snapshot.Transform.Acceleration[2]);
+        writeVec4(writer, snapshot.Transform.Acceleration[3]);
+
+        writer.Write(static_cast<uint8_t>(snapshot.State.State));
+        writer.Write(static_cast<uint32_t>(snapshot.State.JumpsLeft));
+        writer.Write(snapshot.State.YBound);
+        writer.Write(snapshot.State.XBound);
+        writer.Write(snapshot.State.XWidth);
+
+        writer.Write(Color::ToUint32_t(snapshot.ObjectColor));
+    }
+
+    bool readObject(StateReader& reader, GameObject::Snapshot& snapshot)
+    {
+        readVec4(reader, snapshot.Transform.Position);
+        readVec4(reader, snapshot.Transform.Velocity);
+        readVec4(reader, snapshot.Transform.Acceleration[0]);
+        readVec4(reader, snapshot.Transform.Acceleration[1]);
+        readVec4(reader, snapshot.Transform.Acceleration[2]);
+        readVec4(reader, snapshot.Transform.Acceleration[3]);
+
+        uint8_t  state     = 0;
+        uint32_t jumpsLeft = 0;
+        uint32_t color     = 0;
+        reader.Read(state);
+        reader.Read(jumpsLeft);
+        reader.Read(snapshot.State.YBound);
+        reader.Read(snapshot.State.XBound);
+        reader.Read(snapshot.State.XWidth);
+        reader.Read(color);
+
+        if (state > static_cast<uint8_t>(GameObjectState::STATES::ON_GROUND)) {
+            return false;
+        }
+        snapshot.State.State     = static_cast<GameObjectState::STATES>(state);
+        snapshot.State.JumpsLeft = jumpsLeft;
+        snapshot.ObjectColor     = Color(color);
+
+        return !reader.HasFailed();
+    }
+
+    /// Snaps block to a grid of cells of size grid, keeping its bottom edge. The height is kept at least minHeight.
+    void snapBlock(RectangleF& block, float grid, float minHeight)
+    {
+        const float bottom = block.Y + block.H;
+        block.X = std::round(block.X / grid) * grid;
+        block.W = std::max(grid, std::round(block.W / grid) * grid);
+        block.H = std::max(std::ceil(minHeight / grid) * grid, std::round(block.H / grid) * grid);
+        block.Y = bottom - block.H;
+    }
+} // end anonymous namespace
 
 
 std::unique_ptr<GameLevel>
-GameLevel::CreateLevel(Sdl2& sdl2, ResourceManager& resMgr, int levelNumber, Dimensions2D arenaSize,
-                       const std::string& backgroundFilepath,
+GameLevel::CreateLevel(Sdl2& sdl2, ResourceManager& resMgr, Mode mode, unsigned int seed, int levelNumber,
+                       Dimensions2D arenaSize, const std::string& backgroundFilepath,
                        float gravity, float friction, double initialTime, PlayerObject* player)
 { // Static function
-    return std::make_unique<GameLevel>(sdl2, resMgr, levelNumber, arenaSize, backgroundFilepath, gravity, friction, initialTime, player);
+    return std::make_unique<GameLevel>(sdl2, resMgr, mode, seed, levelNumber, arenaSize, backgroundFilepath, gravity, friction, initialTime, player);
 }
 
+std::unique_ptr<GameLevel>
+GameLevel::CreateHeadlessLevel(Input& input, Mode mode, unsigned int seed, Dimensions2D arenaSize,
+                               float gravity, float friction, double initialTime, PlayerObject* player)
+{ // Static function
+    return std::make_unique<GameLevel>(input, mode, seed, arenaSize, gravity, friction, initialTime, player);
+}
 
-GameLevel::GameLevel(Sdl2& sdl2, ResourceManager& resMgr, int levelNumber, Dimensions2D arenaSize,
-                     const std::string& backgroundFilepath,
+
+GameLevel::GameLevel(Sdl2& sdl2, ResourceManager& resMgr, Mode mode, unsigned int seed, int levelNumber,
+                     Dimensions2D arenaSize, const std::string& backgroundFilepath,
                      float gravity, float friction, double initialTime, PlayerObject* player)
-    : _sdl2(sdl2)
-    , _resMgr(resMgr)
+    : GameLevel(sdl2.GetInput(), mode, seed, arenaSize, gravity, friction, initialTime, player)
+{
+    _background = std::make_unique<Background>(backgroundFilepath);
+    _gameHUD    = std::make_unique<GameHUD>(
+        resMgr.GetFont(Constants::Fonts::TTF::PERMANENTMARKER, 32),
+        sdl2.GetRenderer(),
+        levelNumber, 180
+    );
+
+    // The emitters are seeded from the level, but have generators of their own so that the
+    // particles never change the simulation.
+    _jumpParticles = std::make_unique<ParticleEmitter>(
+        Constants::Particles::CAPACITY,
+        ParticleEmitter::Properties{
+            Constants::Colors::LIGHTEST, Color::WithAlpha(Constants::Colors::LIGHT, 0),
+            40.0f, 160.0f, 120.0f, 240.0f, 0.3f, 0.6f, 200.0f, 0.9f, 4.0f
+        },
+        seed
+    );
+    _landingParticles = std::make_unique<ParticleEmitter>(
+        Constants::Particles::CAPACITY,
+        ParticleEmitter::Properties{
+            Constants::Colors::LIGHT, Color::WithAlpha(Constants::Colors::DARK, 0),
+            60.0f, 220.0f, -80.0f, 80.0f, 0.4f, 0.8f, 300.0f, 0.8f, 5.0f
+        },
+        seed + 1
+    );
+
+    _background->UpdateTexture(sdl2.GetRenderer());
+    _camera.SetDimensions(sdl2.GetRenderer().GetLogicalSize());
+    if (_mode == Mode::FIXED)
+    {
+        _terrainCache = std::make_unique<TerrainCache>(_camera.GetHeight());
+        _terrainCache->SetBlocks(_levelObjects);
+    }
+    // Only the chunks of ENDLESS levels are drawn with tiles
+    if (_mode == Mode::ENDLESS) {
+        _tileset.UpdateTexture(sdl2.GetRenderer());
+    }
+
+    Logger::Info("Level {} loaded!", levelNumber);
+}
+
+GameLevel::GameLevel(Input& input, Mode mode, unsigned int seed, Dimensions2D arenaSize,
+                     float gravity, float friction, double initialTime, PlayerObject* player)
+    : _input(input)
+    , _mode(mode)
     , _arenaSize(arenaSize)
-    , _background(backgroundFilepath)
     , _physics(gravity, friction)
+    , _random(seed)
     , _player(player)
     , _camera()
+    , _jumpEnvelope(
+        _physics, player->GetTransform().GetMoveForce(), player->GetRadius(),
+        1.0 / static_cast<double>(Constants::TARGET_UPS), Constants::TARGET_UPS / Constants::TARGET_FPS,
+        static_cast<float>(arenaSize.H)
+    )
+    , _previousBlock()
     , _levelObjects()
+    , _terrain(static_cast<float>(arenaSize.H))
+    , _terrainBlocks()
+    , _bots(nullptr)
+    , _tileset(32)
+    , _chunks()
+      // The scrolling background wraps around every RENDER_SIZE.W pixels, so the chunk width must be
+      // a multiple of it for the background to stay in place when the world origin is moved.
+    , _chunkWidth(static_cast<float>(2 * Constants::RENDER_SIZE.W))
+    , _nextBlockX(0.0f)
+    , _overhangingBlocks()
+    , _worldOriginX(0.0)
     , _timeLeft(initialTime)
-    , _gameHUD(
-        _resMgr.GetFont(Constants::Fonts::TTF::PERMANENTMARKER, 32),
-        _sdl2.GetRenderer(),
-        levelNumber, 180
-    )
+    , _maxPlayerDistance(0.0)
+    , _fallsCount(0)
+    , _playerOnBottom(false)
+    , _startSnapshot()
+    , _background(nullptr)
+    , _gameHUD(nullptr)
+    , _jumpParticles(nullptr)
+    , _landingParticles(nullptr)
+    , _terrainCache(nullptr)
+    , _renderQueue()
 {
     assert(player != nullptr);
     player->SetPosition(2.0f * player->GetRadius(), 2.0f * _player->GetRadius());
-    _background.UpdateTexture(_sdl2.GetRenderer());
     _camera.SetCenterPosition(_player->GetPosition());
-    _camera.SetDimensions(_sdl2.GetRenderer().GetLogicalSize());
+    _camera.SetDimensions(Constants::RENDER_SIZE);
 
-    initLevelObjects();
+    switch (_mode)
+    {
+        case Mode::FIXED:
+            initLevelObjects();
+            break;
+        case Mode::ENDLESS:
+            initEndlessChunks();
+            break;
+    }
 
-    Logger::Info("Level {} loaded!", levelNumber);
+    _startSnapshot = takeSnapshot();
 }
 
+GameLevel::Mode
+GameLevel::GetMode(void) const { return _mode; }
+
+unsigned int
+GameLevel::GetSeed(void) const { return _random.GetSeed(); }
+
 Dimensions2DF
 GameLevel::GetArenaSize(void) const
 {
@@ -52,10 +243,253 @@ GameLevel::GetArenaSize(void) const
     };
 }
 
+bool
+GameLevel::IsHeadless(void) const { return _gameHUD == nullptr; }
+
+double
+GameLevel::GetPlayerDistance(void) const
+{
+    return _worldOriginX + static_cast<double>(_player->GetPosition().x);
+}
+
+int
+GameLevel::GetScore(void) const { return static_cast<int>(_maxPlayerDistance / 100.0); }
+
+int
+GameLevel::GetFallsCount(void) const { return _fallsCount; }
+
+Timestep
+GameLevel::GetTimeLeft(void) const { return _timeLeft.GetTimeLeft(); }
+
+bool
+GameLevel::IsCompleted(void) const
+{
+    return _mode == Mode::FIXED
+        && _player->GetPosition().x + _player->GetRadius() >= static_cast<float>(_arenaSize.W) - 1.0f;
+}
+
+bool
+GameLevel::IsTimeUp(void) const { return !_timeLeft.IsPositive(); }
+
+void
+GameLevel::Restart(void)
+{
+    assert(_startSnapshot.has_value());
+    const Snapshot& snapshot = *_startSnapshot;
+    Timer timer("Level restart", false);
+
+    // The endless mode terrain has been recycled while playing, the chunks and their pooled blocks are refilled in place
+    if (_mode == Mode::ENDLESS) {
+        resetEndlessChunks();
+    }
+
+    _player->RestoreSnapshot(snapshot.Player);
+    _camera.SetCenterPosition(_player->GetPosition());
+
+    if (_bots != nullptr) {
+        _bots->Reset();
+    }
+
+    if (_jumpParticles != nullptr)
+    {
+        _jumpParticles->Clear();
+        _landingParticles->Clear();
+    }
+
+    assert(snapshot.BlockColors.size() == _levelObjects.size());
+    for (size_t i = 0; i < _levelObjects.size(); ++i) {
+        _levelObjects[i]->SetColor(snapshot.BlockColors[i]);
+    }
+
+    _timeLeft.SetTimeLeft(snapshot.TimeLeft);
+    _maxPlayerDistance = snapshot.MaxPlayerDistance;
+    _fallsCount        = snapshot.FallsCount;
+    _playerOnBottom    = snapshot.PlayerOnBottom;
+
+    if (_gameHUD != nullptr) {
+        _gameHUD->Update(_timeLeft.GetTimeLeft().GetWholeSeconds(), GetScore());
+    }
+
+    Logger::Debug("Level restarted in {}us", timer.Elapsed<std::chrono::microseconds>());
+}
+
+void
+GameLevel::SaveState(std::vector<uint8_t>& buffer) const
+{
+    StateWriter writer(buffer, getStateSize());
+
+    writer.Write(STATE_MAGIC);
+    writer.Write(STATE_VERSION);
+    writer.Write(uint32_t(0)); // The payload size, written last
+
+    writer.Write(static_cast<uint8_t>(_mode));
+    writer.Write(static_cast<uint32_t>(_random.GetSeed()));
+    writer.Write(static_cast<int32_t>(_arenaSize.W));
+    writer.Write(static_cast<int32_t>(_arenaSize.H));
+    writer.Write(_random.GetDrawsCount());
+
+    writeObject(writer, _player->TakeSnapshot());
+
+    const Point2DF camera = _camera.GetCenterPositionF();
+    writer.Write(camera.X);
+    writer.Write(camera.Y);
+
+    writer.Write(_timeLeft.GetTimeLeft().GetSeconds());
+    writer.Write(_maxPlayerDistance);
+    writer.Write(static_cast<int32_t>(_fallsCount));
+    writer.Write(static_cast<uint8_t>(_playerOnBottom));
+
+    switch (_mode)
+    {
+        case Mode::FIXED:
+            writer.Write(static_cast<uint32_t>(_levelObjects.size()));
+            for (const auto& o : _levelObjects) {
+                writer.Write(Color::ToUint32_t(o->GetColor()));
+            }
+            break;
+        case Mode::ENDLESS:
+            writer.Write(_worldOriginX);
+            writer.Write(_nextBlockX);
+            writer.Write(static_cast<uint8_t>(_previousBlock.has_value()));
+            writeRectangle(writer, _previousBlock.value_or(RectangleF{ 0.0f, 0.0f, 0.0f, 0.0f }));
+
+            writer.Write(static_cast<uint32_t>(_overhangingBlocks.size()));
+            for (const RectangleF& block : _overhangingBlocks) {
+                writeRectangle(writer, block);
+            }
+
+            writer.Write(static_cast<uint32_t>(_chunks.Size()));
+            for (size_t i = 0; i < _chunks.Size(); ++i)
+            {
+                const TileMap& tileMap = _chunks[i].GetTileMap();
+                writer.Write(_chunks[i].GetXStart());
+                writer.Write(static_cast<uint32_t>(tileMap.GetTilesCount()));
+                writer.WriteBytes(tileMap.GetTiles(), tileMap.GetTilesCount() * sizeof(TileMap::TileIndex));
+            }
+            break;
+    }
+
+    writer.Overwrite(2 * sizeof(uint32_t), static_cast<uint32_t>(writer.GetSize() - STATE_HEADER_SIZE));
+    assert(writer.IsComplete());
+}
+
+bool
+GameLevel::LoadState(const std::vector<uint8_t>& buffer)
+{
+    return LoadState(buffer.data(), buffer.size());
+}
+
+bool
+GameLevel::LoadState(const uint8_t* data, size_t size)
+{
+    StateReader reader(data, size);
+
+    uint32_t magic = 0, version = 0, payloadSize = 0;
+    uint8_t  mode  = 0;
+    uint32_t seed  = 0;
+    int32_t  arenaW = 0, arenaH = 0;
+    reader.Read(magic);
+    reader.Read(version);
+    reader.Read(payloadSize);
+    reader.Read(mode);
+    reader.Read(seed);
+    reader.Read(arenaW);
+    reader.Read(arenaH);
+
+    if (reader.HasFailed() || magic != STATE_MAGIC) {
+        Logger::Critical("Unable to load the level state: not a saved state");
+        return false;
+    }
+    if (version != STATE_VERSION) {
+        Logger::Critical("Unable to load the level state: version {} is not supported, expected {}", version, STATE_VERSION);
+        return false;
+    }
+    if (payloadSize != size - STATE_HEADER_SIZE) {
+        Logger::Critical("Unable to load the level state: expected {} bytes, got {}", payloadSize, size - STATE_HEADER_SIZE);
+        return false;
+    }
+    if (mode != static_cast<uint8_t>(_mode) || seed != _random.GetSeed() || arenaW != _arenaSize.W || arenaH != _arenaSize.H) {
+        Logger::Critical("Unable to load the level state: it was saved from a different level");
+        return false;
+    }
+
+    Timer timer("Level state load", false);
+    if (!loadState(reader) || reader.GetRemaining() != 0)
+    {
+        Logger::Critical("Unable to load the level state: the data is corrupted, restarting the level");
+        Restart();
+        return false;
+    }
+
+    if (_gameHUD != nullptr) {
+        _gameHUD->Update(_timeLeft.GetTimeLeft().GetWholeSeconds(), GetScore());
+    }
+    if (_jumpParticles != nullptr)
+    {
+        _jumpParticles->Clear();
+        _landingParticles->Clear();
+    }
+
+    Logger::Debug("Level state loaded in {}us", timer.Elapsed<std::chrono::microseconds>());
+    return true;
+}
+
+void
+GameLevel::GetBlocks(std::vector<RectangleF>& blocks) const
+{
+    blocks.clear();
+    for (const auto& o : _levelObjects) {
+        blocks.push_back(o->GetCollissionRect());
+    }
+
+    for (size_t i = 0; i < _chunks.Size(); ++i)
+    {
+        const LevelChunk& chunk = _chunks[i];
+        for (size_t b = 0; b < chunk.GetBlockCount(); ++b) {
+            blocks.push_back(chunk.GetBlock(b)->GetCollissionRect());
+        }
+    }
+
+    std::sort(blocks.begin(), blocks.end(),
+        [](const RectangleF& lhs, const RectangleF& rhs) { return lhs.X < rhs.X; }
+    );
+}
+
+const Physics&
+GameLevel::GetPhysics(void) const { return _physics; }
+
+const Heightfield&
+GameLevel::GetTerrain(void) const { return _terrain; }
+
+void
+GameLevel::SetBotsCount(size_t count)
+{
+    _bots.reset();
+    if (count > 0)
+    {
+        _bots = std::make_unique<BotSwarm>(count, _player->GetTransform().GetMoveForce(), _player->GetRadius(), _random.GetSeed());
+        Logger::Info("{} bots share the level, updated by up to {} threads", count, _bots->GetThreadsCount());
+    }
+}
+
+const BotSwarm*
+GameLevel::GetBots(void) const { return _bots.get(); }
+
 void
 GameLevel::HandleInput(void)
 {
+    if (_bots != nullptr) {
+        _bots->HandleInput();
+    }
+
+    if (_jumpParticles == nullptr) {
+        _player->HandleInput();
+        return;
+    }
+
+    const GameObjectState::Snapshot previousState = _player->TakeSnapshot().State;
     _player->HandleInput();
+    emitPlayerParticles(previousState);
 }
 
 void
@@ -64,53 +498,241 @@ GameLevel::Update(Timestep dt)
     _player->Update(_physics, _arenaSize, dt);
     _camera.TrackPosition(_player->GetPosition(), 0.1f);
 
+    // The bots that fall behind the recycled chunks of an ENDLESS level are pushed along by the left edge
+    if (_bots != nullptr) {
+        _bots->Update(_physics, _arenaSize, dt);
+    }
+
     for (auto& o : _levelObjects) {
         o->Update(_physics, _arenaSize, dt);
     }
 
+    if (_mode == Mode::ENDLESS) {
+        updateEndlessChunks();
+    }
+
+    if (_jumpParticles != nullptr)
+    {
+        _jumpParticles->Update(dt);
+        _landingParticles->Update(dt);
+    }
+
     _timeLeft.DeductTime(dt);
+    updateStatistics();
 
-    static int score = 0; // TODO: Remove fakescore
-    _gameHUD.Update(
-        _timeLeft.GetTimeLeft().GetWholeSeconds(),
-        (Helpers::random::FloatInRange(0.0f, 1.0f) >= 0.95f ? (score += 10) : score) // TODO: Remove fakescore
-    );
+    if (_gameHUD != nullptr) {
+        _gameHUD->Update(_timeLeft.GetTimeLeft().GetWholeSeconds(), GetScore());
+    }
 }
 
 void
 GameLevel::HandleCollisions(void)
 {
-    for (auto& o : _levelObjects) {
-        if (_player->CheckHitAndBounce(o.get())) {
-            break;
-        }
+    if (_bots != nullptr) {
+        _bots->HandleCollisions(_terrain);
+    }
+
+    if (_jumpParticles == nullptr) {
+        bouncePlayer();
+        return;
     }
+
+    const GameObjectState::Snapshot previousState = _player->TakeSnapshot().State;
+    bouncePlayer();
+    emitPlayerParticles(previousState);
 }
 
 void
 GameLevel::Draw(const Renderer& renderer, Timestep it) const
 {
-    _background.Draw(renderer, _camera, it);
+    Bake(renderer);
+    Record(_renderQueue, it);
+    _renderQueue.Flush(renderer);
+}
 
-    for (const auto& o : _levelObjects) {
-        if (_camera.RectangleIsInViewport(o->GetCollissionRect())) {
-            o->Draw(renderer, _camera, it);
-        }
+bool
+GameLevel::NeedsBaking(const Renderer& renderer) const
+{
+    assert(!IsHeadless());
+    return _terrainCache != nullptr && _terrainCache->NeedsBaking(renderer, _camera);
+}
+
+void
+GameLevel::Bake(const Renderer& renderer) const
+{
+    assert(!IsHeadless());
+    if (NeedsBaking(renderer)) {
+        _terrainCache->Bake(renderer, _camera);
+    }
+}
+
+void
+GameLevel::Record(RenderQueue& queue, Timestep it) const
+{
+    assert(!IsHeadless());
+    _background->Draw(queue, _camera, it);
+
+    // The terrain of a FIXED level is copied from the baked chunks
+    if (_terrainCache != nullptr) {
+        _terrainCache->Draw(queue, _camera);
     }
 
-    _player->Draw(renderer, _camera, it);
+    for (size_t i = 0; i < _chunks.Size(); ++i) {
+        _chunks[i].Draw(queue, _camera, _tileset);
+    }
+
+    _jumpParticles->Draw(queue, _camera);
+    _landingParticles->Draw(queue, _camera);
+
+    if (_bots != nullptr) {
+        _bots->Draw(queue, _camera, it, Constants::Colors::LIGHTEST);
+    }
+
+    _player->Draw(queue, _camera, it);
 
-    _gameHUD.Draw(renderer);
+    _gameHUD->Draw(queue);
 }
 
+RenderQueue::Stats
+GameLevel::GetRenderStats(void) const { return _renderQueue.GetFrameStats(); }
+
 void
 GameLevel::initLevelObjects(void)
 {
-    // Seed random number generator so we always generate the same level.
-    // NOTE: The actual generated level will depend on the implementation of the
-    //       random number generator => might not produce the same level on different platforms!
-    Helpers::random::Seed(1337);
+    generateTerrain(0.0f, static_cast<float>(_arenaSize.W), 0.0f, [this](Point2DF position, Dimensions2DF size) {
+        _levelObjects.push_back(GameObject::CreateBox(_input, 0.0f, position, size));
+        _terrain.Add(_levelObjects.back()->GetCollissionRect(), _terrainBlocks.size());
+        _terrainBlocks.push_back(_levelObjects.back().get());
+    });
+
+    validateLevelObjects();
+}
+
+void
+GameLevel::initEndlessChunks(void)
+{
+    // The arena only has to span the chunks kept in memory, the world origin is moved before the player reaches the end.
+    _arenaSize.W = static_cast<int>(static_cast<float>(ENDLESS_CHUNKS_COUNT) * _chunkWidth);
 
+    for (size_t i = 0; i < ENDLESS_CHUNKS_COUNT; ++i) {
+        appendEndlessChunk();
+    }
+}
+
+void
+GameLevel::resetEndlessChunks(void)
+{
+    _random.Rewind(0);
+    _chunks.Clear();
+    _overhangingBlocks.clear();
+    _previousBlock.reset();
+    _nextBlockX   = 0.0f;
+    _worldOriginX = 0.0;
+
+    initEndlessChunks();
+}
+
+void
+GameLevel::appendEndlessChunk(void)
+{
+    const float xStart = _chunks.IsEmpty() ? 0.0f : _chunks.Back().GetXEnd();
+    LevelChunk* previous = _chunks.IsEmpty() ? nullptr : &_chunks.Back();
+    bool previousChanged = false;
+
+    LevelChunk& chunk = _chunks.PushBack(); // Recycles the oldest chunk when full
+    chunk.Reset(xStart, { _chunkWidth, static_cast<float>(_arenaSize.H) }, TILE_SIZE);
+
+    // Blocks are generated around their center, so they might overhang into the neighbouring chunks.
+    for (const RectangleF& block : _overhangingBlocks) {
+        chunk.AddGroundBlock(block);
+    }
+    _overhangingBlocks.clear();
+
+    _nextBlockX = generateTerrain(_nextBlockX, chunk.GetXEnd(), TILE_SIZE, [&](Point2DF position, Dimensions2DF size) {
+        const RectangleF block = { position.X - 0.5f * size.W, position.Y - 0.5f * size.H, size.W, size.H };
+        chunk.AddGroundBlock(block);
+
+        if (block.X < chunk.GetXStart() && previous != nullptr) {
+            previous->AddGroundBlock(block);
+            previousChanged = true;
+        }
+        if (block.X + block.W > chunk.GetXEnd()) {
+            _overhangingBlocks.push_back(block);
+        }
+    });
+
+    chunk.BuildBlocks(_input);
+    if (previousChanged) {
+        previous->BuildBlocks(_input);
+    }
+    validateEndlessChunk(previous, chunk);
+
+    buildEndlessTerrain();
+}
+
+void
+GameLevel::buildEndlessTerrain(void)
+{
+    // The chunks are ordered by x, as are the blocks of a chunk
+    _terrain.Clear();
+    _terrainBlocks.clear();
+    for (size_t i = 0; i < _chunks.Size(); ++i)
+    {
+        const LevelChunk& chunk = _chunks[i];
+        for (size_t b = 0; b < chunk.GetBlockCount(); ++b)
+        {
+            _terrain.Add(chunk.GetBlock(b)->GetCollissionRect(), _terrainBlocks.size());
+            _terrainBlocks.push_back(chunk.GetBlock(b));
+        }
+    }
+}
+
+void
+GameLevel::updateEndlessChunks(void)
+{
+    // Once the player enters the third chunk, the oldest one is two chunks behind and can be recycled.
+    // Blocks might overhang into the following chunk, but never by a whole chunk width.
+    while (_player->GetPosition().x >= _chunks[2].GetXStart())
+    {
+        appendEndlessChunk();
+        translateWorldX(-_chunks.Front().GetXStart());
+    }
+}
+
+void
+GameLevel::translateWorldX(float dx)
+{
+    _worldOriginX -= static_cast<double>(dx);
+    _nextBlockX   += dx;
+
+    for (RectangleF& block : _overhangingBlocks) {
+        block.X += dx;
+    }
+    if (_previousBlock.has_value()) {
+        _previousBlock->X += dx;
+    }
+
+    _player->TranslateX(dx);
+    _camera.TranslateX(dx);
+    if (_bots != nullptr) {
+        _bots->TranslateX(dx);
+    }
+    _terrain.TranslateX(dx);
+
+    if (_jumpParticles != nullptr)
+    {
+        _jumpParticles->TranslateX(dx);
+        _landingParticles->TranslateX(dx);
+    }
+
+    for (size_t i = 0; i < _chunks.Size(); ++i) {
+        _chunks[i].TranslateX(dx);
+    }
+}
+
+float
+GameLevel::generateTerrain(float xBegin, float xEnd, float grid, const AddBlockCallback& addBlock)
+{
     constexpr float minWidth   =  60.0f;
     constexpr float maxWidth   = 250.0f;
     constexpr float minHeight  =  30.0f;
@@ -119,24 +741,325 @@ GameLevel::initLevelObjects(void)
     constexpr float minSpacing = 100.0f;
     constexpr float maxSpacing = 400.0f;
 
-    const float levelWidth  = static_cast<float>(_arenaSize.W);
     const float levelHeight = static_cast<float>(_arenaSize.H);
 
-    for (float xPos = 0.0f;
-         xPos < levelWidth;
-         xPos += Helpers::random::FloatInRange(minSpacing, maxSpacing))
+    float xPos = xBegin;
+    for (;
+         xPos < xEnd;
+         xPos += _random.FloatInRange(minSpacing, maxSpacing))
     {
-        float blockWidth = Helpers::random::FloatInRange(minWidth, maxWidth);
+        float blockWidth = _random.FloatInRange(minWidth, maxWidth);
         assert(minWidth <= blockWidth && blockWidth <= maxWidth);
 
-        float blockHeight = Helpers::random::FloatInRange(minHeight, maxHeigth - (0.5f * blockWidth));
+        float blockHeight = _random.FloatInRange(minHeight, maxHeigth - (0.5f * blockWidth));
+
+        RectangleF block = { xPos - 0.5f * blockWidth, levelHeight - blockHeight, blockWidth, blockHeight };
+        if (grid > 0.0f) {
+            snapBlock(block, grid, minHeight);
+        }
+        if (_previousBlock.has_value()) {
+            repairBlock(*_previousBlock, block, minHeight, grid);
+        }
+        xPos = block.X + 0.5f * block.W;
 
-        _levelObjects.push_back(GameObject::CreateBox(
-            _sdl2.GetInput(), 0.0f,
-            { xPos , levelHeight - (0.5f * blockHeight) },
-            { blockWidth, blockHeight }
-        ));
+        addBlock({ xPos , levelHeight - (0.5f * block.H) }, { block.W, block.H });
+        _previousBlock = block;
 
-        xPos += blockWidth;
+        xPos += block.W;
     }
+
+    return xPos;
+}
+
+void
+GameLevel::repairBlock(const RectangleF& previous, RectangleF& block, float minHeight, float grid) const
+{
+    if (_jumpEnvelope.CanReach(previous, block)) {
+        return;
+    }
+
+    // All blocks stand on the bottom of the level, so the rise between two blocks is the difference of their heights.
+    // The repaired block stays one pixel clear of the limits, the float rectangles are the colliders of a FIXED level.
+    // On a grid the block is rounded towards the previous one, so the tiles it is stored as are reachable too.
+    const float gap    = block.X - (previous.X + previous.W);
+    const float bottom = block.Y + block.H;
+    float       height = previous.H + _jumpEnvelope.GetMaxRise(gap) - 1.0f;
+    if (grid > 0.0f)
+    {
+        height    = std::floor(height / grid) * grid;
+        minHeight = std::ceil(minHeight / grid) * grid;
+    }
+    height  = std::max(minHeight, height);
+    block.Y = bottom - height;
+    block.H = height;
+
+    if (!_jumpEnvelope.CanReach(previous, block))
+    {
+        const float previousEnd = previous.X + previous.W;
+        const float maxGap      = _jumpEnvelope.GetMaxGap(previous.Y - block.Y);
+        assert(maxGap >= 0.0f);
+        block.X = previousEnd + maxGap - 1.0f;
+        if (grid > 0.0f) {
+            block.X = std::max(previousEnd, std::floor(block.X / grid) * grid);
+        }
+    }
+
+    assert(_jumpEnvelope.CanReach(previous, block));
+}
+
+void
+GameLevel::validateLevelObjects(void) const
+{
+    std::vector<RectangleF> blocks;
+    blocks.reserve(_levelObjects.size());
+    for (const auto& o : _levelObjects) {
+        blocks.push_back(o->GetCollissionRect());
+    }
+    validateBlocks(blocks);
+}
+
+void
+GameLevel::validateEndlessChunk([[maybe_unused]] const LevelChunk* previous, [[maybe_unused]] const LevelChunk& chunk) const
+{
+#ifndef NDEBUG
+    // The colliders are built from the tiles, which is where rounding could make a block unreachable
+    std::vector<RectangleF> blocks;
+    if (previous != nullptr && previous->GetBlockCount() > 0) {
+        blocks.push_back(previous->GetBlock(previous->GetBlockCount() - 1)->GetCollissionRect());
+    }
+    for (size_t b = 0; b < chunk.GetBlockCount(); ++b) {
+        blocks.push_back(chunk.GetBlock(b)->GetCollissionRect());
+    }
+    validateBlocks(blocks);
+#endif
+}
+
+void
+GameLevel::validateBlocks(const std::vector<RectangleF>& blocks) const
+{
+    const LevelValidator validator(_jumpEnvelope);
+    Timer timer("Level validation", false);
+    const std::vector<size_t> unreachable = validator.FindUnreachable(blocks);
+
+    Logger::Debug("Validated {} blocks with {} threads in {}us, {} unreachable",
+        blocks.size(), validator.GetThreadsCount(), timer.Elapsed<std::chrono::microseconds>(), unreachable.size());
+    assert(unreachable.empty());
+}
+
+void
+GameLevel::updateStatistics(void)
+{
+    _maxPlayerDistance = std::max(_maxPlayerDistance, GetPlayerDistance());
+
+    // A fall is counted every time the player reaches the bottom bound of the level
+    const float bottom = static_cast<float>(_arenaSize.H) - _player->GetRadius() - 1.0f;
+    const bool  onBottom = _player->GetPosition().y >= bottom;
+    if (onBottom && !_playerOnBottom) {
+        ++_fallsCount;
+    }
+    _playerOnBottom = onBottom;
+}
+
+void
+GameLevel::bouncePlayer(void)
+{
+    // The blocks are checked from left to right, since the player bounces off the first one only.
+    // Landing on a block puts the player on the whole run of touching blocks of the same height,
+    // so it does not fall at the seams between the blocks.
+    _terrain.QueryOverlaps(_player->GetCollissionRect(), [this](const Heightfield::Span& span)
+    {
+        if (!_player->CheckHitAndBounce(_terrainBlocks[span.Id])) {
+            return true;
+        }
+
+        const auto [xBound, xWidth] = _terrain.GetRunBounds(span);
+        if (xBound < span.XStart || xWidth > span.XEnd) {
+            _player->SetGroundBounds(xBound, xWidth);
+        }
+        return false;
+    });
+}
+
+void
+GameLevel::emitPlayerParticles(const GameObjectState::Snapshot& previousState)
+{
+    using STATES = GameObjectState::STATES;
+    const GameObjectState::Snapshot state = _player->TakeSnapshot().State;
+    const Point2DF feet = {
+        _player->GetPosition().x,
+        _player->GetPosition().y + _player->GetRadius()
+    };
+
+    // Jumping from the ground, or the double jumps while in the air
+    const bool jumped = state.State == STATES::JUMPING && (
+        (previousState.State == STATES::ON_GROUND) ||
+        (previousState.State == STATES::JUMPING && state.JumpsLeft < previousState.JumpsLeft)
+    );
+    // Hitting a block while falling either stops or bounces the player
+    const bool landed = previousState.State == STATES::FALLING && state.State != STATES::FALLING;
+
+    if (jumped) {
+        _jumpParticles->Emit(feet, Constants::Particles::JUMP);
+    }
+    if (landed) {
+        _landingParticles->Emit(feet, Constants::Particles::LANDING);
+    }
+}
+
+GameLevel::Snapshot
+GameLevel::takeSnapshot(void) const
+{
+    std::vector<Color> blockColors;
+    blockColors.reserve(_levelObjects.size());
+    for (const auto& o : _levelObjects) {
+        blockColors.push_back(o->GetColor());
+    }
+
+    return {
+        _player->TakeSnapshot(),
+        std::move(blockColors),
+        _timeLeft.GetTimeLeft().GetSeconds(),
+        _maxPlayerDistance,
+        _fallsCount,
+        _playerOnBottom
+    };
+}
+
+size_t
+GameLevel::getStateSize(void) const
+{
+    size_t size = STATE_HEADER_SIZE
+                + sizeof(uint8_t) + 3 * sizeof(uint32_t) + sizeof(uint64_t) // Level
+                + OBJECT_SIZE                                               // Player
+                + 2 * sizeof(float)                                         // Camera
+                + 2 * sizeof(double) + sizeof(int32_t) + sizeof(uint8_t);  // Statistics
+
+    switch (_mode)
+    {
+        case Mode::FIXED:
+            size += sizeof(uint32_t) + _levelObjects.size() * sizeof(uint32_t);
+            break;
+        case Mode::ENDLESS:
+            size += sizeof(double) + sizeof(float) + sizeof(uint8_t) + RECTANGLE_SIZE;
+            size += sizeof(uint32_t) + _overhangingBlocks.size() * RECTANGLE_SIZE;
+            size += sizeof(uint32_t);
+            for (size_t i = 0; i < _chunks.Size(); ++i) {
+                size += sizeof(float) + sizeof(uint32_t) + _chunks[i].GetTileMap().GetTilesCount() * sizeof(TileMap::TileIndex);
+            }
+            break;
+    }
+
+    return size;
+}
+
+bool
+GameLevel::loadState(StateReader& reader)
+{
+    uint64_t drawsCount = 0;
+    reader.Read(drawsCount);
+
+    GameObject::Snapshot player = _player->TakeSnapshot();
+    if (!readObject(reader, player)) {
+        return false;
+    }
+
+    Point2DF camera   = { 0.0f, 0.0f };
+    double   timeLeft = 0.0;
+    int32_t  falls    = 0;
+    uint8_t  onBottom = 0;
+    reader.Read(camera.X);
+    reader.Read(camera.Y);
+    reader.Read(timeLeft);
+    reader.Read(_maxPlayerDistance);
+    reader.Read(falls);
+    reader.Read(onBottom);
+
+    _random.Rewind(drawsCount);
+    _player->RestoreSnapshot(player);
+    _camera.SetCenterPosition(glm::vec3(camera.X, camera.Y, 0.0f));
+    _timeLeft.SetTimeLeft(timeLeft);
+    _fallsCount     = falls;
+    _playerOnBottom = onBottom != 0;
+
+    uint32_t count = 0;
+    switch (_mode)
+    {
+        case Mode::FIXED:
+            if (!reader.Read(count) || count != _levelObjects.size()) {
+                return false;
+            }
+            for (auto& o : _levelObjects)
+            {
+                uint32_t color = 0;
+                reader.Read(color);
+                o->SetColor(Color(color));
+            }
+            break;
+        case Mode::ENDLESS:
+        {
+            uint8_t hasPrevious = 0;
+            RectangleF previous = { 0.0f, 0.0f, 0.0f, 0.0f };
+            reader.Read(_worldOriginX);
+            reader.Read(_nextBlockX);
+            reader.Read(hasPrevious);
+            readRectangle(reader, previous);
+            _previousBlock = hasPrevious != 0 ? std::optional<RectangleF>(previous) : std::nullopt;
+
+            if (!reader.Read(count) || count > reader.GetRemaining() / RECTANGLE_SIZE) {
+                return false;
+            }
+            _overhangingBlocks.resize(count);
+            for (RectangleF& block : _overhangingBlocks) {
+                readRectangle(reader, block);
+            }
+
+            if (!reader.Read(count) || count != ENDLESS_CHUNKS_COUNT) {
+                return false;
+            }
+
+            // Rebuilding the blocks of a chunk is the most expensive part of loading, and when loading
+            // recent states most of the chunks are still the same, so only the changed ones are rebuilt.
+            struct ChunkView { float XStart; uint32_t TilesCount; const uint8_t* Tiles; };
+            std::array<ChunkView, ENDLESS_CHUNKS_COUNT> views;
+            bool unchanged = _chunks.Size() == ENDLESS_CHUNKS_COUNT;
+
+            for (size_t i = 0; i < ENDLESS_CHUNKS_COUNT; ++i)
+            {
+                ChunkView& view = views[i];
+                reader.Read(view.XStart);
+                reader.Read(view.TilesCount);
+                view.Tiles = reader.ReadView(view.TilesCount * sizeof(TileMap::TileIndex));
+                if (view.Tiles == nullptr) {
+                    return false;
+                }
+
+                unchanged = unchanged
+                    && view.XStart     == _chunks[i].GetXStart()
+                    && view.TilesCount == _chunks[i].GetTileMap().GetTilesCount()
+                    && std::memcmp(view.Tiles, _chunks[i].GetTileMap().GetTiles(), view.TilesCount) == 0;
+            }
+
+            if (unchanged) {
+                break;
+            }
+
+            _chunks.Clear();
+            for (const ChunkView& view : views)
+            {
+                LevelChunk& chunk = _chunks.PushBack();
+                chunk.Reset(view.XStart, { _chunkWidth, static_cast<float>(_arenaSize.H) }, TILE_SIZE);
+
+                TileMap& tileMap = chunk.GetMutableTileMap();
+                if (view.TilesCount != tileMap.GetTilesCount()) {
+                    return false;
+                }
+                std::memcpy(tileMap.GetMutableTiles(), view.Tiles, view.TilesCount * sizeof(TileMap::TileIndex));
+                chunk.BuildBlocks(_input);
+            }
+            buildEndlessTerrain();
+            break;
+        }
+    }
+
+    return !reader.HasFailed();
 }
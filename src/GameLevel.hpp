@@ -2,63 +2,259 @@
 #define GAMELEVEL_HPP
 
 #include "Background.hpp"
+#include "BotSwarm.hpp"
 #include "Camera.hpp"
 #include "GameObject.hpp"
 #include "Geometry.hpp"
+#include "Heightfield.hpp"
+#include "Helpers.hpp"
+#include "Input.hpp"
+#include "LevelChunk.hpp"
+#include "LevelValidator.hpp"
 #include "Overlays.hpp"
+#include "ParticleEmitter.hpp"
 #include "Physics.hpp"
+#include "RenderQueue.hpp"
 #include "Renderer.hpp"
 #include "ResourceManager.hpp"
+#include "RingBuffer.hpp"
 #include "Sdl2.hpp"
+#include "StateSerializer.hpp"
+#include "TerrainCache.hpp"
+#include "Tileset.hpp"
 #include "Timetools.hpp"
 
+#include <cstdint>
+#include <functional>
 #include <memory>
+#include <optional>
 #include <vector>
 #include <string>
 
 
+/// A level of the game. The level is generated from a seed, and all of its state is owned by the level
+/// itself, so any amount of levels can be simulated at the same time. Headless levels are only
+/// simulated, they can not be drawn and they don't need any SDL subsystems.
 class GameLevel
 {
 public:
-    static std::unique_ptr<GameLevel> CreateLevel(Sdl2& sdl2, ResourceManager& resMgr,
-                                                  int levelNumber, Dimensions2D arenaSize,
+    /// FIXED levels are generated once to the full width of the arena. ENDLESS levels keep only
+    /// a few chunks around the player, and the width of the arena is ignored.
+    enum class Mode { FIXED, ENDLESS };
+
+public:
+    static std::unique_ptr<GameLevel> CreateLevel(Sdl2& sdl2, ResourceManager& resMgr, Mode mode,
+                                                  unsigned int seed, int levelNumber, Dimensions2D arenaSize,
                                                   const std::string& backgroundFilepath,
                                                   float gravity, float friction, double initialTime,
                                                   PlayerObject* player);
 
+    static std::unique_ptr<GameLevel> CreateHeadlessLevel(Input& input, Mode mode,
+                                                          unsigned int seed, Dimensions2D arenaSize,
+                                                          float gravity, float friction, double initialTime,
+                                                          PlayerObject* player);
+
 public:
-    GameLevel(Sdl2& sdl2, ResourceManager& resMgr,
-              int levelNumber, Dimensions2D arenaSize,
+    GameLevel(Sdl2& sdl2, ResourceManager& resMgr, Mode mode,
+              unsigned int seed, int levelNumber, Dimensions2D arenaSize,
               const std::string& backgroundFilepath,
               float gravity, float friction, double initialTime,
               PlayerObject* player);
+    GameLevel(Input& input, Mode mode,
+              unsigned int seed, Dimensions2D arenaSize,
+              float gravity, float friction, double initialTime,
+              PlayerObject* player);
     GameLevel(const GameLevel& other) = delete;
     GameLevel(GameLevel&& other)      = delete;
     ~GameLevel(void) = default;
 
+    Mode          GetMode(void)      const;
+    unsigned int  GetSeed(void)      const;
     Dimensions2DF GetArenaSize(void) const;
+    bool          IsHeadless(void)   const;
+
+    /// @return The x-coordinate of the player counted from where the level started, unaffected by rebasing.
+    double        GetPlayerDistance(void) const;
+
+    /// @return The score, which is the furthest distance the player has reached in "meters".
+    int           GetScore(void)      const;
+
+    /// @return The amount of times the player has fallen down to the bottom of the level.
+    int           GetFallsCount(void) const;
+    Timestep      GetTimeLeft(void)   const;
+
+    /// @return true if the player has reached the right end of a FIXED level.
+    bool          IsCompleted(void)   const;
+    bool          IsTimeUp(void)      const;
+
+    /// Restores the level to the state it had right after loading. The terrain and the textures are
+    /// kept, only the state that changes while playing is reset, so restarting is much faster than
+    /// creating a new level.
+    void Restart(void);
+
+    /// Serializes the whole simulation state into buffer, replacing its contents. The terrain of a
+    /// FIXED level never changes and is generated from the seed, so only its block colors are saved.
+    /// Saving into the same buffer again does not allocate, unless the state has grown.
+    void SaveState(std::vector<uint8_t>& buffer) const;
+
+    /// Restores a state saved by SaveState. The level must have been created with the same mode,
+    /// seed and arena size as the saved one.
+    /// @return false if the data is not a state of this level. The header is validated before anything
+    /// is restored, so the level is unchanged, unless the data is corrupted after a valid header, in
+    /// which case the level is restarted.
+    bool LoadState(const std::vector<uint8_t>& buffer);
+    bool LoadState(const uint8_t* data, size_t size);
+
+    /// The version of the binary format of SaveState, must be bumped whenever the format changes.
+    inline static constexpr uint32_t STATE_VERSION = 1;
+
+    /// Collects the collision rectangles of every block of the level, sorted by their x-coordinate.
+    /// @param blocks Replaced with the blocks, does not allocate once it has grown to fit them.
+    void GetBlocks(std::vector<RectangleF>& blocks) const;
+
+    const Physics&     GetPhysics(void) const;
+
+    /// @return Every block the player can collide with.
+    const Heightfield& GetTerrain(void) const;
+
+    /// Replaces the bots of the level with count new ones, which start where the player does and
+    /// share the level with it, see BotSwarm. 0 removes the bots. The bots never affect the player,
+    /// so they are not part of the saved state, LoadState keeps them as they are and Restart returns
+    /// them to the start.
+    void            SetBotsCount(size_t count);
+
+    /// @return nullptr if the level has no bots.
+    const BotSwarm* GetBots(void) const;
 
     void HandleInput(void);
     void Update(Timestep dt);
     void HandleCollisions(void);
+
+    /// Bakes the terrain, records the level and draws it on the current rendering target.
     void Draw(const Renderer& renderer, Timestep it) const;
 
+    /// @return true if terrain chunks near the camera must be baked before the level is recorded, see
+    /// TerrainCache. Always false in ENDLESS mode.
+    bool NeedsBaking(const Renderer& renderer) const;
+
+    /// Bakes the terrain chunks near the camera that are missing or out of date. This draws into
+    /// textures that the previously recorded frames may refer to.
+    void Bake(const Renderer& renderer) const;
+
+    /// Submits the draw commands of the level to queue, without using the renderer.
+    void Record(RenderQueue& queue, Timestep it) const;
+
+    /// @return The statistics of the draw commands of the last frame drawn with Draw.
+    RenderQueue::Stats GetRenderStats(void) const;
+
 private:
+    using AddBlockCallback = std::function<void(Point2DF, Dimensions2DF)>;
+
+    /// The state of the level that changes while playing. The endless mode terrain is not included,
+    /// it is regenerated from the seed instead.
+    struct Snapshot
+    {
+        GameObject::Snapshot Player;
+        std::vector<Color>   BlockColors; // FIXED mode, the player colors the blocks it lands on
+        double               TimeLeft;    // Seconds
+        double               MaxPlayerDistance;
+        int                  FallsCount;
+        bool                 PlayerOnBottom;
+    };
+
+    // Chunks kept alive in endless mode: one behind the player, the current one and the ones ahead.
+    inline static constexpr size_t ENDLESS_CHUNKS_COUNT = 4;
+    inline static constexpr float  TILE_SIZE            = 25.0f; // Must divide the chunk width and arena height
+
     void initLevelObjects(void);
+    void initEndlessChunks(void);
+    void resetEndlessChunks(void);
+    void appendEndlessChunk(void);
+
+    /// Rebuilds the terrain heightfield from the blocks of the endless mode chunks.
+    void buildEndlessTerrain(void);
+    void updateEndlessChunks(void);
+
+    /// Moves everything in the level dx units along the x-axis, keeps the coordinates close to the
+    /// origin so that the float precision does not degrade no matter how far the player travels.
+    void translateWorldX(float dx);
+
+    /// Generates blocks in the range [xBegin, xEnd) on the x-axis. Every block is made reachable
+    /// from the previously generated one.
+    /// @param grid The blocks are snapped to a grid of this size before they are repaired, so that
+    /// they are still reachable once they are stored as tiles. 0 = no snapping.
+    /// @return The x-coordinate where the generation should continue.
+    float generateTerrain(float xBegin, float xEnd, float grid, const AddBlockCallback& addBlock);
+
+    /// Makes block reachable from previous if it is not. The block is lowered first, and if even
+    /// a block of minHeight is too far away, it is moved closer to previous. With a grid, the
+    /// block is only lowered and moved by whole grid cells.
+    void  repairBlock(const RectangleF& previous, RectangleF& block, float minHeight, float grid) const;
+
+    /// Logs the amount of unreachable blocks in a FIXED level, validates all of them in parallel.
+    void  validateLevelObjects(void) const;
+
+    /// Validates the colliders of the newest endless mode chunk, and the step onto them from the
+    /// previous chunk. Does nothing in release builds.
+    void  validateEndlessChunk(const LevelChunk* previous, const LevelChunk& chunk) const;
+
+    /// Logs the amount of blocks that can not be reached from the previous one, asserts that there are none.
+    /// @param blocks Sorted by their x-coordinate.
+    void  validateBlocks(const std::vector<RectangleF>& blocks) const;
+
+    /// Updates the score and the falls count from the current position of the player.
+    void  updateStatistics(void);
+
+    /// Bounces the player off the first block of the terrain it hits.
+    void  bouncePlayer(void);
+
+    /// Emits particles below the player when it has jumped or landed since the state was taken.
+    void  emitPlayerParticles(const GameObjectState::Snapshot& previousState);
+
+    Snapshot takeSnapshot(void) const;
+
+    /// @return The exact amount of bytes written by SaveState.
+    size_t getStateSize(void) const;
+
+    /// Reads the state following the header, returns false on the first invalid value.
+    bool   loadState(StateReader& reader);
 
 private:
-    Sdl2&            _sdl2;
-    ResourceManager& _resMgr;
+    Input&           _input;
+    Mode             _mode;
     Dimensions2D     _arenaSize;
-    Background       _background;
     Physics          _physics;
+    Helpers::random::Generator _random;
 
     PlayerObject*    _player;
     Camera           _camera;
+    JumpEnvelope     _jumpEnvelope;
+    std::optional<RectangleF> _previousBlock; // The last generated block
 
     std::vector<std::unique_ptr<GameObject>> _levelObjects;
+    Heightfield                  _terrain;       // Every block the player can collide with
+    std::vector<GameObject*>     _terrainBlocks; // Indexed by the ids of the terrain spans
+    std::unique_ptr<BotSwarm>    _bots;          // nullptr = no bots
+
+    Tileset          _tileset;
+    RingBuffer<LevelChunk, ENDLESS_CHUNKS_COUNT> _chunks;
+    float            _chunkWidth;
+    float            _nextBlockX;   // Endless mode: the x-coordinate where the terrain generation continues
+    std::vector<RectangleF> _overhangingBlocks; // Endless mode: blocks that continue into the next chunk
+    double           _worldOriginX; // Endless mode: total distance the world has been translated
     LevelTimer       _timeLeft;
-    GameHUD          _gameHUD;
+    double           _maxPlayerDistance;
+    int              _fallsCount;
+    bool             _playerOnBottom;
+    std::optional<Snapshot> _startSnapshot; // Taken when the level has been loaded
+
+    // Only created for levels that are drawn
+    std::unique_ptr<Background> _background;
+    std::unique_ptr<GameHUD>    _gameHUD;
+    std::unique_ptr<ParticleEmitter> _jumpParticles;
+    std::unique_ptr<ParticleEmitter> _landingParticles;
+    std::unique_ptr<TerrainCache>    _terrainCache; // FIXED mode
+    mutable RenderQueue _renderQueue; // Collects the draw commands of a frame
 
 };
 
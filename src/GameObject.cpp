@@ -1,10 +1,32 @@
 #include "GameObject.hpp"
 #include "Logger.hpp"
 #include "Constants.hpp"
+#include "Motion.hpp"
 #include "Physics.hpp"
 
-#include <cmath>
 
+GameObjectState*
+GameObjectState::CreateFromSnapshot(const Snapshot& snapshot)
+{ // Static function
+    switch (snapshot.State)
+    {
+        case STATES::FALLING:
+            return new FallingState();
+        case STATES::JUMPING:
+            return new JumpingState(snapshot.JumpsLeft);
+        case STATES::ON_GROUND:
+            return new OnGroundState(snapshot.YBound, snapshot.XBound, snapshot.XWidth);
+    }
+
+    assert(false);
+    return new FallingState();
+}
+
+void
+GameObjectState::TranslateX([[maybe_unused]] float dx)
+{
+    // Most states hold no world coordinates
+}
 
 GameObjectState*
 FallingState::HandleUpdate(PlayerObject* parent, const Physics& physics, Dimensions2D boundaries, Timestep dt)
@@ -25,12 +47,7 @@ FallingState::HandleUpdate(PlayerObject* parent, const Physics& physics, Dimensi
 GameObjectState*
 FallingState::HandleInput(InputComponent& inputCmp)
 {
-    inputCmp.Handle({
-        Input::KeyCode::UP,
-        Input::KeyCode::DOWN,
-        Input::KeyCode::LEFT,
-        Input::KeyCode::RIGHT
-    });
+    inputCmp.Handle(KEYS);
     return nullptr;
 }
 
@@ -39,7 +56,7 @@ FallingState::HandleCollisions(PlayerObject* parent, GameObject* obj)
 {
     if (parent->GetCollissionRect().Overlaps(obj->GetCollissionRect())) {
         obj->SetColor(Constants::Colors::GREEN);
-        if (std::abs(parent->GetTransform().GetVelocity().y) < 1.0f) {
+        if (Motion::Lands(parent->GetTransform().GetVelocity().y)) {
             parent->SetYVelocityStopped();
             float yBounds = parent->GetPosition().y;
             float xBounds = obj->GetCollissionRect().X;
@@ -50,11 +67,17 @@ FallingState::HandleCollisions(PlayerObject* parent, GameObject* obj)
         }
 
         parent->BounceYAxis();
-        return new JumpingState(2);
+        return new JumpingState(Motion::JUMPS_COUNT);
     }
     return nullptr;
 }
 
+GameObjectState::Snapshot
+FallingState::TakeSnapshot(void) const
+{
+    return { STATES::FALLING, 0, 0.0f, 0.0f, 0.0f };
+}
+
 
 JumpingState::JumpingState(size_t jumpsCount)
     : _jumpsLeft(jumpsCount)
@@ -76,7 +99,7 @@ JumpingState::HandleUpdate(PlayerObject* parent, const Physics& physics, Dimensi
         dt
     );
 
-    if (parent->GetVelocity().y > 0.0f) {
+    if (Motion::StartsFalling(parent->GetVelocity().y)) {
         return new FallingState();
     }
 
@@ -86,18 +109,7 @@ JumpingState::HandleUpdate(PlayerObject* parent, const Physics& physics, Dimensi
 GameObjectState*
 JumpingState::HandleInput(InputComponent& inputCmp)
 {
-    std::vector<Input::KeyCode> activeKeys = {
-        Input::KeyCode::LEFT,
-        Input::KeyCode::RIGHT,
-        Input::KeyCode::DOWN
-    };
-
-    if (_jumpsLeft > 0) {
-        activeKeys.push_back(Input::KeyCode::UP);
-        activeKeys.push_back(Input::KeyCode::SPACE);
-    }
-
-    bool spacePressed = inputCmp.Handle(activeKeys);
+    bool spacePressed = inputCmp.Handle(_jumpsLeft > 0 ? KEYS_WITH_JUMPS : KEYS);
     if (_jumpsLeft > 0 && spacePressed) {
         _jumpsLeft--;
     }
@@ -112,6 +124,12 @@ JumpingState::HandleCollisions([[maybe_unused]] PlayerObject* parent, [[maybe_un
     return nullptr;
 }
 
+GameObjectState::Snapshot
+JumpingState::TakeSnapshot(void) const
+{
+    return { STATES::JUMPING, _jumpsLeft, 0.0f, 0.0f, 0.0f };
+}
+
 OnGroundState::OnGroundState(float yBound, float xBound, float xWidth)
     : _yBound(yBound)
     , _xBound(xBound)
@@ -134,8 +152,7 @@ OnGroundState::HandleUpdate(PlayerObject* parent, const Physics& physics, Dimens
         dt
     );
 
-    RectangleF pr = parent->GetCollissionRect();
-    if (pr.X + pr.W < _xBound || pr.X > _xWidth) {
+    if (Motion::LeavesGround(parent->GetCollissionRect(), _xBound, _xWidth)) {
         return new FallingState();
     }
 
@@ -145,16 +162,10 @@ OnGroundState::HandleUpdate(PlayerObject* parent, const Physics& physics, Dimens
 GameObjectState*
 OnGroundState::HandleInput(InputComponent& inputCmp)
 {
-    bool spacePressed = inputCmp.Handle({
-        Input::KeyCode::UP,
-        Input::KeyCode::DOWN,
-        Input::KeyCode::LEFT,
-        Input::KeyCode::RIGHT,
-        Input::KeyCode::SPACE
-    });
+    bool spacePressed = inputCmp.Handle(KEYS);
 
     if (spacePressed) {
-        return new JumpingState(2);
+        return new JumpingState(Motion::JUMPS_COUNT);
     }
 
     return nullptr;
@@ -168,38 +179,18 @@ OnGroundState::HandleCollisions([[maybe_unused]] PlayerObject* parent, [[maybe_u
 }
 
 void
-NullCommand::ExecuteMovement([[maybe_unused]] Transform& transform) const
-{
-    // Does nothing, command is not bound to anything.
-}
-
-void
-JumpCommand::ExecuteMovement(Transform& transform) const
+OnGroundState::TranslateX(float dx)
 {
-    transform.ApplyForce(Physics::Direction::NORTH, 12.5f * transform.GetMoveForce());
+    _xBound += dx;
+    _xWidth += dx;
 }
 
-MoveCommand::MoveCommand(Physics::Direction direction)
-    : _direction(direction)
+GameObjectState::Snapshot
+OnGroundState::TakeSnapshot(void) const
 {
-    //
-}
-
-void
-MoveCommand::ExecuteMovement(Transform& transform) const
-{
-    float force = transform.GetMoveForce();
-    switch (_direction)
-    {
-        case Physics::Direction::NORTH: force *= 2.0f; break;
-        case Physics::Direction::EAST:  force *= 1.0f; break;
-        case Physics::Direction::SOUTH: force *= 0.5f; break;
-        case Physics::Direction::WEST:  force *= 1.0f; break;
-    }
-    transform.ApplyForce(_direction, force);
+    return { STATES::ON_GROUND, 0, _yBound, _xBound, _xWidth };
 }
 
-
 InputComponent::InputComponent(const Input& input)
     : _input(input)
     , _parent(nullptr)
@@ -255,40 +246,32 @@ GraphicsComponent::SetParent(const GameObject* parent)
 }
 
 void
-GraphicsComponent::Draw(const Renderer& renderer, const Camera& camera, Timestep it) const
+GraphicsComponent::Draw(RenderQueue& queue, const Camera& camera, Timestep it) const
 {
     assert(_parent != nullptr);
 
     if (const PlayerObject* playerPtr = dynamic_cast<const PlayerObject*>(_parent))
     {
-        renderer.SetRenderDrawColor(playerPtr->GetColor());
-        renderer.DrawCircleFilled(
+        queue.FillCircle(
+             RenderQueue::Layer::PLAYER,
              camera.Transform(playerPtr->GetTransform().GetScreenCoords(it)),
-             static_cast<int>(playerPtr->GetRadius() + 0.5f)
+             static_cast<int>(playerPtr->GetRadius() + 0.5f),
+             playerPtr->GetColor()
         );
 
 #ifdef DRAW_COLLIDERS
         Rectangle playerRect = camera.TransformRectangle(playerPtr->GetCollissionRect());
-        renderer.SetRenderDrawColor({ Constants::Colors::WHITE });
-        renderer.DrawRectangle(&playerRect);
+        queue.DrawRectangle(RenderQueue::Layer::DEBUG, playerRect, { Constants::Colors::WHITE });
 #endif
 
     }
     else if (const BoxObject* ptr = dynamic_cast<const BoxObject*>(_parent))
     {
-        renderer.SetRenderDrawColor(ptr->GetColor());
-        renderer.DrawFilledRectangle(
-            camera.Transform(ptr->GetTransform().GetScreenCoords(it)),
-            {
-                static_cast<int>(ptr->GetSize().W + 0.5f),
-                static_cast<int>(ptr->GetSize().H + 0.5f)
-            }
-        );
+        queue.FillRectangle(RenderQueue::Layer::TERRAIN, ptr->GetScreenRect(camera, it), ptr->GetColor());
 
 #ifdef DRAW_COLLIDERS
         Rectangle boxRect = camera.TransformRectangle(ptr->GetCollissionRect());
-        renderer.SetRenderDrawColor({ Constants::Colors::WHITE });
-        renderer.DrawRectangle(&boxRect);
+        queue.DrawRectangle(RenderQueue::Layer::DEBUG, boxRect, { Constants::Colors::WHITE });
 #endif
 
     }
@@ -301,7 +284,7 @@ GraphicsComponent::Draw(const Renderer& renderer, const Camera& camera, Timestep
 
 
 std::unique_ptr<PlayerObject>
-GameObject::CreatePlayer(Input& input, float posX, float posY, float moveSpeed, float radius, Sound& jumpSound, Color color)
+GameObject::CreatePlayer(Input& input, float posX, float posY, float moveSpeed, float radius, Sound* jumpSound, Color color)
 { // Static function
     return std::make_unique<PlayerObject>(input, posX, posY, moveSpeed, radius, jumpSound, color);
 }
@@ -357,6 +340,14 @@ GameObject::SetPosition(float xPos, float yPos)
     _transform.SetPosition(glm::vec3(xPos, yPos, 0.0f));
 }
 
+void
+GameObject::TranslateX(float dx)
+{
+    const glm::vec4& position = _transform.GetPosition();
+    _transform.SetPosition(glm::vec3(position.x + dx, position.y, position.z));
+    _state->TranslateX(dx);
+}
+
 void
 GameObject::SetColor(Color color)
 {
@@ -366,6 +357,22 @@ GameObject::SetColor(Color color)
 Color
 GameObject::GetColor(void) const { return _color; }
 
+GameObject::Snapshot
+GameObject::TakeSnapshot(void) const
+{
+    return { _transform.TakeSnapshot(), _state->TakeSnapshot(), _color };
+}
+
+void
+GameObject::RestoreSnapshot(const Snapshot& snapshot)
+{
+    _transform.RestoreSnapshot(snapshot.Transform);
+    _color = snapshot.ObjectColor;
+
+    delete _state;
+    _state = GameObjectState::CreateFromSnapshot(snapshot.State);
+}
+
 void
 GameObject::ApplyForce(Physics::Direction direction, float force)
 {
@@ -379,13 +386,13 @@ GameObject::ApplyForce(float angleDegrees, float force)
 }
 
 void
-GameObject::Draw(const Renderer& renderer, const Camera& camera, Timestep it) const
+GameObject::Draw(RenderQueue& queue, const Camera& camera, Timestep it) const
 { // virtual override member from DrawableObject
-    _graphicsComponent.Draw(renderer, camera, it);
+    _graphicsComponent.Draw(queue, camera, it);
 }
 
 
-PlayerObject::PlayerObject(Input& input, float posX, float posY, float moveSpeed, float radius, Sound& jumpSound, Color color)
+PlayerObject::PlayerObject(Input& input, float posX, float posY, float moveSpeed, float radius, Sound* jumpSound, Color color)
     : GameObject(input, posX, posY, moveSpeed, color)
     , _radius(radius)
     , _soundJump(jumpSound)
@@ -437,6 +444,18 @@ PlayerObject::CheckHitAndBounce(GameObject* obj)
     //return false;
 }
 
+void
+PlayerObject::SetGroundBounds(float xBound, float xWidth)
+{
+    const GameObjectState::Snapshot state = _state->TakeSnapshot();
+    if (state.State != GameObjectState::STATES::ON_GROUND) {
+        return;
+    }
+
+    delete _state;
+    _state = new OnGroundState(state.YBound, xBound, xWidth);
+}
+
 void
 PlayerObject::BounceYAxis(void)
 {
@@ -446,7 +465,9 @@ PlayerObject::BounceYAxis(void)
 void
 PlayerObject::PlayJumpingSound(void)
 {
-    _soundJump.Play();
+    if (_soundJump != nullptr) {
+        _soundJump->Play();
+    }
 }
 
 void
@@ -494,6 +515,20 @@ BoxObject::BoxObject(Input& input, Point2DF position, Dimensions2DF size, float
 Dimensions2DF
 BoxObject::GetSize(void) const { return _size; }
 
+void
+BoxObject::SetSize(Dimensions2DF size)
+{
+    _size = size;
+}
+
+Rectangle
+BoxObject::GetScreenRect(const Camera& camera, Timestep it) const
+{
+    const Point2D      centre = camera.Transform(_transform.GetScreenCoords(it));
+    const Dimensions2D size   = { static_cast<int>(_size.W + 0.5f), static_cast<int>(_size.H + 0.5f) };
+    return { centre.X - size.W / 2, centre.Y - size.H / 2, size.W, size.H };
+}
+
 RectangleF
 BoxObject::GetCollissionRect(void) const
 {
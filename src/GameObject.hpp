@@ -2,9 +2,10 @@
 #define GAMEOBJECT_HPP
 
 #include "Camera.hpp"
+#include "Command.hpp"
 #include "Constants.hpp"
 #include "Geometry.hpp"
-#include "Renderer.hpp"
+#include "RenderQueue.hpp"
 #include "Timetools.hpp"
 #include "Transform.hpp"
 #include "Physics.hpp"
@@ -29,8 +30,22 @@ class OnGroundState;
 class GameObjectState
 {
 public:
-    //enum class STATES : size_t { FALLING = 0, JUMPING, ON_GROUND };
+    enum class STATES : size_t { FALLING = 0, JUMPING, ON_GROUND };
 
+    /// The type and the data of a state, from which an equal state can be created.
+    struct Snapshot
+    {
+        STATES State;
+        size_t JumpsLeft; // JUMPING
+        float  YBound;    // ON_GROUND
+        float  XBound;    // ON_GROUND
+        float  XWidth;    // ON_GROUND
+    };
+
+    /// @return A new state allocated with new, equal to the one the snapshot was taken of.
+    static GameObjectState* CreateFromSnapshot(const Snapshot& snapshot);
+
+public:
     GameObjectState(void) = default;
     GameObjectState(const GameObjectState& other) = delete;
     GameObjectState(GameObjectState&& other)      = delete;
@@ -40,6 +55,11 @@ public:
     virtual GameObjectState* HandleInput(InputComponent& inputCmp) = 0;
     virtual GameObjectState* HandleCollisions(PlayerObject* parent, GameObject* obj) = 0;
 
+    /// Called when the world origin is moved, states that hold world coordinates must move them along.
+    virtual void TranslateX(float dx);
+
+    virtual Snapshot TakeSnapshot(void) const = 0;
+
 protected:
     static FallingState  s_falling;
     static JumpingState  s_jumping;
@@ -49,6 +69,12 @@ protected:
 
 class FallingState : public GameObjectState
 {
+public:
+    /// The keys the state handles, in the order they are handled.
+    inline static const std::vector<Input::KeyCode> KEYS = {
+        Input::KeyCode::UP, Input::KeyCode::DOWN, Input::KeyCode::LEFT, Input::KeyCode::RIGHT
+    };
+
 public:
     //FallingState(void);
     //FallingState(const FallingState& other) = delete;
@@ -57,6 +83,7 @@ public:
     virtual GameObjectState* HandleUpdate(PlayerObject* parent, const Physics& physics, Dimensions2D boundaries, Timestep dt) override;
     virtual GameObjectState* HandleInput(InputComponent& inputCmp) override;
     virtual GameObjectState* HandleCollisions(PlayerObject* parent, GameObject* obj) override;
+    virtual Snapshot TakeSnapshot(void) const override;
 
 private:
 
@@ -64,6 +91,15 @@ private:
 
 class JumpingState : public GameObjectState
 {
+public:
+    /// The keys the state handles, in the order they are handled, without and with jumps left.
+    inline static const std::vector<Input::KeyCode> KEYS = {
+        Input::KeyCode::LEFT, Input::KeyCode::RIGHT, Input::KeyCode::DOWN
+    };
+    inline static const std::vector<Input::KeyCode> KEYS_WITH_JUMPS = {
+        Input::KeyCode::LEFT, Input::KeyCode::RIGHT, Input::KeyCode::DOWN, Input::KeyCode::UP, Input::KeyCode::SPACE
+    };
+
 public:
     JumpingState(size_t jumpsCount);
     //JumpingState(const JumpingState& other) = delete;
@@ -72,6 +108,7 @@ public:
     virtual GameObjectState* HandleUpdate(PlayerObject* parent, const Physics& physics, Dimensions2D boundaries, Timestep dt) override;
     virtual GameObjectState* HandleInput(InputComponent& inputCmp) override;
     virtual GameObjectState* HandleCollisions(PlayerObject* parent, GameObject* obj) override;
+    virtual Snapshot TakeSnapshot(void) const override;
 
 private:
     size_t _jumpsLeft;
@@ -80,6 +117,12 @@ private:
 
 class OnGroundState : public GameObjectState
 {
+public:
+    /// The keys the state handles, in the order they are handled.
+    inline static const std::vector<Input::KeyCode> KEYS = {
+        Input::KeyCode::UP, Input::KeyCode::DOWN, Input::KeyCode::LEFT, Input::KeyCode::RIGHT, Input::KeyCode::SPACE
+    };
+
 public:
     OnGroundState(float yBound, float xBound, float xWidth);
     //OnGroundState(const OnGroundState& other) = delete;
@@ -88,6 +131,8 @@ public:
     virtual GameObjectState* HandleUpdate(PlayerObject* parent, const Physics& physics, Dimensions2D boundaries, Timestep dt) override;
     virtual GameObjectState* HandleInput(InputComponent& inputCmp) override;
     virtual GameObjectState* HandleCollisions(PlayerObject* parent, GameObject* obj) override;
+    virtual void TranslateX(float dx) override;
+    virtual Snapshot TakeSnapshot(void) const override;
 
 private:
     float _yBound; // The "height" of the ground under the player.
@@ -97,46 +142,6 @@ private:
 };
 
 
-class Command
-{
-public:
-    Command(void) = default;
-    Command(const Command& other) = delete;
-    Command(Command&& other)      = delete;
-    virtual ~Command(void) = default;
-    virtual void ExecuteMovement(Transform& transform) const = 0;
-
-private:
-
-};
-
-class NullCommand : public Command
-{
-public:
-    virtual void ExecuteMovement(Transform& transform) const override;
-private:
-
-};
-
-class JumpCommand : public Command
-{
-public:
-    virtual void ExecuteMovement(Transform& transform) const override;
-private:
-
-};
-
-class MoveCommand : public Command
-{
-public:
-    MoveCommand(Physics::Direction direction);
-    virtual void ExecuteMovement(Transform& transform) const override;
-
-private:
-    Physics::Direction _direction;
-
-};
-
 class InputComponent
 {
 public:
@@ -165,7 +170,7 @@ public:
     ~GraphicsComponent(void) = default;
 
     void SetParent(const GameObject* parent);
-    void Draw(const Renderer& renderer, const Camera& camera, Timestep it) const;
+    void Draw(RenderQueue& queue, const Camera& camera, Timestep it) const;
 
 private:
     const GameObject* _parent;
@@ -177,7 +182,17 @@ private:
 class GameObject : public DrawableObject
 {
 public:
-    static std::unique_ptr<PlayerObject> CreatePlayer(Input& input, float posX, float posY, float moveSpeed, float radius, Sound& jumpSound, Color color);
+    /// All of the mutable state of the object.
+    struct Snapshot
+    {
+        PhysicsObject::Snapshot   Transform;
+        GameObjectState::Snapshot State;
+        Color                     ObjectColor;
+    };
+
+public:
+    /// @param jumpSound The sound played when jumping, nullptr for a silent player.
+    static std::unique_ptr<PlayerObject> CreatePlayer(Input& input, float posX, float posY, float moveSpeed, float radius, Sound* jumpSound, Color color);
     static std::unique_ptr<GameObject>   CreateBox(Input& input, float moveSpeed, Point2DF position, Dimensions2DF size);
 
 public:
@@ -196,9 +211,17 @@ public:
     void SetYVelocityStopped(void);
     void SetPosition(float xPos, float yPos);
 
+    /// Moves the object, along with any world coordinates held by its state, dx units along the x-axis.
+    void TranslateX(float dx);
+
     void  SetColor(Color color);
     Color GetColor(void) const;
 
+    Snapshot TakeSnapshot(void) const;
+
+    /// Restores the object to the state it had when the snapshot was taken.
+    void     RestoreSnapshot(const Snapshot& snapshot);
+
     virtual void HandleInput(void) = 0;
 
     /// Update the status of the object.
@@ -212,10 +235,10 @@ public:
     void ApplyForce(Physics::Direction direction, float force);
     void ApplyForce(float angleDegrees, float force);
 
-    /// Draws the object on the renderers current target buffer
-    /// @param renderer Renderer to use.
+    /// Submits the draw commands of the object
+    /// @param queue The queue of the frame.
     /// @param it Interpolation timestep for correcting position between updates.
-    virtual void Draw(const Renderer& renderer, const Camera& camera, Timestep it) const override;
+    virtual void Draw(RenderQueue& queue, const Camera& camera, Timestep it) const override;
 
 protected:
     InputComponent    _inputComponent;
@@ -230,7 +253,7 @@ protected:
 class PlayerObject : public GameObject
 {
 public:
-    PlayerObject(Input& input, float posX, float posY, float moveSpeed, float radius, Sound& jumpSound, Color color);
+    PlayerObject(Input& input, float posX, float posY, float moveSpeed, float radius, Sound* jumpSound, Color color);
     PlayerObject(const PlayerObject& other) = delete;
     PlayerObject(PlayerObject&& other) = delete;
     ~PlayerObject(void) = default;
@@ -244,6 +267,10 @@ public:
     /// @return true if there was a hit, false otherwise.
     bool CheckHitAndBounce(GameObject* obj);
 
+    /// Replaces the x bounds of the ground the player is standing on, after which it falls.
+    /// Does nothing if the player is not on the ground.
+    void SetGroundBounds(float xBound, float xWidth);
+
     void BounceYAxis(void);
     void PlayJumpingSound(void);
 
@@ -254,7 +281,7 @@ public:
 
 private:
     float _radius;
-    Sound& _soundJump;
+    Sound* _soundJump; // nullptr = silent
 
 };
 
@@ -268,6 +295,10 @@ public:
     ~BoxObject(void) = default;
 
     Dimensions2DF GetSize(void) const;
+    void          SetSize(Dimensions2DF size);
+
+    /// @return The rectangle the box is drawn as, in the coordinates of the screen.
+    Rectangle     GetScreenRect(const Camera& camera, Timestep it) const;
 
     virtual void HandleInput(void) override;
     virtual void Update(const Physics& physics, Dimensions2D boundaries, Timestep dt) override;
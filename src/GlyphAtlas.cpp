@@ -0,0 +1,112 @@
+#include "GlyphAtlas.hpp"
+#include "Logger.hpp"
+
+#include <SDL_ttf.h>
+#include <algorithm>
+#include <initializer_list>
+
+
+GlyphAtlas::GlyphAtlas(const Font& font, const Renderer& renderer, const std::string& characters)
+    : _atlas({ 512, 512 })
+    , _textures(characters.size())
+    , _glyphs()
+    , _lineHeight(0)
+    , _vertices()
+    , _indices()
+{
+    for (Glyph& glyph : _glyphs) {
+        glyph = { nullptr, { 0, 0 }, 0.0f, 0.0f, 0.0f, 0.0f };
+    }
+
+    // Rendering the characters one by one gives their advance as the width of the surfaces
+    const SDL_Color white = { 255, 255, 255, 255 };
+    for (size_t i = 0; i < characters.size(); ++i)
+    {
+        const char   text[2] = { characters[i], '\0' };
+        SDL_Surface* surface = TTF_RenderText_Solid(font.GetFont(), text, white);
+        if (surface == nullptr)
+        {
+            Logger::Debug("TTF_RenderText failed to render glyph '{}': {}", characters[i], TTF_GetError());
+            continue;
+        }
+
+        Texture& texture = _textures[i];
+        const bool added = _atlas.Add(renderer, surface, texture);
+        SDL_FreeSurface(surface);
+        if (!added) {
+            continue;
+        }
+
+        const SDL_Rect     region      = texture.GetRegion();
+        const Dimensions2D textureSize = texture.IsRegion() ? _atlas.GetPageSize() : texture.GetSize();
+        const float        w           = static_cast<float>(textureSize.W);
+        const float        h           = static_cast<float>(textureSize.H);
+        _glyphs[static_cast<unsigned char>(characters[i])] = {
+            texture.GetTexture(), { region.w, region.h },
+            static_cast<float>(region.x) / w,            static_cast<float>(region.y) / h,
+            static_cast<float>(region.x + region.w) / w, static_cast<float>(region.y + region.h) / h
+        };
+        _lineHeight = std::max(_lineHeight, region.h);
+    }
+}
+
+Dimensions2D
+GlyphAtlas::Draw(RenderQueue& queue, RenderQueue::Layer layer, const std::string& text,
+                 Point2D position, Color color) const
+{
+    const SDL_Color vertexColor = { color.r, color.g, color.b, color.a };
+    Dimensions2D    size        = { 0, 0 };
+    SDL_Texture*    texture     = nullptr;
+
+    _vertices.clear();
+    _indices.clear();
+    for (const char c : text)
+    {
+        const Glyph& glyph = _glyphs[static_cast<unsigned char>(c)];
+        if (glyph.GlyphTexture == nullptr) {
+            continue;
+        }
+        if (glyph.GlyphTexture != texture)
+        {
+            submit(queue, layer, texture);
+            texture = glyph.GlyphTexture;
+        }
+
+        const float x0   = static_cast<float>(position.X + size.W);
+        const float y0   = static_cast<float>(position.Y);
+        const float x1   = x0 + static_cast<float>(glyph.Size.W);
+        const float y1   = y0 + static_cast<float>(glyph.Size.H);
+        const int   base = static_cast<int>(_vertices.size());
+        _vertices.push_back({ { x0, y0 }, vertexColor, { glyph.U0, glyph.V0 } });
+        _vertices.push_back({ { x1, y0 }, vertexColor, { glyph.U1, glyph.V0 } });
+        _vertices.push_back({ { x1, y1 }, vertexColor, { glyph.U1, glyph.V1 } });
+        _vertices.push_back({ { x0, y1 }, vertexColor, { glyph.U0, glyph.V1 } });
+        for (const int index : { 0, 1, 2, 2, 3, 0 }) {
+            _indices.push_back(base + index);
+        }
+
+        size.W += glyph.Size.W;
+        size.H  = std::max(size.H, glyph.Size.H);
+    }
+    submit(queue, layer, texture);
+
+    return size;
+}
+
+int
+GlyphAtlas::GetLineHeight(void) const { return _lineHeight; }
+
+// Private methods
+
+void
+GlyphAtlas::submit(RenderQueue& queue, RenderQueue::Layer layer, SDL_Texture* texture) const
+{
+    if (_vertices.empty()) {
+        return;
+    }
+
+    queue.Geometry(layer, texture, _vertices.data(), static_cast<int>(_vertices.size()),
+                   _indices.data(), static_cast<int>(_indices.size()));
+    _vertices.clear();
+    _indices.clear();
+}
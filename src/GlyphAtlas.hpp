@@ -0,0 +1,63 @@
+#ifndef GLYPHATLAS_HPP
+#define GLYPHATLAS_HPP
+
+#include "Color.hpp"
+#include "Font.hpp"
+#include "Geometry.hpp"
+#include "RenderQueue.hpp"
+#include "Renderer.hpp"
+#include "Texture.hpp"
+#include "TextureAtlas.hpp"
+
+#include <SDL.h>
+#include <array>
+#include <string>
+#include <vector>
+
+
+/// The glyphs of a set of characters of a font, rasterized once in white into a texture atlas. Strings
+/// of the characters are drawn as a batch of textured quads, and their color is applied by modulating
+/// the colors of the vertices. Changing the text or its color thus neither rasterizes nor creates
+/// textures, which suits text that changes often, like the values of the HUD.
+class GlyphAtlas
+{
+public:
+    inline static constexpr const char* DEFAULT_CHARACTERS = " 0123456789-:.ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+
+    GlyphAtlas(const Font& font, const Renderer& renderer, const std::string& characters = DEFAULT_CHARACTERS);
+    GlyphAtlas(const GlyphAtlas& other) = delete;
+    GlyphAtlas(GlyphAtlas&& other)      = delete;
+    ~GlyphAtlas(void) = default;
+
+    /// Submits the quads of text with its top left corner at position. The characters that are not in
+    /// the atlas are skipped.
+    /// @return The size of the text.
+    Dimensions2D Draw(RenderQueue& queue, RenderQueue::Layer layer, const std::string& text,
+                      Point2D position, Color color) const;
+
+    /// @return The height of the tallest glyph.
+    int GetLineHeight(void) const;
+
+private:
+    struct Glyph
+    {
+        SDL_Texture* GlyphTexture; // nullptr if the character is not in the atlas
+        Dimensions2D Size;
+        float        U0, V0, U1, V1;
+    };
+
+    /// Submits the quads collected since the last call, which share texture.
+    void submit(RenderQueue& queue, RenderQueue::Layer layer, SDL_Texture* texture) const;
+
+private:
+    TextureAtlas           _atlas;
+    std::vector<Texture>   _textures; // The regions of the glyphs, in the order of the characters
+    std::array<Glyph, 256> _glyphs;   // Indexed by the characters
+    int                    _lineHeight;
+
+    mutable std::vector<SDL_Vertex> _vertices;
+    mutable std::vector<int>        _indices;
+
+};
+
+#endif // GLYPHATLAS_HPP
@@ -0,0 +1,119 @@
+#include "Heightfield.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+
+Heightfield::Heightfield(float bottom)
+    : _spans()
+    , _ends()
+    , _bottom(bottom)
+{ }
+
+void
+Heightfield::Clear(void)
+{
+    _spans.clear();
+    _ends.clear();
+}
+
+void
+Heightfield::Add(const RectangleF& block, size_t id)
+{
+    const Span span = { block.X, block.X + block.W, block.Y, id };
+    assert(_spans.empty() || (_spans.back().XStart <= span.XStart && _spans.back().XEnd <= span.XEnd));
+    _spans.push_back(span);
+    _ends.push_back(span.XEnd);
+}
+
+void
+Heightfield::TranslateX(float dx)
+{
+    for (Span& span : _spans)
+    {
+        span.XStart += dx;
+        span.XEnd   += dx;
+    }
+    for (float& end : _ends) {
+        end += dx;
+    }
+}
+
+void
+Heightfield::QueryOverlaps(const RectangleF& rect, const QueryCallback& callback) const
+{
+    if (rect.Y > _bottom) {
+        return;
+    }
+
+    const float right  = rect.X + rect.W;
+    const float bottom = rect.Y + rect.H;
+    for (size_t i = firstEndingAfter(rect.X); i < _spans.size() && _spans[i].XStart <= right; ++i) {
+        if (_spans[i].TopY <= bottom && !callback(_spans[i])) {
+            return;
+        }
+    }
+}
+
+float
+Heightfield::GetGroundY(float x) const
+{
+    float groundY = _bottom;
+    for (size_t i = firstEndingAfter(x); i < _spans.size() && _spans[i].XStart <= x; ++i) {
+        groundY = std::min(groundY, _spans[i].TopY);
+    }
+    return groundY;
+}
+
+std::pair<float, float>
+Heightfield::GetRunBounds(const Span& span) const
+{
+    assert(_spans.data() <= &span && &span < _spans.data() + _spans.size());
+    size_t first = static_cast<size_t>(&span - _spans.data());
+    size_t last  = first;
+    while (first > 0 && touches(_spans[first - 1], _spans[first])) {
+        --first;
+    }
+    while (last + 1 < _spans.size() && touches(_spans[last], _spans[last + 1])) {
+        ++last;
+    }
+    return { _spans[first].XStart, _spans[last].XEnd };
+}
+
+size_t
+Heightfield::GetCount(void) const { return _spans.size(); }
+
+const Heightfield::Span&
+Heightfield::GetSpan(size_t index) const
+{
+    assert(index < _spans.size());
+    return _spans[index];
+}
+
+float
+Heightfield::GetBottom(void) const { return _bottom; }
+
+// Private methods
+
+size_t
+Heightfield::firstEndingAfter(float x) const
+{
+    // Branchless, the comparisons of a random x are unpredictable
+    const float* ends  = _ends.data();
+    size_t       first = 0;
+    size_t       count = _ends.size();
+    while (count > 1)
+    {
+        const size_t half = count / 2;
+        first += ends[first + half - 1] < x ? half : 0;
+        count -= half;
+    }
+    return count == 1 && ends[first] < x ? first + 1 : first;
+}
+
+bool
+Heightfield::touches(const Span& left, const Span& right) const
+{
+    return right.XStart <= left.XEnd + TOUCH_TOLERANCE && std::abs(right.TopY - left.TopY) <= TOUCH_TOLERANCE;
+}
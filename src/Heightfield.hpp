@@ -0,0 +1,79 @@
+#ifndef HEIGHTFIELD_HPP
+#define HEIGHTFIELD_HPP
+
+#include "Geometry.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <utility>
+#include <vector>
+
+
+/// The terrain of a level as a function of x. Every block of the terrain stands on the bottom of the
+/// level, so a block is fully described by the run [XStart, XEnd] on the x-axis and the y-coordinate of
+/// its top. The runs are stored sorted by x, so the blocks under a rectangle are found with a binary
+/// search instead of testing the rectangle of every block.
+class Heightfield
+{
+public:
+    struct Span
+    {
+        float  XStart;
+        float  XEnd;
+        float  TopY;
+        size_t Id; // Identifies the block to the caller
+    };
+
+    /// Called with every span found by a query.
+    /// @return false to end the query.
+    using QueryCallback = std::function<bool(const Span& span)>;
+
+public:
+    // Neighbouring spans closer than this, and tops closer than this, are considered touching
+    inline static constexpr float TOUCH_TOLERANCE = 0.01f;
+
+public:
+    /// @param bottom The y-coordinate of the bottom of the level, on which every block stands.
+    Heightfield(float bottom);
+    Heightfield(const Heightfield& other) = delete;
+    Heightfield(Heightfield&& other)      = delete;
+    ~Heightfield(void) = default;
+
+    void Clear(void);
+
+    /// Appends a block standing on the bottom. The blocks must be added in ascending order of both
+    /// their left and right edges, neighbouring blocks may overlap slightly.
+    void Add(const RectangleF& block, size_t id);
+
+    /// Moves every span dx units along the x-axis.
+    void TranslateX(float dx);
+
+    /// Calls callback for every span whose block overlaps rect, in ascending order of x.
+    /// Overlapping is inclusive like RectangleF::Overlaps.
+    void QueryOverlaps(const RectangleF& rect, const QueryCallback& callback) const;
+
+    /// @return The highest top of the blocks at x, or the bottom if there are none.
+    float GetGroundY(float x) const;
+
+    /// @return The x-range of the run of touching spans of the same height that span belongs to,
+    ///         the ground that can be walked on without falling.
+    std::pair<float, float> GetRunBounds(const Span& span) const;
+
+    size_t      GetCount(void)           const;
+    const Span& GetSpan(size_t index)    const;
+    float       GetBottom(void)          const;
+
+private:
+    /// @return The index of the first span that ends at or after x.
+    size_t firstEndingAfter(float x) const;
+
+    bool   touches(const Span& left, const Span& right) const;
+
+private:
+    std::vector<Span>  _spans;
+    std::vector<float> _ends;   // The XEnd of every span, packed densely for the binary search
+    float              _bottom;
+
+};
+
+#endif // HEIGHTFIELD_HPP
@@ -1,7 +1,6 @@
 #include "Helpers.hpp"
 
 
-#include <cstdlib> // srand, rand
 #include <cassert>
 
 
@@ -33,17 +32,46 @@ namespace Helpers
         return strBuf;
     }
 
+    random::Generator::Generator(unsigned int seed)
+        : _engine(seed)
+        , _seed(seed)
+        , _drawsCount(0)
+    {
+        //
+    }
+
     void
-    random::Seed(unsigned int seed)
+    random::Generator::Seed(unsigned int seed)
     {
-        std::srand(seed);
+        _engine.seed(seed);
+        _seed       = seed;
+        _drawsCount = 0;
     }
 
     float
-    random::FloatInRange(float min, float max)
+    random::Generator::FloatInRange(float min, float max)
     {
         assert(max - min > 0.0f);
-        return min + ((max - min) * (static_cast<float>(std::rand()) / static_cast<float>(RAND_MAX)));
+        // Not using std::uniform_real_distribution, its output is implementation defined
+        ++_drawsCount;
+        const double unit = static_cast<double>(_engine() - std::mt19937::min())
+                          / static_cast<double>(std::mt19937::max() - std::mt19937::min());
+        return min + ((max - min) * static_cast<float>(unit));
+    }
+
+    unsigned int
+    random::Generator::GetSeed(void) const { return _seed; }
+
+    uint64_t
+    random::Generator::GetDrawsCount(void) const { return _drawsCount; }
+
+    void
+    random::Generator::Rewind(uint64_t drawsCount)
+    {
+        // Every draw advances the engine exactly once
+        _engine.seed(_seed);
+        _engine.discard(drawsCount);
+        _drawsCount = drawsCount;
     }
 
 } // end namespace Helpers
@@ -2,6 +2,8 @@
 #define HELPERS_HPP
 
 #include <utility> // std::pair
+#include <cstdint>
+#include <random>
 #include <string>
 #include <string_view>
 
@@ -38,10 +40,37 @@ namespace Helpers
 
     namespace random
     {
-        void  Seed(unsigned int seed);
+        /// A seedable pseudo random number generator. Every generator owns its state, so generators
+        /// used by different threads never affect each other. Unlike std::rand, the generated sequence
+        /// is the same on every platform.
+        class Generator
+        {
+        public:
+            Generator(unsigned int seed);
+            Generator(const Generator& other) = delete;
+            Generator(Generator&& other)      = delete;
+            ~Generator(void) = default;
+
+            void  Seed(unsigned int seed);
+
+            /// @return A random float in the closed range [min, max]
+            float FloatInRange(float min, float max);
+
+            unsigned int GetSeed(void)       const;
+
+            /// @return The amount of numbers generated since the generator was seeded.
+            uint64_t     GetDrawsCount(void) const;
+
+            /// Moves the generator to the state it had after drawsCount numbers had been generated since
+            /// seeding, so the state can be saved as two integers instead of the whole engine state.
+            void         Rewind(uint64_t drawsCount);
+
+        private:
+            std::mt19937 _engine;
+            unsigned int _seed;
+            uint64_t     _drawsCount;
 
-        /// @return A random float in the closed range [min, max]
-        float FloatInRange(float min, float max);
+        };
 
     } // end namespace Helpers::random
 
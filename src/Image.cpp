@@ -27,6 +27,9 @@ Image::~Image(void)
 void
 Image::UpdateTexture(const Renderer& renderer)
 {
+    if (_imageTexture.GetTexture() != nullptr) {
+        return;
+    }
     _imageTexture.CreateTexture(renderer, _imageSurf);
 }
 
@@ -16,6 +16,7 @@ public:
     Image(Image&& other)      = delete; // Move constructor
     ~Image(void);
 
+    /// Creates the texture, unless it has been created already. The images are shared by the menus.
     void UpdateTexture(const Renderer& renderer);
 
     const SDL_Surface* GetSurface(void) const;
@@ -76,6 +76,12 @@ Input::UseObjectCallbacks(std::shared_ptr<ObjectMappedInputCallbacks> callbacks)
     _objectCallbacks = callbacks;
 }
 
+void
+Input::SetKeyPressed(Input::KeyCode key, bool isPressed)
+{
+    _keyStatus[key] = isPressed;
+}
+
 bool
 Input::IsPressed(Input::KeyCode key) const
 {
@@ -102,7 +108,7 @@ void
 Input::setKeyPressed(SDL_Event* e, bool isPressed)
 {
     assert(e->type == SDL_KEYDOWN || e->type == SDL_KEYUP);
-    _keyStatus[static_cast<KeyCode>(e->key.keysym.sym)] = isPressed;
+    SetKeyPressed(static_cast<KeyCode>(e->key.keysym.sym), isPressed);
 }
 
 void
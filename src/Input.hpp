@@ -98,6 +98,10 @@ public:
 
     void UseObjectCallbacks(std::shared_ptr<ObjectMappedInputCallbacks> callbacks);
 
+    /// Sets the status of a key without any SDL event, used for feeding input from other sources than
+    /// the keyboard. No callbacks are called.
+    void SetKeyPressed(Input::KeyCode key, bool isPressed);
+
     bool IsPressed(Input::KeyCode key)        const;
     bool IsPressed(Input::MouseButton button) const;
     Point2D GetMousePos(void) const;
@@ -35,7 +35,7 @@ Label::Label(const Font& font, std::string text, Color color, Point2D position,
         { position.X, position.Y, _textSurfaces[0]->w, _textSurfaces[0]->h }, // Not selected
         { position.X, position.Y, _textSurfaces[1]->w, _textSurfaces[1]->h }  // Selected
     } }
-    , _textTexture()
+    , _textTextures()
 {
     for (const auto& surface : _textSurfaces) {
         if (surface == nullptr) {
@@ -51,7 +51,7 @@ Label::Label(Label&& other) noexcept
     , _text(std::move(other._text))
     , _textSurfaces(std::move(other._textSurfaces))
     , _textRectangles(std::move(other._textRectangles))
-    , _textTexture(std::move(other._textTexture))
+    , _textTextures(std::move(other._textTextures))
 {
     for (auto& othersurf : other._textSurfaces) {
         othersurf = nullptr;
@@ -85,7 +85,7 @@ Label::GetSurface(void) const
 }
 
 const SDL_Texture*
-Label::GetTexture(void) const { return _textTexture.GetTexture(); }
+Label::GetTexture(void) const { return _textTextures.at(getSurfaceIndex(_activeSurface)).GetTexture(); }
 
 Point2D
 Label::GetCoords(void) const {
@@ -116,31 +116,38 @@ Label::SetIsSelected(bool selected)
 }
 
 void
-Label::UpdateTexture(const Renderer& renderer, bool setCentered)
+Label::UpdateTexture(const Renderer& renderer, bool setCentered, TextureAtlas* atlas)
 {
-    SDL_Surface* activeSurface = _textSurfaces.at(getSurfaceIndex(_activeSurface));
-    SDL_Rect& activeRectangle = _textRectangles.at(getSurfaceIndex(_activeSurface));
-
-    _textTexture.CreateTexture(renderer, activeSurface);
-
-    if (setCentered) {
-        activeRectangle.x = renderer.GetOutputSize().W / 2 - activeRectangle.w / 2;
-    } else {
-        activeRectangle.x = 0;
+    for (size_t i = 0; i < _textSurfaces.size(); ++i)
+    {
+        // A label that does not fit in the atlas is drawn from a texture of its own
+        if (atlas == nullptr || !atlas->Add(renderer, _textSurfaces[i], _textTextures[i])) {
+            _textTextures[i].CreateTexture(renderer, _textSurfaces[i]);
+        }
     }
+    SetCentered(renderer.GetOutputSize().W, setCentered);
 
     // TODO: Define a global that sets/unsets the blending mode when NDEBUG is not set
     //_textTexture.SetBlendMode(Texture::BlendMode::BLEND);
 }
 
+void
+Label::SetCentered(int width, bool setCentered)
+{
+    for (SDL_Rect& rectangle : _textRectangles) {
+        rectangle.x = setCentered ? width / 2 - rectangle.w / 2 : 0;
+    }
+}
+
 void
 Label::Render(const Renderer& renderer, bool ScaleToDstRect) const
 {
     const SDL_Rect& activeRectangle = _textRectangles.at(getSurfaceIndex(_activeSurface));
+    const Texture&  activeTexture   = _textTextures.at(getSurfaceIndex(_activeSurface));
     if (ScaleToDstRect) {
-        _textTexture.Render(renderer, nullptr, nullptr);
+        activeTexture.Render(renderer, nullptr, nullptr);
     } else {
-        _textTexture.Render(renderer, nullptr, &activeRectangle);
+        activeTexture.Render(renderer, nullptr, &activeRectangle);
     }
 }
 
@@ -4,6 +4,7 @@
 #include "Font.hpp"
 #include "Renderer.hpp"
 #include "Texture.hpp"
+#include "TextureAtlas.hpp"
 #include "Color.hpp"
 #include "Geometry.hpp"
 
@@ -13,9 +14,10 @@
 #include <array>
 
 
+/// Keeps a texture for each of the two selection states, so changing the selection switches between
+/// the textures instead of creating a new one.
 class Label
-{ // TODO: Update only the needed textures, 2 labels when switching active label and especially
-  //       background only when window size changes, instead of always updating every texture
+{
 private:
     enum class Selection : size_t { NOT_SELECTED = 0, SELECTED = 1 };
 
@@ -32,9 +34,14 @@ public:
     Dimensions2D GetDimensions(void) const;
     bool         GetIsSelected(void) const;
 
-    /// UpdateTexture MUST be called after this method has been called
     void SetIsSelected(bool selected);
-    void UpdateTexture(const Renderer& renderer, bool setCentered = false);
+
+    /// Creates the textures of both selection states.
+    /// @param atlas The atlas to add the textures to, nullptr = the label owns the textures.
+    void UpdateTexture(const Renderer& renderer, bool setCentered = false, TextureAtlas* atlas = nullptr);
+
+    /// Centres the label on the x-axis of a target of width, or aligns it to the left edge.
+    void SetCentered(int width, bool setCentered = true);
 
     void Render(const Renderer& renderer, bool ScaleToDstRect) const;
 
@@ -47,7 +54,7 @@ private:
     std::string  _text;
     std::array<SDL_Surface*, 2> _textSurfaces;
     std::array<SDL_Rect, 2>     _textRectangles;
-    Texture      _textTexture;
+    std::array<Texture, 2>      _textTextures;
 
 };
 
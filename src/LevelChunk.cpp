@@ -0,0 +1,109 @@
+#include "LevelChunk.hpp"
+#include "Constants.hpp"
+
+#include <cassert>
+
+
+LevelChunk::LevelChunk(void)
+    : _xStart(0.0f)
+    , _width(0.0f)
+    , _tileMap()
+    , _blocksUsed(0)
+    , _blocks()
+    , _colliders()
+{
+    //
+}
+
+void
+LevelChunk::Reset(float xStart, Dimensions2DF size, float tileSize)
+{
+    assert(size.W > 0.0f);
+    _xStart     = xStart;
+    _width      = size.W;
+    _blocksUsed = 0;
+    _tileMap.Reset(
+        { xStart, 0.0f },
+        static_cast<int>(size.W / tileSize),
+        static_cast<int>(size.H / tileSize),
+        tileSize
+    );
+}
+
+void
+LevelChunk::AddGroundBlock(RectangleF block)
+{
+    _tileMap.FillGroundBlock(block, Tileset::GROUND_TOP, Tileset::GROUND_FILL);
+}
+
+void
+LevelChunk::BuildBlocks(Input& input)
+{
+    _blocksUsed = 0;
+    _colliders.clear();
+    _tileMap.BuildColliders(_colliders);
+
+    for (const RectangleF& r : _colliders) {
+        addBlock(input, { r.X + 0.5f * r.W, r.Y + 0.5f * r.H }, { r.W, r.H });
+    }
+}
+
+void
+LevelChunk::TranslateX(float dx)
+{
+    _xStart += dx;
+    _tileMap.TranslateX(dx);
+    for (size_t i = 0; i < _blocksUsed; ++i) {
+        _blocks[i]->TranslateX(dx);
+    }
+}
+
+float
+LevelChunk::GetXStart(void) const { return _xStart; }
+
+float
+LevelChunk::GetXEnd(void) const { return _xStart + _width; }
+
+size_t
+LevelChunk::GetBlockCount(void) const { return _blocksUsed; }
+
+BoxObject*
+LevelChunk::GetBlock(size_t index) const
+{
+    assert(index < _blocksUsed);
+    return _blocks[index].get();
+}
+
+const TileMap&
+LevelChunk::GetTileMap(void) const { return _tileMap; }
+
+TileMap&
+LevelChunk::GetMutableTileMap(void) { return _tileMap; }
+
+void
+LevelChunk::Draw(RenderQueue& queue, const Camera& camera, const Tileset& tileset) const
+{
+    if (!camera.RectangleIsInViewport(_tileMap.GetRectangleF())) {
+        return;
+    }
+    _tileMap.Draw(queue, camera, tileset);
+}
+
+// Private methods
+void
+LevelChunk::addBlock(Input& input, Point2DF position, Dimensions2DF size)
+{
+    if (_blocksUsed < _blocks.size())
+    {
+        BoxObject* block = _blocks[_blocksUsed].get();
+        block->SetPosition(position.X, position.Y);
+        block->SetSize(size);
+        block->SetColor(Constants::Colors::DARK);
+    }
+    else
+    {
+        _blocks.push_back(std::make_unique<BoxObject>(input, position, size, 0.0f));
+    }
+
+    ++_blocksUsed;
+}
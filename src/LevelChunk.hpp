@@ -0,0 +1,70 @@
+#ifndef LEVELCHUNK_HPP
+#define LEVELCHUNK_HPP
+
+#include "Camera.hpp"
+#include "GameObject.hpp"
+#include "Geometry.hpp"
+#include "Input.hpp"
+#include "Renderer.hpp"
+#include "TileMap.hpp"
+#include "Tileset.hpp"
+
+#include <memory>
+#include <vector>
+
+
+/// A fixed width vertical slice of the level terrain, [xStart, xStart + width) on the x-axis.
+/// The terrain is stored as a TileMap, which is drawn as is and from which the collision blocks
+/// are built. The BoxObjects of a chunk are pooled: Reset() only marks them unused so that a
+/// recycled chunk reuses the already allocated objects when it is filled again.
+class LevelChunk
+{
+public:
+    LevelChunk(void);
+    LevelChunk(const LevelChunk& other) = delete;
+    LevelChunk(LevelChunk&& other)      = delete;
+    ~LevelChunk(void) = default;
+
+    /// Empties the chunk and moves it to a new location, keeps the pooled blocks allocated.
+    /// @param size The width and height of the chunk, should be multiples of tileSize.
+    void Reset(float xStart, Dimensions2DF size, float tileSize);
+
+    /// Adds a block standing on the bottom of the chunk to the tilemap. Parts of the block that
+    /// are outside of the chunk are clipped.
+    void AddGroundBlock(RectangleF block);
+
+    /// Rebuilds the collision blocks from the tilemap, must be called after adding ground blocks.
+    void BuildBlocks(Input& input);
+
+    /// Moves the chunk and all of its blocks dx units along the x-axis.
+    void TranslateX(float dx);
+
+    float GetXStart(void) const;
+    float GetXEnd(void)   const;
+
+    size_t     GetBlockCount(void)      const;
+    BoxObject* GetBlock(size_t index)   const;
+
+    const TileMap& GetTileMap(void) const;
+
+    /// Changes to the tilemap take effect after calling BuildBlocks.
+    TileMap&       GetMutableTileMap(void);
+
+    void Draw(RenderQueue& queue, const Camera& camera, const Tileset& tileset) const;
+
+private:
+    /// Adds a block to the chunk, reuses a pooled block if one is available.
+    /// @param position The center position of the block.
+    void addBlock(Input& input, Point2DF position, Dimensions2DF size);
+
+private:
+    float   _xStart;
+    float   _width;
+    TileMap _tileMap;
+    size_t  _blocksUsed;
+    std::vector<std::unique_ptr<BoxObject>> _blocks;
+    std::vector<RectangleF>                 _colliders; // Scratch buffer for BuildBlocks
+
+};
+
+#endif // LEVELCHUNK_HPP
@@ -0,0 +1,163 @@
+#include "LevelValidator.hpp"
+#include "Command.hpp"
+#include "Motion.hpp"
+#include "Transform.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <thread>
+
+
+JumpEnvelope::JumpEnvelope(const Physics& physics, float moveForce, float radius,
+                           Timestep dt, size_t updatesPerInput, float maxDrop)
+    : _radius(radius)
+    , _maxRise()
+{
+    assert(updatesPerInput > 0);
+    assert(maxDrop > 0.0f);
+
+    constexpr float unbounded = std::numeric_limits<float>::max();
+    const RectangleF boundaries = { -unbounded, -unbounded, unbounded, unbounded };
+
+    const JumpCommand jump;
+    const MoveCommand moveRight(Physics::Direction::EAST);
+    const MoveCommand moveUp(Physics::Direction::NORTH);
+
+    // Let the forces accumulated by the physics settle, as they would for a player standing on the ground
+    Transform transform(0.0f, 0.0f, moveForce);
+    for (size_t i = 0; i < SETTLE_UPDATES; ++i)
+    {
+        transform.UpdatePhysics(physics, boundaries, dt);
+        transform.SetPosition(glm::vec3(0.0f));
+        transform.SetVelocity(glm::vec3(0.0f));
+    }
+
+    std::vector<Point2DF> trajectory = { { 0.0f, 0.0f } };
+    size_t jumpsLeft = 1 + Motion::JUMPS_COUNT; // The jump from the ground and the ones of the JumpingState
+    bool   falling   = false;
+
+    while (trajectory.size() < MAX_UPDATES && trajectory.back().Y > -maxDrop)
+    { // Mirrors the keys that OnGroundState, JumpingState and FallingState handle
+        moveRight.ExecuteMovement(transform);
+        if (falling) {
+            moveUp.ExecuteMovement(transform);
+        } else if (jumpsLeft > 0) {
+            moveUp.ExecuteMovement(transform);
+            jump.ExecuteMovement(transform);
+            --jumpsLeft;
+        }
+
+        for (size_t i = 0; i < updatesPerInput; ++i)
+        {
+            transform.UpdatePhysics(physics, boundaries, dt);
+            falling = falling || transform.GetVelocity().y > 0.0f;
+            trajectory.push_back({ transform.GetPosition().x, -transform.GetPosition().y });
+        }
+    }
+
+    // The player can always slow down, so every rise reached at some distance can also be reached at any shorter distance
+    const float maxDistance = std::max(0.0f, trajectory.back().X);
+    _maxRise.assign(static_cast<size_t>(maxDistance) + 1, std::numeric_limits<float>::lowest());
+
+    float  best = std::numeric_limits<float>::lowest();
+    size_t i    = trajectory.size();
+    for (size_t dx = _maxRise.size(); dx-- > 0;)
+    {
+        while (i > 0 && trajectory[i - 1].X >= static_cast<float>(dx)) {
+            best = std::max(best, trajectory[--i].Y);
+        }
+        _maxRise[dx] = best;
+    }
+}
+
+float
+JumpEnvelope::GetMaxRise(float gap) const
+{
+    // The player can walk until its center is one radius past the edge, and lands when it overlaps the next block
+    const float distance = std::max(0.0f, gap - 2.0f * _radius);
+    const size_t index   = static_cast<size_t>(std::ceil(distance));
+    if (index >= _maxRise.size()) {
+        return std::numeric_limits<float>::lowest();
+    }
+    return _maxRise[index];
+}
+
+float
+JumpEnvelope::GetMaxGap(float rise) const
+{
+    // _maxRise is non-increasing, so the reachable distances form a prefix of it
+    const auto end = std::partition_point(_maxRise.begin(), _maxRise.end(), [rise](float maxRise) {
+        return maxRise >= rise;
+    });
+
+    if (end == _maxRise.begin()) {
+        return -1.0f;
+    }
+    return static_cast<float>(std::distance(_maxRise.begin(), end) - 1) + 2.0f * _radius;
+}
+
+bool
+JumpEnvelope::CanReach(const RectangleF& from, const RectangleF& to) const
+{
+    const float gap  = to.X - (from.X + from.W);
+    const float rise = from.Y - to.Y; // Y grows downwards
+    return GetMaxRise(gap) >= rise;
+}
+
+
+LevelValidator::LevelValidator(const JumpEnvelope& envelope, size_t threadsCount)
+    : _envelope(envelope)
+    , _threadsCount(threadsCount > 0 ? threadsCount : std::max(1u, std::thread::hardware_concurrency()))
+{
+    //
+}
+
+std::vector<size_t>
+LevelValidator::FindUnreachable(const std::vector<RectangleF>& blocks) const
+{
+    const size_t pairsCount   = blocks.size() < 2 ? 0 : blocks.size() - 1;
+    const size_t threadsCount = std::clamp(pairsCount / MIN_PAIRS_PER_THREAD, size_t(1), _threadsCount);
+    const size_t pairsPerThread = (pairsCount + threadsCount - 1) / threadsCount;
+
+    std::vector<std::vector<size_t>> results(threadsCount);
+    std::vector<std::thread>         workers;
+    workers.reserve(threadsCount - 1);
+
+    for (size_t t = 1; t < threadsCount; ++t)
+    {
+        const size_t begin = std::min(pairsCount, t * pairsPerThread);
+        const size_t end   = std::min(pairsCount, begin + pairsPerThread);
+        workers.emplace_back(&LevelValidator::findUnreachable, this, std::cref(blocks), begin, end, std::ref(results[t]));
+    }
+
+    // The calling thread validates the first range
+    findUnreachable(blocks, 0, std::min(pairsCount, pairsPerThread), results[0]);
+
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+
+    std::vector<size_t> unreachable = std::move(results[0]);
+    for (size_t t = 1; t < threadsCount; ++t) {
+        unreachable.insert(unreachable.end(), results[t].begin(), results[t].end());
+    }
+
+    return unreachable;
+}
+
+size_t
+LevelValidator::GetThreadsCount(void) const { return _threadsCount; }
+
+// Private methods
+void
+LevelValidator::findUnreachable(const std::vector<RectangleF>& blocks, size_t begin, size_t end,
+                                std::vector<size_t>& unreachable) const
+{
+    for (size_t i = begin; i < end; ++i) {
+        if (!_envelope.CanReach(blocks[i], blocks[i + 1])) {
+            unreachable.push_back(i);
+        }
+    }
+}
@@ -0,0 +1,83 @@
+#ifndef LEVELVALIDATOR_HPP
+#define LEVELVALIDATOR_HPP
+
+#include "Geometry.hpp"
+#include "Physics.hpp"
+#include "Timetools.hpp"
+
+#include <vector>
+
+
+/// The set of points the player can reach with one jump, sampled by simulating the jump with the
+/// same physics and movement commands that are used in the game. The jump starts standing still
+/// at the edge of a block, with the jump, right and up keys held for as long as the player states
+/// accept them. The envelope is stored as the highest reachable rise for every pixel of horizontal
+/// distance, so all queries are O(1) or O(log n).
+/// NOTE: All heights are rises, that is positive values are upwards.
+class JumpEnvelope
+{
+public:
+    /// @param physics The physics of the level.
+    /// @param moveForce The move force of the player.
+    /// @param radius The radius of the player.
+    /// @param dt The deltatime of one game state update.
+    /// @param updatesPerInput The amount of game state updates between two input handlings.
+    /// @param maxDrop The simulation ends when the player has fallen this far below the starting level.
+    JumpEnvelope(const Physics& physics, float moveForce, float radius,
+                 Timestep dt, size_t updatesPerInput, float maxDrop);
+    JumpEnvelope(const JumpEnvelope& other) = delete;
+    JumpEnvelope(JumpEnvelope&& other)      = delete;
+    ~JumpEnvelope(void) = default;
+
+    /// @param gap The horizontal distance between the edges of the blocks.
+    /// @return The highest rise that can be reached over the gap, the lowest float if none.
+    float GetMaxRise(float gap) const;
+
+    /// @param rise The height difference of the tops of the blocks.
+    /// @return The widest gap that can be jumped over with the rise, negative if none.
+    float GetMaxGap(float rise) const;
+
+    /// @return true if the player standing on from can jump onto to, which must be right of from.
+    bool  CanReach(const RectangleF& from, const RectangleF& to) const;
+
+private:
+    inline static constexpr size_t MAX_UPDATES    = 20000; // Ends the simulation if the player never falls
+    inline static constexpr size_t SETTLE_UPDATES = 200;
+
+    float              _radius;
+    std::vector<float> _maxRise; // Indexed by the horizontal distance travelled by the center of the player
+
+};
+
+
+/// Checks that every block of a level can be reached from the previous one. The block pairs are
+/// independent of each other, so they are split evenly between worker threads.
+class LevelValidator
+{
+public:
+    /// @param threadsCount The amount of threads to use, 0 = the amount of hardware threads.
+    LevelValidator(const JumpEnvelope& envelope, size_t threadsCount = 0);
+    LevelValidator(const LevelValidator& other) = delete;
+    LevelValidator(LevelValidator&& other)      = delete;
+    ~LevelValidator(void) = default;
+
+    /// @param blocks The blocks of the level, sorted by their x-coordinate.
+    /// @return The indices i in ascending order, for which blocks[i + 1] can not be reached from blocks[i].
+    std::vector<size_t> FindUnreachable(const std::vector<RectangleF>& blocks) const;
+
+    size_t GetThreadsCount(void) const;
+
+private:
+    // Spawning a thread costs more than validating a few thousand pairs
+    inline static constexpr size_t MIN_PAIRS_PER_THREAD = 4096;
+
+    void findUnreachable(const std::vector<RectangleF>& blocks, size_t begin, size_t end,
+                         std::vector<size_t>& unreachable) const;
+
+private:
+    const JumpEnvelope& _envelope;
+    size_t              _threadsCount;
+
+};
+
+#endif // LEVELVALIDATOR_HPP
@@ -1,11 +1,18 @@
 #include "Config.hpp" // defined in configuration/Config.hpp.in
+#include "BatchRunner.hpp"
 #include "Logger.hpp"
 #include "ResourceManager.hpp"
 #include "Sdl2.hpp"
 #include "Game.hpp"
 #include "Constants.hpp"
+#include "Replay.hpp"
 
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <memory>
 #include <string>
+#include <string_view>
 
 
 /* ************************************************************************** *
@@ -52,9 +59,76 @@ initialize([[maybe_unused]] int argc, [[maybe_unused]] char* argv[])
     return true;
 }
 
+/// Runs the headless batch evaluation of level seeds, without initializing any SDL subsystems.
+/// Usage: --batch [seedsCount] [threadsCount] [csvFilepath] [firstSeed]
+int
+runBatch(int argc, char* argv[])
+{
+    const size_t       seedsCount   = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 100;
+    const size_t       threadsCount = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 0;
+    const std::string  filepath     = argc > 4 ? argv[4] : "batch.csv";
+    const unsigned int firstSeed    = argc > 5 ? static_cast<unsigned int>(std::strtoul(argv[5], nullptr, 10)) : 0;
+
+    BatchRunner runner(threadsCount);
+    Logger::Info("Simulating {} seeds with {} threads", seedsCount, runner.GetThreadsCount());
+
+    // Every level logs when it is loaded, only log the summary
+    const Logger::Level logLevel = Logger::GetLogLevel();
+    Logger::SetLogLevel(Logger::Level::CRITICAL);
+    Timer timer(false);
+    const std::vector<BatchRunner::Result> results = runner.Run(firstSeed, seedsCount);
+    const double seconds = static_cast<double>(timer.Elapsed<std::chrono::milliseconds>()) / 1000.0;
+    Logger::SetLogLevel(logLevel);
+
+    const size_t completed = static_cast<size_t>(std::count_if(results.begin(), results.end(),
+        [](const BatchRunner::Result& r) { return r.Completed; }
+    ));
+    Logger::Info("Simulated {} seeds in {:.2f}s ({:.1f} seeds/s), {} completed",
+        seedsCount, seconds, static_cast<double>(seedsCount) / std::max(seconds, 0.001), completed);
+
+    if (!BatchRunner::WriteCsv(filepath, results)) {
+        return EXIT_FAILURE;
+    }
+    Logger::Info("Results written to \"{}\"", filepath);
+
+    return EXIT_SUCCESS;
+}
+
+/// Plays a recorded replay as fast as possible without a window or any rendering.
+/// Usage: --replay [filepath]
+int
+runReplay(int argc, char* argv[])
+{
+    const std::string filepath = argc > 2 ? argv[2] : Constants::Paths::REPLAY;
+    std::unique_ptr<Replay> replay = Replay::Open(filepath);
+    if (replay == nullptr) {
+        return EXIT_FAILURE;
+    }
+
+    const Logger::Level logLevel = Logger::GetLogLevel();
+    Logger::SetLogLevel(Logger::Level::CRITICAL);
+    const ReplayPlayer::Summary summary = ReplayPlayer::PlayHeadless(*replay);
+    Logger::SetLogLevel(logLevel);
+
+    Logger::Info("Played {} updates ({:.1f}s of game time) in {:.3f}s, {:.0f} updates/s",
+        summary.Updates, static_cast<double>(summary.Updates) / static_cast<double>(Constants::TARGET_UPS),
+        summary.Seconds, static_cast<double>(summary.Updates) / std::max(summary.Seconds, 0.000001));
+    Logger::Info("Score: {}, distance: {:.1f}, falls: {}, completed: {}",
+        summary.Score, summary.Distance, summary.Falls, summary.Completed);
+
+    return EXIT_SUCCESS;
+}
+
 int
 main(int argc, char* argv[])
 {
+    if (argc > 1 && std::string_view(argv[1]) == "--batch") {
+        return runBatch(argc, argv);
+    }
+    if (argc > 1 && std::string_view(argv[1]) == "--replay") {
+        return runReplay(argc, argv);
+    }
+
     if (!initialize(argc, argv)) {
         Logger::Critical("Errors while initializing, terminating!");
         return EXIT_FAILURE;
@@ -64,6 +138,34 @@ main(int argc, char* argv[])
     Sdl2 sdl2(Constants::SCREEN_TITLE, Constants::RENDER_SIZE, resourceManager);
     Game game(sdl2, resourceManager);
 
+    // Usage: [--watch filepath [startSeconds]] [--fast-forward [renderInterval]] [--render-thread] [--bots count]
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string_view arg = argv[i];
+        const bool hasNumber = i + 1 < argc && std::isdigit(static_cast<unsigned char>(argv[i + 1][0]));
+
+        if (arg == "--watch" && i + 1 < argc)
+        {
+            const std::string filepath = argv[++i];
+            const double startSeconds  = i + 1 < argc && std::isdigit(static_cast<unsigned char>(argv[i + 1][0]))
+                                       ? std::strtod(argv[++i], nullptr) : 0.0;
+            if (!game.LoadReplay(filepath, startSeconds)) {
+                return EXIT_FAILURE;
+            }
+        }
+        else if (arg == "--fast-forward")
+        {
+            game.SetFastForward(hasNumber ? std::strtoul(argv[++i], nullptr, 10) : Constants::FAST_FORWARD_RENDER_INTERVAL);
+        }
+        else if (arg == "--render-thread")
+        {
+            game.SetRenderThread(true);
+        }
+        else if (arg == "--bots" && hasNumber)
+        {
+            game.SetBotsCount(std::strtoul(argv[++i], nullptr, 10));
+        }
+    }
     game.Run();
 
     return EXIT_SUCCESS;
@@ -0,0 +1,77 @@
+#include "MappedFile.hpp"
+#include "Logger.hpp"
+#include "StateSerializer.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+    #define MAPPEDFILE_MMAP
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+
+std::unique_ptr<MappedFile>
+MappedFile::Open(const std::string& filepath)
+{ // Static function
+    std::unique_ptr<MappedFile> file(new MappedFile());
+
+#ifdef MAPPEDFILE_MMAP
+    const int fd = ::open(filepath.c_str(), O_RDONLY);
+    if (fd < 0) {
+        Logger::Critical("Unable to open \"{}\" for reading", filepath);
+        return nullptr;
+    }
+
+    struct stat info;
+    if (::fstat(fd, &info) != 0 || info.st_size <= 0) {
+        ::close(fd);
+        Logger::Critical("Unable to map \"{}\": the file is empty or its size is unknown", filepath);
+        return nullptr;
+    }
+
+    const size_t size = static_cast<size_t>(info.st_size);
+    void* data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd); // The mapping keeps the file open
+    if (data == MAP_FAILED) {
+        Logger::Critical("Unable to map \"{}\"", filepath);
+        return nullptr;
+    }
+
+    file->_data = static_cast<const uint8_t*>(data);
+    file->_size = size;
+#else
+    if (!StateReader::ReadFile(filepath, file->_buffer) || file->_buffer.empty()) {
+        return nullptr;
+    }
+
+    file->_data = file->_buffer.data();
+    file->_size = file->_buffer.size();
+#endif
+
+    return file;
+}
+
+MappedFile::~MappedFile(void)
+{
+#ifdef MAPPEDFILE_MMAP
+    if (_data != nullptr) {
+        ::munmap(const_cast<uint8_t*>(_data), _size);
+    }
+#endif
+}
+
+const uint8_t*
+MappedFile::GetData(void) const { return _data; }
+
+size_t
+MappedFile::GetSize(void) const { return _size; }
+
+// Private methods
+MappedFile::MappedFile(void)
+    : _data(nullptr)
+    , _size(0)
+    , _buffer()
+{
+    //
+}
@@ -0,0 +1,36 @@
+#ifndef MAPPEDFILE_HPP
+#define MAPPEDFILE_HPP
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+
+/// A read-only view of the whole contents of a file. On POSIX systems the file is memory mapped, so
+/// opening a large file is instant and only the pages that are actually read are loaded from the
+/// disk. On other systems the file is read into memory.
+class MappedFile
+{
+public:
+    /// @return The opened file, nullptr if it could not be opened or is empty.
+    static std::unique_ptr<MappedFile> Open(const std::string& filepath);
+
+    MappedFile(const MappedFile& other) = delete;
+    MappedFile(MappedFile&& other)      = delete;
+    ~MappedFile(void);
+
+    const uint8_t* GetData(void) const;
+    size_t         GetSize(void) const;
+
+private:
+    MappedFile(void);
+
+private:
+    const uint8_t*       _data;
+    size_t               _size;
+    std::vector<uint8_t> _buffer; // Holds the contents when the file can not be mapped
+
+};
+
+#endif // MAPPEDFILE_HPP
@@ -13,9 +13,12 @@ Menu::Menu(const Font& fontTitle, Color colorTitle, const Font& fontLabels,
     , _colorTitle(colorTitle)
     , _colorLabels(colorLabels)
     , _background(background)
+    , _atlas()
     , _title(_fontTitle, titleText, _colorTitle, { 0, 0 }, false)
     , _labels()
     , _labelSelected(0)
+    , _hasTextures(false)
+    , _outputWidth(0)
     , _callbacks(std::make_shared<ObjectMappedInputCallbacks>())
 {
     _callbacks->AddKeyCallback(Input::KeyCode::UP,     std::bind(&Menu::MoveSelection, this, SelectionDirectory::UP));
@@ -44,18 +47,50 @@ Menu::AddLabel(const std::string& labelText, const SelectionCallback callback)
         std::forward_as_tuple(_fontLabels, labelText, _colorLabels, position, selected),
         std::forward_as_tuple(callback)
     );
+    _hasTextures = false;
 }
 
 void
 Menu::UpdateTextures(const Renderer& renderer)
 {
+    if (_hasTextures)
+    {
+        centreLabels(renderer.GetOutputSize().W);
+        return;
+    }
+
     bool setCentered = true;
 
     _background.UpdateTexture(renderer);
-    _title.UpdateTexture(renderer, setCentered);
+    _atlas.Clear();
+    _title.UpdateTexture(renderer, setCentered, &_atlas);
     for (auto& label : _labels) {
-        label.first.UpdateTexture(renderer, setCentered);
+        label.first.UpdateTexture(renderer, setCentered, &_atlas);
     }
+    _hasTextures = true;
+    _outputWidth = renderer.GetOutputSize().W;
+}
+
+TaskScheduler::Step
+Menu::UpdateTexturesTask(const Renderer& renderer)
+{
+    return TaskScheduler::ForEach(_labels.size() + 2, [this, &renderer](size_t i)
+    {
+        if (i == 0) {
+            _background.UpdateTexture(renderer);
+        } else if (i == 1) {
+            _atlas.Clear();
+            _title.UpdateTexture(renderer, true, &_atlas);
+        } else {
+            _labels[i - 2].first.UpdateTexture(renderer, true, &_atlas);
+        }
+
+        if (i == _labels.size() + 1)
+        {
+            _hasTextures = true;
+            _outputWidth = renderer.GetOutputSize().W;
+        }
+    });
 }
 
 void
@@ -77,6 +112,18 @@ Menu::MoveSelection(Menu::SelectionDirectory dir)
     _labels.at(_labelSelected).first.SetIsSelected(true);
 }
 
+void
+Menu::ResetSelection(void)
+{
+    if (_labels.empty()) {
+        return;
+    }
+
+    _labels.at(_labelSelected).first.SetIsSelected(false);
+    _labelSelected = 0;
+    _labels.at(_labelSelected).first.SetIsSelected(true);
+}
+
 void
 Menu::ActivateSelection(void)
 {
@@ -102,3 +149,19 @@ Menu::ActivateCallbacks(Input& input)
 {
     input.UseObjectCallbacks(_callbacks);
 }
+
+// Private methods
+
+void
+Menu::centreLabels(int width)
+{
+    if (width == _outputWidth) {
+        return;
+    }
+
+    _title.SetCentered(width);
+    for (auto& label : _labels) {
+        label.first.SetCentered(width);
+    }
+    _outputWidth = width;
+}
@@ -5,7 +5,9 @@
 #include "Image.hpp"
 #include "Label.hpp"
 #include "Renderer.hpp"
+#include "TextureAtlas.hpp"
 #include "Input.hpp"
+#include "TaskScheduler.hpp"
 
 #include <SDL.h>
 
@@ -30,23 +32,41 @@ public:
     ~Menu(void) = default;
 
     void AddLabel(const std::string& labelText, const SelectionCallback callback = nullptr);
+
+    /// Creates the textures of the menu once, both selection states of every label included, so
+    /// moving the selection needs no new textures. Afterwards the labels are only centred again when
+    /// the width of the output has changed.
     void UpdateTextures(const Renderer& renderer);
+
+    /// The same work as UpdateTextures, split into one step for the background, the title and every
+    /// label. The labels must all be added first, the menu must outlive the task.
+    TaskScheduler::Step UpdateTexturesTask(const Renderer& renderer);
+
     void MoveSelection(Menu::SelectionDirectory dir);
+
+    /// Selects the first label.
+    void ResetSelection(void);
     void ActivateSelection(void);
 
     void Render(const Renderer& renderer) const;
 
     void ActivateCallbacks(Input& input);
 
+private:
+    void centreLabels(int width);
+
 private:
     const Font&                                      _fontTitle;
     const Font&                                      _fontLabels;
     Color                                            _colorTitle;
     Color                                            _colorLabels;
     Image&                                           _background;
+    TextureAtlas                                     _atlas; // Of the title and the labels, drawn without switching textures
     Label                                            _title;
     std::vector<std::pair<Label, SelectionCallback>> _labels;
     size_t                                           _labelSelected;
+    bool                                             _hasTextures;
+    int                                              _outputWidth; // That the labels are centred on
     std::shared_ptr<ObjectMappedInputCallbacks>      _callbacks;
 
 };
@@ -0,0 +1,74 @@
+#include "Motion.hpp"
+
+#include <cmath>
+
+
+namespace Motion
+{
+    float StepAxis(float gravity, float frictionScale, float deltaTime, float& friction, float& force, float velocity)
+    {
+        force    = (friction * gravity + force) * deltaTime;
+        friction = std::pow(friction * frictionScale, deltaTime);
+        return friction * velocity + force;
+    }
+
+    float LimitX(float position, float velocity, float min, float max)
+    {
+        if (position + velocity < min) {
+            return min - position;
+        }
+        if (position + velocity > max) {
+            return max - position;
+        }
+        return velocity;
+    }
+
+    float LimitY(float position, float velocity, float min, float max)
+    {
+        if (position + velocity < min) {
+            return min - position;
+        }
+        if (velocity > 0.0f && velocity + position > max) {
+            return max - position + velocity;
+        }
+        return velocity;
+    }
+
+    float Bounce(float velocityY)
+    {
+        return velocityY > 0.0f ? -velocityY : velocityY;
+    }
+
+    bool StartsFalling(float velocityY)
+    {
+        return velocityY > 0.0f;
+    }
+
+    bool LeavesGround(const RectangleF& body, float groundBegin, float groundEnd)
+    {
+        return body.X + body.W < groundBegin || body.X > groundEnd;
+    }
+
+    bool Lands(float velocityY)
+    {
+        return std::abs(velocityY) < LANDING_SPEED;
+    }
+
+    float GetMoveForce(Physics::Direction direction, float moveForce)
+    {
+        switch (direction)
+        {
+            case Physics::Direction::NORTH: return 2.0f * moveForce;
+            case Physics::Direction::EAST:  return moveForce;
+            case Physics::Direction::SOUTH: return 0.5f * moveForce;
+            case Physics::Direction::WEST:  return moveForce;
+        }
+        return moveForce;
+    }
+
+    float GetJumpForce(float moveForce)
+    {
+        return 12.5f * moveForce;
+    }
+
+} // end namespace Motion
@@ -0,0 +1,52 @@
+#ifndef MOTION_HPP
+#define MOTION_HPP
+
+#include "Geometry.hpp"
+#include "Physics.hpp"
+
+#include <cstddef>
+
+
+/// The motion of the bodies of the game on the XY-plane, one axis and one update at a time. The
+/// Transform of the objects, the states of a PlayerObject and the bots of a BotSwarm all move with
+/// these, so that a bot moves exactly like the player does.
+namespace Motion
+{
+    inline constexpr size_t JUMPS_COUNT   = 2;    // Of a body that jumps off the ground or bounces off a block
+    inline constexpr float  LANDING_SPEED = 1.0f; // A falling body slower than this lands on the block it hits
+
+    /// Applies the gravity and the friction of one axis to the acceleration of a body, then steps the
+    /// velocity of the axis, as Physics::Update and the matrices of a PhysicsObject do.
+    /// @param friction The diagonal element of the acceleration matrix for the axis, updated.
+    /// @param force    The translation element of the acceleration matrix for the axis, updated.
+    /// @return The velocity after the update, before it is limited to the boundaries.
+    float StepAxis(float gravity, float frictionScale, float deltaTime, float& friction, float& force, float velocity);
+
+    /// @return velocity shortened so that the position stays within [min, max].
+    float LimitX(float position, float velocity, float min, float max);
+
+    /// @return velocity shortened so that the position stays below the top min. A body that falls
+    /// through the bottom max is moved as far back up as it went through.
+    float LimitY(float position, float velocity, float min, float max);
+
+    /// @return The y-velocity of a body that bounces off a block.
+    float Bounce(float velocityY);
+
+    /// @return true if a jumping body has started to fall.
+    bool  StartsFalling(float velocityY);
+
+    /// @return true if body has walked off the ground [groundBegin, groundEnd] it stood on.
+    bool  LeavesGround(const RectangleF& body, float groundBegin, float groundEnd);
+
+    /// @return true if a falling body that hits a block lands on it, false if it bounces off.
+    bool  Lands(float velocityY);
+
+    /// @return The force of moving in direction, the moves up and down are stronger and weaker than the others.
+    float GetMoveForce(Physics::Direction direction, float moveForce);
+
+    /// @return The upwards force of a jump.
+    float GetJumpForce(float moveForce);
+
+} // end namespace Motion
+
+#endif // MOTION_HPP
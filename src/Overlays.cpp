@@ -8,7 +8,7 @@
 
 
 GameHUD::GameHUD(const Font& font, const Renderer& renderer, int levelNumber, int minTimeValBaseColor)
-    : _FONT(font)
+    : _glyphs(font, renderer)
     , _score(-1)
     , _time(-1)
     , _timeValMinBaseColor(static_cast<double>(minTimeValBaseColor))
@@ -17,25 +17,11 @@ GameHUD::GameHUD(const Font& font, const Renderer& renderer, int levelNumber, in
         Color::Tinted(Constants::Colors::GREEN, 0.75),
         Constants::Colors::DARK
     }
-    , _redrawScoreVal(true)
-    , _redrawTimeVal(true)
-    , _textTextures{}
+    , _levelText("LEVEL " + std::to_string(levelNumber))
+    , _scoreText()
+    , _timeText()
 {
-    renderText(TEXTS::LEVEL,     renderer, "LEVEL " + std::to_string(levelNumber));
-    renderText(TEXTS::SCORE,     renderer, "SCORE ");
-    //renderText(TEXTS::SCORE_VAL, renderer, std::to_string(_score));
-    renderText(TEXTS::TIME,      renderer, "TIME  ");
-    //renderText(TEXTS::TIME_VAL,  renderer, std::to_string(_time));
-}
-
-GameHUD::~GameHUD(void)
-{
-    for (Texture* t : _textTextures) {
-        if (t == nullptr) {
-            continue;
-        }
-        delete t;
-    }
+    //
 }
 
 void
@@ -43,8 +29,8 @@ GameHUD::Update(int time, int score)
 {
     if (time != _time)
     {
-        _time = time;
-        _redrawTimeVal = true;
+        _time     = time;
+        _timeText = std::to_string(_time);
 
         if (_time >= 0)
         { // Convert the color of remaining time in a linear fashion from the base color towards red in the range [_timeValMinBaseColor, 0]
@@ -57,80 +43,23 @@ GameHUD::Update(int time, int score)
 
     if (score != _score)
     {
-        _score = score;
-        _redrawScoreVal = true;
-    }
-}
-
-void
-GameHUD::Draw(const Renderer& renderer) const
-{
-    SDL_Rect rect = { 0, 0, 0, 0 };
-
-    auto drawTexture = [&renderer, &rect](Texture* t, Point2D pos)
-    {
-        if (t == nullptr) {
-            return;
-        }
-        rect.x = pos.X;
-        rect.y = pos.Y;
-        rect.w = t->GetSize().W;
-        rect.h = t->GetSize().H;
-
-        t->Render(renderer, nullptr, &rect);
-    };
-
-    if (_redrawScoreVal)
-    {
-        renderText(TEXTS::SCORE_VAL, renderer, std::to_string(_score));
-        _redrawScoreVal = false;
-    }
-    if (_redrawTimeVal) {
-        renderText(TEXTS::TIME_VAL, renderer, std::to_string(_time));
-        _redrawTimeVal = false;
+        _score     = score;
+        _scoreText = std::to_string(_score);
     }
-
-    drawTexture(_textTextures[static_cast<size_t>(TEXTS::LEVEL)], { 0, 0 });
-
-    drawTexture(_textTextures[static_cast<size_t>(TEXTS::SCORE)], { 0, rect.h });
-    drawTexture(_textTextures[static_cast<size_t>(TEXTS::SCORE_VAL)], { rect.w, rect.y });
-
-    drawTexture(_textTextures[static_cast<size_t>(TEXTS::TIME)], { 0, rect.y + rect.h });
-    drawTexture(_textTextures[static_cast<size_t>(TEXTS::TIME_VAL)], { rect.w, rect.y });
 }
 
 void
-GameHUD::renderText(TEXTS textEnum, const Renderer& renderer, const std::string& text) const
+GameHUD::Draw(RenderQueue& queue) const
 {
-    SDL_Surface* surface;
-    SDL_Color    color;
+    // Every glyph is in the same texture, the queue draws the whole HUD with one call
+    const RenderQueue::Layer layer      = RenderQueue::Layer::HUD;
+    const int                lineHeight = _glyphs.GetLineHeight();
 
-    switch (textEnum)
-    {
-        case TEXTS::TIME_VAL:
-            color.r = _colors[2].r;
-            color.g = _colors[2].g;
-            color.b = _colors[2].b;
-            color.a = _colors[2].a;
-            break;
-
-        default:
-            color.r = _colors[0].r;
-            color.g = _colors[0].g;
-            color.b = _colors[0].b;
-            color.a = _colors[0].a;
-            break;
-    }
+    _glyphs.Draw(queue, layer, _levelText, { 0, 0 }, _colors[0]);
 
-    if ( (surface = TTF_RenderText_Solid(_FONT.GetFont(), text.c_str(), color)) == nullptr) {
-        Logger::Debug("TTF_RenderText failed to render HUD text: {}", TTF_GetError());
-    }
-
-    if (_textTextures[static_cast<size_t>(textEnum)] == nullptr) {
-        _textTextures[static_cast<size_t>(textEnum)] = new Texture(renderer, surface);
-    } else {
-        _textTextures[static_cast<size_t>(textEnum)]->CreateTexture(renderer, surface);
-    }
+    const Dimensions2D score = _glyphs.Draw(queue, layer, "SCORE ", { 0, lineHeight }, _colors[0]);
+    _glyphs.Draw(queue, layer, _scoreText, { score.W, lineHeight }, _colors[0]);
 
-    SDL_FreeSurface(surface);
+    const Dimensions2D time = _glyphs.Draw(queue, layer, "TIME  ", { 0, 2 * lineHeight }, _colors[0]);
+    _glyphs.Draw(queue, layer, _timeText, { time.W, 2 * lineHeight }, _colors[2]);
 }
@@ -0,0 +1,262 @@
+#include "ParticleEmitter.hpp"
+
+#include <glm/trigonometric.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+
+namespace
+{
+    // The arrays of the particle fields never overlap each other. The loops have no branches and
+    // their pointers are restricted, so that the compiler vectorizes them.
+
+    void integrate(size_t count, float drag, float gravity, float dt,
+                   float* __restrict positionX, float* __restrict positionY,
+                   float* __restrict velocityX, float* __restrict velocityY)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            velocityX[i]  = velocityX[i] * drag;
+            velocityY[i]  = velocityY[i] * drag + gravity;
+            positionX[i] += velocityX[i] * dt;
+            positionY[i] += velocityY[i] * dt;
+        }
+    }
+
+    struct Channel
+    {
+        float  End;
+        float  Delta; // Start - End
+        float* Values;
+    };
+
+    Channel channel(uint8_t start, uint8_t end, float* values)
+    {
+        return { static_cast<float>(end), static_cast<float>(start) - static_cast<float>(end), values };
+    }
+
+    /// Interpolates the colors from the end color by the fraction of the lifetime left.
+    void fade(size_t count, float dt, float* __restrict lifetime, const float* __restrict fadeRate,
+              Channel red, Channel green, Channel blue, Channel alpha)
+    {
+        float* __restrict r = red.Values;
+        float* __restrict g = green.Values;
+        float* __restrict b = blue.Values;
+        float* __restrict a = alpha.Values;
+        for (size_t i = 0; i < count; ++i)
+        {
+            lifetime[i] -= dt;
+
+            // Negative for the dead particles, which are removed before they are drawn
+            const float fraction = lifetime[i] * fadeRate[i];
+            r[i] = red.End   + red.Delta   * fraction;
+            g[i] = green.End + green.Delta * fraction;
+            b[i] = blue.End  + blue.Delta  * fraction;
+            a[i] = alpha.End + alpha.Delta * fraction;
+        }
+    }
+} // end anonymous namespace
+
+
+ParticleEmitter::ParticleEmitter(size_t capacity, const Properties& properties, unsigned int seed)
+    : _capacity(capacity)
+    , _count(0)
+    , _properties(properties)
+    , _random(seed)
+    , _positionX(capacity)
+    , _positionY(capacity)
+    , _velocityX(capacity)
+    , _velocityY(capacity)
+    , _lifetime(capacity)
+    , _fadeRate(capacity)
+    , _red(capacity)
+    , _green(capacity)
+    , _blue(capacity)
+    , _alpha(capacity)
+    , _vertices(4 * capacity)
+    , _indices(6 * capacity)
+{
+    assert(0.0f <= properties.Drag && properties.Drag <= 1.0f);
+    assert(0.0f <  properties.MinLifetime && properties.MinLifetime < properties.MaxLifetime);
+    assert(properties.MinSpeed < properties.MaxSpeed && properties.MinAngle < properties.MaxAngle);
+
+    for (size_t i = 0; i < capacity; ++i)
+    {
+        const int base = static_cast<int>(4 * i);
+        std::copy_n(std::begin({ base, base + 1, base + 2, base + 2, base + 3, base }), 6, &_indices[6 * i]);
+    }
+}
+
+size_t
+ParticleEmitter::Emit(Point2DF position, size_t count)
+{
+    const size_t emitted = std::min(count, _capacity - _count);
+    for (size_t i = _count; i < _count + emitted; ++i)
+    {
+        const float angle    = glm::radians(_random.FloatInRange(_properties.MinAngle, _properties.MaxAngle));
+        const float speed    = _random.FloatInRange(_properties.MinSpeed, _properties.MaxSpeed);
+        const float lifetime = _random.FloatInRange(_properties.MinLifetime, _properties.MaxLifetime);
+
+        _positionX[i] = position.X;
+        _positionY[i] = position.Y;
+        _velocityX[i] =  speed * std::sin(angle);
+        _velocityY[i] = -speed * std::cos(angle);
+        _lifetime[i]  = lifetime;
+        _fadeRate[i]  = 1.0f / lifetime;
+        _red[i]       = _properties.StartColor.r;
+        _green[i]     = _properties.StartColor.g;
+        _blue[i]      = _properties.StartColor.b;
+        _alpha[i]     = _properties.StartColor.a;
+    }
+    _count += emitted;
+
+    return emitted;
+}
+
+void
+ParticleEmitter::Update(Timestep dt)
+{
+    const float deltaTime = static_cast<float>(dt);
+    const float drag      = std::pow(1.0f - _properties.Drag, deltaTime);
+    const float gravity   = _properties.Gravity * deltaTime;
+
+    integrate(
+        _count, drag, gravity, deltaTime,
+        _positionX.data(), _positionY.data(), _velocityX.data(), _velocityY.data()
+    );
+
+    const Color start = _properties.StartColor;
+    const Color end   = _properties.EndColor;
+    fade(
+        _count, deltaTime, _lifetime.data(), _fadeRate.data(),
+        channel(start.r, end.r, _red.data()),
+        channel(start.g, end.g, _green.data()),
+        channel(start.b, end.b, _blue.data()),
+        channel(start.a, end.a, _alpha.data())
+    );
+
+    removeDead();
+}
+
+void
+ParticleEmitter::Clear(void)
+{
+    _count = 0;
+}
+
+void
+ParticleEmitter::TranslateX(float dx)
+{
+    for (size_t i = 0; i < _count; ++i) {
+        _positionX[i] += dx;
+    }
+}
+
+void
+ParticleEmitter::Draw(const Renderer& renderer, const Camera& camera) const
+{
+    const size_t drawn = buildVertices(static_cast<float>(camera.GetX()), static_cast<float>(camera.GetWidth()));
+    if (drawn == 0) {
+        return;
+    }
+
+    renderer.RenderGeometry(
+        nullptr,
+        _vertices.data(), static_cast<int>(4 * drawn),
+        _indices.data(),  static_cast<int>(6 * drawn)
+    );
+}
+
+void
+ParticleEmitter::Draw(RenderQueue& queue, const Camera& camera) const
+{
+    const size_t drawn = buildVertices(static_cast<float>(camera.GetX()), static_cast<float>(camera.GetWidth()));
+    if (drawn == 0) {
+        return;
+    }
+
+    queue.Geometry(
+        RenderQueue::Layer::PARTICLES, nullptr,
+        _vertices.data(), static_cast<int>(4 * drawn),
+        _indices.data(),  static_cast<int>(6 * drawn)
+    );
+}
+
+size_t
+ParticleEmitter::GetCount(void) const { return _count; }
+
+size_t
+ParticleEmitter::GetCapacity(void) const { return _capacity; }
+
+Point2DF
+ParticleEmitter::GetPosition(size_t particle) const
+{
+    assert(particle < _count);
+    return { _positionX[particle], _positionY[particle] };
+}
+
+Color
+ParticleEmitter::GetColor(size_t particle) const
+{
+    assert(particle < _count);
+    return {
+        static_cast<uint8_t>(_red[particle]   + 0.5f),
+        static_cast<uint8_t>(_green[particle] + 0.5f),
+        static_cast<uint8_t>(_blue[particle]  + 0.5f),
+        static_cast<uint8_t>(_alpha[particle] + 0.5f)
+    };
+}
+
+// Private methods
+void
+ParticleEmitter::removeDead(void)
+{
+    size_t i = 0;
+    while (i < _count)
+    {
+        if (_lifetime[i] > 0.0f) {
+            ++i;
+            continue;
+        }
+
+        const size_t last = --_count;
+        _positionX[i] = _positionX[last];
+        _positionY[i] = _positionY[last];
+        _velocityX[i] = _velocityX[last];
+        _velocityY[i] = _velocityY[last];
+        _lifetime[i]  = _lifetime[last];
+        _fadeRate[i]  = _fadeRate[last];
+        _red[i]       = _red[last];
+        _green[i]     = _green[last];
+        _blue[i]      = _blue[last];
+        _alpha[i]     = _alpha[last];
+    }
+}
+
+size_t
+ParticleEmitter::buildVertices(float cameraX, float cameraWidth) const
+{
+    // Camera transformations are only defined for the x-axis
+    const float halfSize = 0.5f * _properties.Size;
+    size_t drawn = 0;
+    for (size_t i = 0; i < _count; ++i)
+    {
+        const float x = _positionX[i] - cameraX;
+        if (x + halfSize < 0.0f || x - halfSize > cameraWidth) {
+            continue;
+        }
+
+        const float y = _positionY[i];
+        const Color     c     = GetColor(i);
+        const SDL_Color color = { c.r, c.g, c.b, c.a };
+        SDL_Vertex* vertex = &_vertices[4 * drawn++];
+        vertex[0] = { { x - halfSize, y - halfSize }, color, { 0.0f, 0.0f } };
+        vertex[1] = { { x + halfSize, y - halfSize }, color, { 0.0f, 0.0f } };
+        vertex[2] = { { x + halfSize, y + halfSize }, color, { 0.0f, 0.0f } };
+        vertex[3] = { { x - halfSize, y + halfSize }, color, { 0.0f, 0.0f } };
+    }
+
+    return drawn;
+}
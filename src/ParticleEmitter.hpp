@@ -0,0 +1,101 @@
+#ifndef PARTICLEEMITTER_HPP
+#define PARTICLEEMITTER_HPP
+
+#include "Camera.hpp"
+#include "Color.hpp"
+#include "Geometry.hpp"
+#include "Helpers.hpp"
+#include "RenderQueue.hpp"
+#include "Renderer.hpp"
+#include "Timetools.hpp"
+
+#include <SDL.h>
+#include <vector>
+
+
+/// A fixed capacity pool of short lived particles, all drawn as squares with one RenderGeometry call.
+/// The particles are stored as a structure of arrays, one contiguous float array per field, and the
+/// update is a branchless loop over the arrays that the compiler vectorizes. Dead particles are
+/// replaced by the last live one, so the live particles are always the first GetCount() of the pool.
+/// Nothing is allocated after construction.
+///
+/// The particles are purely visual: the emitter has its own random generator, so emitting does not
+/// change the random sequence, and thus the simulation, of a level.
+class ParticleEmitter
+{
+public:
+    /// The particles are emitted with a speed, angle and lifetime drawn from the ranges [Min, Max],
+    /// each range must be non-empty.
+    struct Properties
+    {
+        Color StartColor;
+        Color EndColor;    // Reached at the end of the lifetime, the alpha fades too
+        float MinSpeed;    // Units per second
+        float MaxSpeed;
+        float MinAngle;    // Degrees, clockwise from north as in PhysicsObject::ApplyForce
+        float MaxAngle;
+        float MinLifetime; // Seconds
+        float MaxLifetime;
+        float Gravity;     // Units per second squared, along the y-axis
+        float Drag;        // The fraction of the velocity lost per second, in the range [0,1]
+        float Size;        // The width of the square
+    };
+
+public:
+    /// @param capacity The maximum amount of live particles, emitting more than that is ignored.
+    ParticleEmitter(size_t capacity, const Properties& properties, unsigned int seed);
+    ParticleEmitter(const ParticleEmitter& other) = delete;
+    ParticleEmitter(ParticleEmitter&& other)      = delete;
+    ~ParticleEmitter(void) = default;
+
+    /// Emits count particles from position, or as many as there is capacity left.
+    /// @return The amount of particles emitted.
+    size_t Emit(Point2DF position, size_t count);
+
+    void   Update(Timestep dt);
+    void   Clear(void);
+
+    /// Moves every particle dx units along the x-axis.
+    void   TranslateX(float dx);
+
+    /// Draws the live particles that are inside the viewport of the camera.
+    void   Draw(const Renderer& renderer, const Camera& camera) const;
+    void   Draw(RenderQueue& queue, const Camera& camera)       const;
+
+    size_t   GetCount(void)    const;
+    size_t   GetCapacity(void) const;
+    Point2DF GetPosition(size_t particle) const;
+    Color    GetColor(size_t particle)    const;
+
+private:
+    /// Removes the particles whose lifetime has run out.
+    void removeDead(void);
+
+    /// Builds the vertices of the live particles inside the viewport.
+    /// @return The amount of particles built.
+    size_t buildVertices(float cameraX, float cameraWidth) const;
+
+private:
+    size_t     _capacity;
+    size_t     _count;
+    Properties _properties;
+    Helpers::random::Generator _random;
+
+    std::vector<float> _positionX;
+    std::vector<float> _positionY;
+    std::vector<float> _velocityX;
+    std::vector<float> _velocityY;
+    std::vector<float> _lifetime;  // Seconds left
+    std::vector<float> _fadeRate;  // 1 / the whole lifetime
+    std::vector<float> _red;
+    std::vector<float> _green;
+    std::vector<float> _blue;
+    std::vector<float> _alpha;
+
+    // Scratch buffers for Draw, the indices never change
+    mutable std::vector<SDL_Vertex> _vertices;
+    std::vector<int>                _indices;
+
+};
+
+#endif // PARTICLEEMITTER_HPP
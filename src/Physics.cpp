@@ -133,3 +133,17 @@ PhysicsObject::GetVelocity(void) const { return _velocity; }
 
 const glm::mat4&
 PhysicsObject::GetAcceleration(void) const { return _acceleration; }
+
+PhysicsObject::Snapshot
+PhysicsObject::TakeSnapshot(void) const
+{
+    return { _position, _velocity, _acceleration };
+}
+
+void
+PhysicsObject::RestoreSnapshot(const Snapshot& snapshot)
+{
+    _position     = snapshot.Position;
+    _velocity     = snapshot.Velocity;
+    _acceleration = snapshot.Acceleration;
+}
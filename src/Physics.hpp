@@ -68,6 +68,15 @@ class PhysicsObject
 {
     friend void Physics::Update(PhysicsObject&) const;
 
+public:
+    /// All of the mutable state of the object, the move force is fixed at construction.
+    struct Snapshot
+    {
+        glm::vec4 Position;
+        glm::vec4 Velocity;
+        glm::mat4 Acceleration;
+    };
+
 public:
     PhysicsObject(const glm::vec3& position, const glm::vec3& velocity, const glm::vec3& acceleration);
     PhysicsObject(const PhysicsObject& other) = delete;
@@ -90,6 +99,9 @@ public:
     const glm::vec4& GetVelocity(void)     const;
     const glm::mat4& GetAcceleration(void) const;
 
+    Snapshot TakeSnapshot(void) const;
+    void     RestoreSnapshot(const Snapshot& snapshot);
+
 protected:
     glm::vec4 _position;
     glm::vec4 _velocity;
@@ -0,0 +1,266 @@
+#include "RenderQueue.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+
+RenderQueue::RenderQueue(void)
+    : _commands()
+    , _keys()
+    , _vertices()
+    , _indices()
+    , _textures(1, nullptr)
+    , _batchIndices()
+    , _batchRects()
+    , _frameStats({ 0, 0, 0 })
+    , _knownBlendMode(false)
+    , _knownColor(false)
+    , _blendMode(Renderer::BlendMode::NONE)
+    , _color(0u)
+{ }
+
+void
+RenderQueue::FillRectangle(Layer layer, Rectangle rectangle, Color color, Renderer::BlendMode blendMode)
+{
+    const float x0 = static_cast<float>(rectangle.X);
+    const float y0 = static_cast<float>(rectangle.Y);
+    const float x1 = static_cast<float>(rectangle.X + rectangle.W);
+    const float y1 = static_cast<float>(rectangle.Y + rectangle.H);
+    const SDL_Color c = { color.r, color.g, color.b, color.a };
+    const SDL_Vertex vertices[4] = {
+        { { x0, y0 }, c, { 0.0f, 0.0f } },
+        { { x1, y0 }, c, { 0.0f, 0.0f } },
+        { { x1, y1 }, c, { 0.0f, 0.0f } },
+        { { x0, y1 }, c, { 0.0f, 0.0f } }
+    };
+    const int indices[6] = { 0, 1, 2, 2, 3, 0 };
+
+    Geometry(layer, nullptr, vertices, 4, indices, 6, blendMode);
+}
+
+void
+RenderQueue::FillCircle(Layer layer, Point2D posCentre, int radius, Color color, Renderer::BlendMode blendMode)
+{
+    push(layer, Kind::CIRCLE, nullptr, blendMode, color).Src = { posCentre.X, posCentre.Y, radius, radius };
+}
+
+void
+RenderQueue::DrawRectangle(Layer layer, Rectangle rectangle, Color color)
+{
+    push(layer, Kind::OUTLINE, nullptr, Renderer::BlendMode::NONE, color).Src = {
+        rectangle.X, rectangle.Y, rectangle.W, rectangle.H
+    };
+}
+
+void
+RenderQueue::Copy(Layer layer, SDL_Texture* texture, const SDL_Rect* srcrect, const SDL_Rect* dstrect)
+{
+    assert(texture != nullptr);
+    Command& command = push(layer, Kind::COPY, texture, Renderer::BlendMode::NONE, Color(0u));
+    if (srcrect != nullptr)
+    {
+        command.Src    = *srcrect;
+        command.HasSrc = true;
+    }
+    if (dstrect != nullptr)
+    {
+        command.Dst    = *dstrect;
+        command.HasDst = true;
+    }
+}
+
+void
+RenderQueue::Geometry(Layer layer, SDL_Texture* texture, const SDL_Vertex* vertices, int numVertices,
+                      const int* indices, int numIndices, Renderer::BlendMode blendMode)
+{
+    if (numVertices <= 0) {
+        return;
+    }
+
+    // The blend mode of a texture is not part of the draw state
+    Command& command = push(layer, Kind::GEOMETRY, texture,
+        texture == nullptr ? blendMode : Renderer::BlendMode::NONE, Color(0u));
+
+    const int base = static_cast<int>(_vertices.size());
+    _vertices.insert(_vertices.end(), vertices, vertices + numVertices);
+
+    command.FirstIndex = _indices.size();
+    if (indices == nullptr || numIndices <= 0)
+    {
+        for (int i = 0; i < numVertices; ++i) {
+            _indices.push_back(base + i);
+        }
+    }
+    else
+    {
+        for (int i = 0; i < numIndices; ++i) {
+            _indices.push_back(base + indices[i]);
+        }
+    }
+    command.IndicesCount = _indices.size() - command.FirstIndex;
+}
+
+void
+RenderQueue::Flush(const Renderer& renderer)
+{
+    _frameStats     = { _commands.size(), 0, 0 };
+    _knownBlendMode = false;
+    _knownColor     = false;
+
+    // The indices break the ties of the keys, so the sort is stable
+    std::sort(_keys.begin(), _keys.end());
+
+    for (size_t i = 0; i < _keys.size(); )
+    {
+        const Command& command = sorted(i);
+        switch (command.Type)
+        {
+            case Kind::GEOMETRY:
+            case Kind::OUTLINE:
+            {
+                // Merge the following commands that are drawn with the same state
+                size_t last = i + 1;
+                while (last < _keys.size() && sorted(last).Type == command.Type && sorted(last).Texture == command.Texture &&
+                       sorted(last).Blend == command.Blend &&
+                       Color::ToUint32_t(sorted(last).DrawColor) == Color::ToUint32_t(command.DrawColor)) {
+                    ++last;
+                }
+                if (command.Type == Kind::GEOMETRY) {
+                    drawGeometry(renderer, i, last);
+                } else {
+                    drawOutlines(renderer, i, last);
+                }
+                i = last;
+                continue;
+            }
+
+            case Kind::CIRCLE:
+                setDrawState(renderer, command.Blend, command.DrawColor, true);
+                renderer.DrawCircleFilled({ command.Src.x, command.Src.y }, command.Src.w);
+                break;
+
+            case Kind::COPY:
+                renderer.RenderCopy(command.Texture, command.HasSrc ? &command.Src : nullptr,
+                                    command.HasDst ? &command.Dst : nullptr);
+                break;
+        }
+        ++_frameStats.DrawCalls;
+        ++i;
+    }
+
+    Clear();
+}
+
+void
+RenderQueue::Clear(void)
+{
+    _commands.clear();
+    _keys.clear();
+    _vertices.clear();
+    _indices.clear();
+    _textures.resize(1);
+}
+
+size_t
+RenderQueue::GetCount(void) const { return _commands.size(); }
+
+RenderQueue::Stats
+RenderQueue::GetFrameStats(void) const { return _frameStats; }
+
+// Private methods
+
+uint64_t
+RenderQueue::makeKey(Layer layer, SDL_Texture* texture, Renderer::BlendMode blendMode, Color color)
+{
+    // A frame only uses a handful of textures, a linear search is enough
+    size_t slot = 0;
+    if (texture != nullptr)
+    {
+        slot = static_cast<size_t>(std::find(_textures.begin() + 1, _textures.end(), texture) - _textures.begin());
+        if (slot == _textures.size()) {
+            _textures.push_back(texture);
+        }
+    }
+    assert(slot <= 0xffff);
+
+    return static_cast<uint64_t>(layer)                               << 56
+         | static_cast<uint64_t>(slot & 0xffff)                       << 40
+         | static_cast<uint64_t>(static_cast<uint8_t>(blendMode))     << 32
+         | static_cast<uint64_t>(Color::ToUint32_t(color));
+}
+
+RenderQueue::Command&
+RenderQueue::push(Layer layer, Kind kind, SDL_Texture* texture, Renderer::BlendMode blendMode, Color color)
+{
+    _keys.push_back({ makeKey(layer, texture, blendMode, color), _commands.size() });
+    _commands.push_back({
+        kind, texture, blendMode, color, { 0, 0, 0, 0 }, { 0, 0, 0, 0 }, false, false, 0, 0
+    });
+    return _commands.back();
+}
+
+void
+RenderQueue::setDrawState(const Renderer& renderer, Renderer::BlendMode blendMode, Color color, bool useColor)
+{
+    if (!_knownBlendMode || blendMode != _blendMode)
+    {
+        renderer.SetDrawBlendMode(blendMode);
+        _blendMode      = blendMode;
+        _knownBlendMode = true;
+        ++_frameStats.StateChanges;
+    }
+    if (useColor && (!_knownColor || Color::ToUint32_t(color) != Color::ToUint32_t(_color)))
+    {
+        renderer.SetRenderDrawColor(color);
+        _color      = color;
+        _knownColor = true;
+        ++_frameStats.StateChanges;
+    }
+}
+
+void
+RenderQueue::drawGeometry(const Renderer& renderer, size_t first, size_t last)
+{
+    const Command& command = sorted(first);
+    if (command.Texture == nullptr) { // Vertex colored, but blended with the draw blend mode
+        setDrawState(renderer, command.Blend, command.DrawColor, false);
+    }
+
+    const int* indices      = _indices.data() + command.FirstIndex;
+    size_t     indicesCount = command.IndicesCount;
+    if (last - first > 1)
+    {
+        _batchIndices.clear();
+        for (size_t i = first; i < last; ++i) {
+            _batchIndices.insert(_batchIndices.end(),
+                _indices.begin() + static_cast<std::ptrdiff_t>(sorted(i).FirstIndex),
+                _indices.begin() + static_cast<std::ptrdiff_t>(sorted(i).FirstIndex + sorted(i).IndicesCount));
+        }
+        indices      = _batchIndices.data();
+        indicesCount = _batchIndices.size();
+    }
+
+    // Only the vertices referenced by the indices are submitted to the driver
+    renderer.RenderGeometry(command.Texture, _vertices.data(), static_cast<int>(_vertices.size()),
+                            indices, static_cast<int>(indicesCount));
+    ++_frameStats.DrawCalls;
+}
+
+void
+RenderQueue::drawOutlines(const Renderer& renderer, size_t first, size_t last)
+{
+    setDrawState(renderer, sorted(first).Blend, sorted(first).DrawColor, true);
+
+    _batchRects.clear();
+    for (size_t i = first; i < last; ++i) {
+        _batchRects.push_back(sorted(i).Src);
+    }
+    renderer.DrawRectangles(_batchRects.data(), static_cast<int>(_batchRects.size()));
+    ++_frameStats.DrawCalls;
+}
+
+const RenderQueue::Command&
+RenderQueue::sorted(size_t index) const
+{
+    return _commands[_keys[index].second];
+}
@@ -0,0 +1,133 @@
+#ifndef RENDERQUEUE_HPP
+#define RENDERQUEUE_HPP
+
+#include "Camera.hpp"
+#include "Color.hpp"
+#include "Geometry.hpp"
+#include "Renderer.hpp"
+#include "Timetools.hpp"
+
+#include <SDL.h>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+
+/// Collects the draw commands of a frame and replays them in one pass, sorted by layer, texture,
+/// blend mode and color. Redundant changes of the draw color and blend mode are skipped, and the
+/// consecutive geometry of the same texture and blend mode, which includes filled rectangles, is
+/// submitted with one call. Commands that sort equal are replayed in the order they were submitted.
+class RenderQueue
+{
+public:
+    /// The layers are drawn in this order, within a layer the commands are sorted by state.
+    enum class Layer : uint8_t { BACKGROUND = 0, TERRAIN, TILES, PARTICLES, PLAYER, DEBUG, HUD };
+
+    struct Stats
+    {
+        size_t Commands;     // Submitted
+        size_t StateChanges; // Of the draw color and blend mode
+        size_t DrawCalls;    // To SDL
+    };
+
+public:
+    RenderQueue(void);
+    RenderQueue(const RenderQueue& other) = delete;
+    RenderQueue(RenderQueue&& other)      = delete;
+    ~RenderQueue(void) = default;
+
+    void FillRectangle(Layer layer, Rectangle rectangle, Color color,
+                       Renderer::BlendMode blendMode = Renderer::BlendMode::NONE);
+    void FillCircle(Layer layer, Point2D posCentre, int radius, Color color,
+                    Renderer::BlendMode blendMode = Renderer::BlendMode::NONE);
+
+    /// Draws the outline of rectangle, the outlines of the same color are drawn with one call.
+    void DrawRectangle(Layer layer, Rectangle rectangle, Color color);
+
+    /// Copies a portion of texture, see Renderer::RenderCopy. The rectangles are copied.
+    void Copy(Layer layer, SDL_Texture* texture, const SDL_Rect* srcrect = nullptr, const SDL_Rect* dstrect = nullptr);
+
+    /// Appends triangles, see Renderer::RenderGeometry. The vertices and indices are copied. Geometry
+    /// without a texture is drawn with blendMode, textured geometry with the blend mode of the texture.
+    void Geometry(Layer layer, SDL_Texture* texture, const SDL_Vertex* vertices, int numVertices,
+                  const int* indices = nullptr, int numIndices = 0,
+                  Renderer::BlendMode blendMode = Renderer::BlendMode::NONE);
+
+    /// Sorts and replays the commands on the current rendering target, and empties the queue.
+    void Flush(const Renderer& renderer);
+
+    /// Discards the commands without drawing them.
+    void Clear(void);
+
+    size_t GetCount(void)      const;
+
+    /// @return The statistics of the last flush.
+    Stats  GetFrameStats(void) const;
+
+private:
+    enum class Kind : uint8_t { GEOMETRY, CIRCLE, OUTLINE, COPY };
+
+    struct Command
+    {
+        Kind                Type;
+        SDL_Texture*        Texture;
+        Renderer::BlendMode Blend;
+        Color               DrawColor;
+        SDL_Rect            Src;    // Also the rectangle of an outline, and the centre and radius of a circle
+        SDL_Rect            Dst;
+        bool                HasSrc;
+        bool                HasDst;
+        size_t              FirstIndex;
+        size_t              IndicesCount;
+    };
+
+    /// Keys sort by layer, then by texture in the order the textures were first submitted, then
+    /// by blend mode and color.
+    uint64_t makeKey(Layer layer, SDL_Texture* texture, Renderer::BlendMode blendMode, Color color);
+
+    Command& push(Layer layer, Kind kind, SDL_Texture* texture, Renderer::BlendMode blendMode, Color color);
+
+    void setDrawState(const Renderer& renderer, Renderer::BlendMode blendMode, Color color, bool useColor);
+
+    /// Submits the geometry of the sorted commands [first, last), which share the texture and blend mode.
+    void drawGeometry(const Renderer& renderer, size_t first, size_t last);
+
+    /// Submits the outlines of the sorted commands [first, last), which share the color.
+    void drawOutlines(const Renderer& renderer, size_t first, size_t last);
+
+    const Command& sorted(size_t index) const;
+
+private:
+    std::vector<Command>      _commands;
+    std::vector<std::pair<uint64_t, size_t>> _keys; // The sort keys and the indices of the commands
+    std::vector<SDL_Vertex>   _vertices; // Of every geometry command of the frame
+    std::vector<int>          _indices;  // Into _vertices
+    std::vector<SDL_Texture*> _textures; // Indexed by the texture part of the keys, 0 is no texture
+    std::vector<int>          _batchIndices;
+    std::vector<SDL_Rect>     _batchRects;
+
+    Stats _frameStats;
+
+    // The draw state of the target during a flush, which is unknown when it starts
+    bool                _knownBlendMode;
+    bool                _knownColor;
+    Renderer::BlendMode _blendMode;
+    Color               _color;
+
+};
+
+
+/// An object that submits its draw commands to a RenderQueue.
+class DrawableObject
+{
+public:
+    DrawableObject(void) = default;
+    DrawableObject(const DrawableObject& other) = delete;
+    DrawableObject(DrawableObject&& other)      = delete;
+    virtual ~DrawableObject(void) = default;
+
+    virtual void Draw(RenderQueue& queue, const Camera& camera, Timestep it) const = 0;
+};
+
+#endif // RENDERQUEUE_HPP
@@ -0,0 +1,99 @@
+#include "RenderThread.hpp"
+#include "Logger.hpp"
+#include "Timetools.hpp"
+
+
+RenderThread::RenderThread(const Renderer& renderer, Color clearColor)
+    : _renderer(renderer)
+    , _clearColor(clearColor)
+    , _callerThread(std::this_thread::get_id())
+    , _queues()
+    , _recordIndex(0)
+    , _mutex()
+    , _condition()
+    , _inFlight(false)
+    , _quit(false)
+    , _inputTime()
+    , _frameStats({ { 0, 0, 0 }, 0, 0, 0 })
+    , _thread()
+{
+    _thread = std::thread(&RenderThread::run, this);
+    Logger::Debug("Render thread started");
+}
+
+RenderThread::~RenderThread(void)
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _quit = true;
+    }
+    _condition.notify_all();
+    _thread.join();
+    Logger::Debug("Render thread joined");
+}
+
+RenderQueue&
+RenderThread::GetRecordQueue(void) { return _queues[_recordIndex]; }
+
+void
+RenderThread::Submit(Clock::time_point inputTime)
+{
+    // Textures may have been rendered on this thread since the last frame
+    _renderer.ReleaseContext();
+
+    std::unique_lock<std::mutex> lock(_mutex);
+    _condition.wait(lock, [this]() { return !_inFlight; });
+    _recordIndex = 1 - _recordIndex;
+    _inputTime   = inputTime;
+    _inFlight    = true;
+    _renderer.SetOwnerThread(_thread.get_id());
+    lock.unlock();
+    _condition.notify_all();
+}
+
+void
+RenderThread::Wait(void)
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    _condition.wait(lock, [this]() { return !_inFlight; });
+}
+
+RenderThread::FrameStats
+RenderThread::GetFrameStats(void) const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _frameStats;
+}
+
+// Private methods
+
+void
+RenderThread::run(void)
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    while (true)
+    {
+        _condition.wait(lock, [this]() { return _inFlight || _quit; });
+        if (!_inFlight) { // Quit after the frame in flight has been presented
+            return;
+        }
+
+        RenderQueue&            queue     = _queues[1 - _recordIndex];
+        const Clock::time_point inputTime = _inputTime;
+        lock.unlock();
+
+        Timer timer(false);
+        queue.Flush(_renderer);
+        _renderer.SetRenderDrawColor(_clearColor);
+        _renderer.RenderPresent(true);
+        const int64_t presentUs = timer.Elapsed<std::chrono::microseconds>();
+        const int64_t latencyUs = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - inputTime).count();
+        _renderer.ReleaseContext();
+        _renderer.SetOwnerThread(_callerThread);
+
+        lock.lock();
+        _frameStats = { queue.GetFrameStats(), _renderer.GetFrameDrawCalls(), presentUs, latencyUs };
+        _inFlight   = false;
+        _condition.notify_all();
+    }
+}
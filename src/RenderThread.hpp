@@ -0,0 +1,80 @@
+#ifndef RENDERTHREAD_HPP
+#define RENDERTHREAD_HPP
+
+#include "Color.hpp"
+#include "RenderQueue.hpp"
+#include "Renderer.hpp"
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+
+/// Flushes and presents the recorded frames on a thread of its own, so that the simulation and the
+/// recording of the next frame overlap the present of the last one, which blocks on vsync. There are
+/// two queues, one is recorded by the caller while the thread presents the other one.
+/// The caller must not use the renderer while a frame is in flight, that is between Submit and Wait,
+/// the renderer is handed to the thread for that time, see Renderer::SetOwnerThread.
+/// The renderer must be an OpenGL one, see Renderer::IsOpenGL.
+class RenderThread
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct FrameStats
+    {
+        RenderQueue::Stats Queue;
+        size_t  DrawCalls;
+        int64_t PresentUs; // Flushing the queue and presenting
+        int64_t LatencyUs; // From polling the input shown by the frame to the end of its present
+    };
+
+public:
+    /// @param clearColor The color that the back buffer is cleared to after presenting.
+    RenderThread(const Renderer& renderer, Color clearColor);
+    RenderThread(const RenderThread& other) = delete;
+    RenderThread(RenderThread&& other)      = delete;
+    ~RenderThread(void);
+
+    /// @return The queue to record the next frame into, which the thread is not using.
+    RenderQueue& GetRecordQueue(void);
+
+    /// Hands the recorded queue to the thread. Waits for the frame in flight first, so at most one
+    /// frame is presented while the next one is recorded.
+    /// @param inputTime When the input that the frame shows was polled.
+    void Submit(Clock::time_point inputTime);
+
+    /// Blocks until the frame in flight has been presented. The caller can use the renderer until
+    /// the next Submit.
+    void Wait(void);
+
+    /// @return The statistics of the last presented frame.
+    FrameStats GetFrameStats(void) const;
+
+private:
+    void run(void);
+
+private:
+    const Renderer& _renderer;
+    const Color     _clearColor;
+    const std::thread::id _callerThread; // The one that constructed it, submits and records
+
+    std::array<RenderQueue, 2> _queues;
+    size_t                     _recordIndex; // The other queue is the one in flight
+
+    mutable std::mutex      _mutex;
+    std::condition_variable _condition;
+    bool                    _inFlight;
+    bool                    _quit;
+    Clock::time_point       _inputTime;
+    FrameStats              _frameStats;
+
+    std::thread _thread; // Last, started when the rest has been initialized
+
+};
+
+#endif // RENDERTHREAD_HPP
@@ -1,12 +1,22 @@
 #include "Renderer.hpp"
 #include "Logger.hpp"
 
+#include <cassert>
+#include <cmath>
+#include <string_view>
+
 
 Renderer::Renderer(Window& window, bool vsync, bool accelerated)
     : _targetWindow(window)
     , _renderer(SDL_CreateRenderer(_targetWindow.GetSdlWindow(), -1,
         Renderer::combineRendererFlags(false, accelerated, vsync, false))
     )
+    , _drawCalls(0)
+    , _frameDrawCalls(0)
+    , _targetsResetCount(0)
+    , _circleHalfWidths()
+    , _circleSpans()
+    , _ownerThread(std::this_thread::get_id())
 {
     if (_renderer == nullptr) {
         Logger::Debug("Unable to create renderer: {}", SDL_GetError());
@@ -57,6 +67,22 @@ Renderer::GetMaxTextureSize(void) const
     return { info.max_texture_width, info.max_texture_height };
 }
 
+std::string_view
+Renderer::GetName(void) const
+{
+    SDL_RendererInfo info = {};
+    if (SDL_GetRendererInfo(_renderer, &info) != 0 || info.name == nullptr) {
+        return {};
+    }
+    return info.name;
+}
+
+bool
+Renderer::IsOpenGL(void) const
+{
+    return GetName().substr(0, 6) == "opengl";
+}
+
 bool
 Renderer::GetIsVsyncced(void) const
 {
@@ -66,6 +92,7 @@ Renderer::GetIsVsyncced(void) const
 SDL_Renderer*
 Renderer::GetSdlRenderer(void) const
 {
+    assertOwner();
     return _renderer;
 }
 
@@ -77,24 +104,55 @@ Renderer::GetViewport(void) const
     return { vp.x, vp.y, vp.w, vp.h };
 }
 
+size_t
+Renderer::GetFrameDrawCalls(void) const { return _frameDrawCalls; }
+
+uint32_t
+Renderer::GetTargetsResetCount(void) const { return _targetsResetCount; }
+
+void
+Renderer::NotifyTargetsReset(void) { ++_targetsResetCount; }
+
+void
+Renderer::SetOwnerThread(std::thread::id thread) const
+{
+    _ownerThread.store(thread);
+}
+
 void
 Renderer::ToggleFullscreen(void) const
 {
+    assertOwner();
     _targetWindow.ToggleFullscreen();
     //SetViewport();
     //SetRenderTarget();
 }
 
+void
+Renderer::ReleaseContext(void) const
+{
+    if (!IsOpenGL()) {
+        return;
+    }
+    if (SDL_GL_MakeCurrent(_targetWindow.GetSdlWindow(), nullptr) != 0) {
+        Logger::Debug("Unable to release the OpenGL context: {}", SDL_GetError());
+    }
+}
+
 void
 Renderer::RenderPresent(bool doRenderClear) const
 {
+    assertOwner();
     SDL_RenderPresent(_renderer);
+    _frameDrawCalls = _drawCalls;
+    _drawCalls      = 0;
     if (doRenderClear) { RenderClear(); }
 }
 
 void
 Renderer::RenderClear(void) const
 {
+    assertOwner();
     if (SDL_RenderClear(_renderer) != 0) {
         Logger::Critical("Unable to clear the current rendering target: {}", SDL_GetError());
     }
@@ -103,6 +161,7 @@ Renderer::RenderClear(void) const
 void
 Renderer::SetRenderDrawColor(Color c) const
 {
+    assertOwner();
     if (SDL_SetRenderDrawColor(_renderer, c.r, c.g, c.b, c.a) != 0) {
         Logger::Debug("Unable to set render drawcolor: {}", SDL_GetError());
     }
@@ -111,6 +170,7 @@ Renderer::SetRenderDrawColor(Color c) const
 void
 Renderer::SetLogicalSize(Dimensions2D size) const
 {
+    assertOwner();
     if (SDL_RenderSetLogicalSize(_renderer, size.W, size.H) != 0) {
         Logger::Debug("Unable to set renderer logical size to {}x{}: {}", size.W, size.H, SDL_GetError());
     }
@@ -119,6 +179,7 @@ Renderer::SetLogicalSize(Dimensions2D size) const
 void
 Renderer::SetDrawBlendMode(BlendMode blendMode) const
 { // NOTE: This method has not been tested
+    assertOwner();
     if (SDL_SetRenderDrawBlendMode(_renderer, static_cast<SDL_BlendMode>(blendMode)) != 0) {
         Logger::Debug("Unable to set renderer draw blend mode: {}", SDL_GetError());
     }
@@ -127,6 +188,7 @@ Renderer::SetDrawBlendMode(BlendMode blendMode) const
 void
 Renderer::SetVsync(bool enabled) const
 { // TODO: Adaptive vsync - https://wiki.libsdl.org/SDL_GL_SetSwapInterval
+    assertOwner();
     if (SDL_GL_SetSwapInterval((enabled ? 1 : 0)) != 0) {
         Logger::Debug("Unable to set vsync to {}: {}", (enabled ? 1 : 0), SDL_GetError());
     }
@@ -135,6 +197,7 @@ Renderer::SetVsync(bool enabled) const
 void
 Renderer::SetViewport(const SDL_Rect* viewPort) const
 {
+    assertOwner();
     if (SDL_RenderSetViewport(_renderer, viewPort) != 0) {
         Logger::Debug("Unable to set render viewport: {}", SDL_GetError());
     }
@@ -143,6 +206,7 @@ Renderer::SetViewport(const SDL_Rect* viewPort) const
 void
 Renderer::SetRenderTarget(SDL_Texture* texture) const
 {
+    assertOwner();
     if (SDL_SetRenderTarget(_renderer, texture) != 0) {
         Logger::Debug("Unable to set render target: {}", SDL_GetError());
     }
@@ -151,6 +215,8 @@ Renderer::SetRenderTarget(SDL_Texture* texture) const
 void
 Renderer::RenderCopy(SDL_Texture* texture, const SDL_Rect* srcrect, const SDL_Rect* dstrect) const
 {
+    assertOwner();
+    ++_drawCalls;
     if (SDL_RenderCopy(_renderer, texture, srcrect, dstrect) != 0) {
         Logger::Critical("Unable to copy texture to rendering target: {}", SDL_GetError());
     }
@@ -161,14 +227,29 @@ Renderer::RenderCopyEx(SDL_Texture* texture, const SDL_Rect* srcrect,
                        const SDL_Rect* dstrect, const double angle,
                        const SDL_Point* center, const SDL_RendererFlip flip) const
 { // NOTE: This method has not been tested
+    assertOwner();
+    ++_drawCalls;
     if (SDL_RenderCopyEx(_renderer, texture, srcrect, dstrect, angle, center, flip) != 0) {
         Logger::Critical("Unable to copy texture to rendering target: {}", SDL_GetError());
     }
 }
 
+void
+Renderer::RenderGeometry(SDL_Texture* texture, const SDL_Vertex* vertices, int numVertices,
+                         const int* indices, int numIndices) const
+{
+    assertOwner();
+    ++_drawCalls;
+    if (SDL_RenderGeometry(_renderer, texture, vertices, numVertices, indices, numIndices) != 0) {
+        Logger::Debug("Renderer was not able to render geometry: {}", SDL_GetError());
+    }
+}
+
 void
 Renderer::DrawPoint(Point2D position) const
 {
+    assertOwner();
+    ++_drawCalls;
     if (SDL_RenderDrawPoint(_renderer, position.X, position.Y) != 0) {
         Logger::Debug("Renderer was not able to draw a point to the coords {}x{}: {}",
                       position.X, position.Y, SDL_GetError());
@@ -214,15 +295,43 @@ Renderer::DrawCircle(const Point2D posCenter, int radius) const
 
 void
 Renderer::DrawCircleFilled(const Point2D posCentre, int radius) const
-{ // TODO: Delete or implement a proper algorithm for filled circles
-    while (radius > 0) {
-        DrawCircle(posCentre, radius--);
+{
+    if (radius <= 0) {
+        return;
+    }
+
+    // The half widths only depend on the radius, and the circles drawn are mostly of the same radius
+    const size_t rows = static_cast<size_t>(2 * radius);
+    if (_circleHalfWidths.size() != rows)
+    {
+        _circleHalfWidths.resize(rows);
+        const double r = static_cast<double>(radius);
+        for (size_t row = 0; row < rows; ++row)
+        {
+            const double dy = static_cast<double>(row) + 0.5 - r; // From the centre of the row
+            _circleHalfWidths[row] = static_cast<int>(std::sqrt(r * r - dy * dy) + 0.5);
+        }
+    }
+
+    _circleSpans.resize(rows);
+    for (size_t row = 0; row < rows; ++row)
+    {
+        const int halfWidth = _circleHalfWidths[row];
+        _circleSpans[row] = { posCentre.X - halfWidth, posCentre.Y - radius + static_cast<int>(row), 2 * halfWidth, 1 };
+    }
+
+    assertOwner();
+    ++_drawCalls;
+    if (SDL_RenderFillRects(_renderer, _circleSpans.data(), static_cast<int>(rows)) != 0) {
+        Logger::Debug("Renderer was not able to fill a circle: {}", SDL_GetError());
     }
 }
 
 void
 Renderer::DrawLine(Point2D point1, Point2D point2) const
 { // NOTE: This method has not been tested
+    assertOwner();
+    ++_drawCalls;
     if (SDL_RenderDrawLine(_renderer, point1.X, point1.Y, point2.X, point2.Y) != 0) {
         Logger::Debug("Renderer was not able to draw a line: {}", SDL_GetError());
     }
@@ -239,11 +348,23 @@ Renderer::DrawRectangle(Rectangle* rectangle) const
 { // NOTE: This method has not been tested
   // TODO: Cast rectangle to SDL_Rect
     SDL_Rect sdlRect = { rectangle->X, rectangle->Y, rectangle->W, rectangle->H };
+    assertOwner();
+    ++_drawCalls;
     if (SDL_RenderDrawRect(_renderer, &sdlRect) != 0) {
         Logger::Debug("Renderer was not able to draw a rectangle: {}", SDL_GetError());
     }
 }
 
+void
+Renderer::DrawRectangles(const SDL_Rect* rectangles, int count) const
+{
+    assertOwner();
+    ++_drawCalls;
+    if (SDL_RenderDrawRects(_renderer, rectangles, count) != 0) {
+        Logger::Debug("Renderer was not able to draw rectangles: {}", SDL_GetError());
+    }
+}
+
 void
 Renderer::FillRectangle(Rectangle rectangle) const
 { // NOTE: This method has not been tested
@@ -254,6 +375,8 @@ void
 Renderer::FillRectangle(Rectangle* rectangle) const
 {
     SDL_Rect sdlRect = { rectangle->X, rectangle->Y, rectangle->W, rectangle->H };
+    assertOwner();
+    ++_drawCalls;
     if (SDL_RenderFillRect(_renderer, &sdlRect) != 0) {
         Logger::Debug("Renderer was not able to fill a rectangle: {}", SDL_GetError());
     }
@@ -271,6 +394,12 @@ Renderer::DrawFilledRectangle(Point2D posCentre, Dimensions2D size) const
 }
 
 // Private methods
+void
+Renderer::assertOwner(void) const
+{
+    assert(_ownerThread.load() == std::this_thread::get_id());
+}
+
 Uint32
 Renderer::getFlags(void) const
 {
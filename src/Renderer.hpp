@@ -9,6 +9,12 @@
 #include "Timetools.hpp"
 #include "Window.hpp"
 
+#include <atomic>
+#include <cstddef>
+#include <string_view>
+#include <thread>
+#include <vector>
+
 
 class Renderer
 {
@@ -33,8 +39,34 @@ public:
     SDL_Renderer* GetSdlRenderer(void)    const;
     Rectangle     GetViewport(void)       const;
 
+    /// @return The name of the backend of the renderer, e.g. "opengl" or "direct3d", empty if unknown.
+    std::string_view GetName(void)        const;
+
+    /// @return true with the OpenGL backends, the only ones that can be used from another thread than
+    /// the one that created the renderer, see ReleaseContext.
+    bool          IsOpenGL(void)          const;
+
+    /// @return The amount of draw calls submitted to SDL during the last presented frame.
+    size_t        GetFrameDrawCalls(void) const;
+
+    /// @return The amount of times the contents of the render target textures have been lost. Whatever
+    /// was rendered into them must be rendered again when this changes.
+    uint32_t      GetTargetsResetCount(void) const;
+
+    /// Called when SDL reports that the render targets or the whole device have been reset.
+    void          NotifyTargetsReset(void);
+
     void          ToggleFullscreen(void)  const;
 
+    /// Makes the OpenGL context of the renderer not current on the calling thread, so that another
+    /// thread can use the renderer. The renderer makes the context current again on the thread that
+    /// uses it next. Does nothing with the other backends.
+    void          ReleaseContext(void)    const;
+
+    /// Hands the renderer over to thread, until then it belongs to the thread that created it. The debug
+    /// builds assert that no other thread uses it, e.g. while the render thread presents a frame.
+    void          SetOwnerThread(std::thread::id thread) const;
+
     /// Swap framebuffers, "draw".
     /// @param: doRenderClear Has the default value true. If this is true, then
     /// initialize the backbuffer for the next frame after swapping
@@ -71,10 +103,19 @@ public:
                       const SDL_Rect* dstrect, const double angle,
                       const SDL_Point* center, const SDL_RendererFlip flip) const;
 
+    /// Render a list of triangles, optionally using a texture and indices into the vertices.
+    /// This submits all the triangles in one single call to the driver.
+    /// @param texture The texture to sample from. nullptr = use only the vertex colors.
+    /// @param indices Each three consecutive indices define a triangle. nullptr = vertices are sequential.
+    void RenderGeometry(SDL_Texture* texture, const SDL_Vertex* vertices, int numVertices,
+                        const int* indices = nullptr, int numIndices = 0) const;
+
     /// Draw a point on the current rendering target.
     void DrawPoint(Point2D position) const;
 
     void DrawCircle(const Point2D posCentre, int radius)       const;
+
+    /// Fill a circle with one horizontal span per row of pixels, all submitted with one call.
     void DrawCircleFilled(const Point2D posCentre, int radius) const;
 
     /// Draw a line on the current rendering target.
@@ -84,6 +125,9 @@ public:
 
     void DrawRectangle(Rectangle rectangle)  const;
     void DrawRectangle(Rectangle* rectangle) const;
+
+    /// Draw the outlines of count rectangles with one call.
+    void DrawRectangles(const SDL_Rect* rectangles, int count) const;
     void FillRectangle(Rectangle rectangle)  const;
     void FillRectangle(Rectangle* rectangle) const;
 
@@ -91,6 +135,7 @@ public:
 
 private:
     Uint32 getFlags(void) const;
+    void   assertOwner(void) const;
     static Uint32 combineRendererFlags(bool renderSoftware, bool renderAccelerated,
                                        bool presentVsync, bool renderTargetTexture);
 
@@ -98,19 +143,13 @@ private:
     Window&       _targetWindow;
     SDL_Renderer* _renderer;
 
-};
-
-
-// TODO: Delete this interface(?)
-class DrawableObject
-{
-public:
-    DrawableObject(void) = default;
-    DrawableObject(const DrawableObject& other) = delete;
-    DrawableObject(DrawableObject&& other)      = delete;
-    virtual ~DrawableObject(void) = default;
+    mutable size_t _drawCalls;      // Since the last RenderPresent
+    mutable size_t _frameDrawCalls; // During the last presented frame
+    uint32_t       _targetsResetCount;
+    mutable std::vector<int>        _circleHalfWidths; // Of the rows of the last filled circle
+    mutable std::vector<SDL_Rect>   _circleSpans;
+    mutable std::atomic<std::thread::id> _ownerThread;
 
-    virtual void Draw(const Renderer& renderer, const Camera& camera, Timestep it) const = 0;
 };
 
 #endif // RENDERER_HPP
@@ -0,0 +1,500 @@
+#include "Replay.hpp"
+#include "Constants.hpp"
+#include "GameObject.hpp"
+#include "Logger.hpp"
+#include "StateSerializer.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <limits>
+
+
+namespace
+{
+    constexpr uint32_t REPLAY_MAGIC    = 0x4750'5250; // "GPRP"
+    constexpr uint8_t  RECORD_KEYFRAME = 0x40;
+    constexpr size_t   BUFFER_SIZE     = 64 * 1024;
+
+    // magic, version, mode, seed, keyframe interval
+    constexpr size_t   HEADER_SIZE     = 3 * sizeof(uint32_t) + sizeof(uint8_t) + sizeof(uint32_t);
+    // event, updates, count
+    constexpr size_t   RUN_SIZE        = 2 * sizeof(uint8_t) + sizeof(uint16_t);
+    // tag, state size, followed by the state
+    constexpr size_t   KEYFRAME_SIZE   = sizeof(uint8_t) + sizeof(uint32_t);
+    // update, offset
+    constexpr size_t   INDEX_SIZE      = 2 * sizeof(uint64_t);
+    // updates count, keyframes count, index offset, magic
+    constexpr size_t   FOOTER_SIZE     = sizeof(uint64_t) + sizeof(uint32_t) + sizeof(uint64_t) + sizeof(uint32_t);
+
+    bool isFrameEvent(uint8_t event)
+    {
+        return event == Replay::EVENT_UPDATE
+            || ((event & Replay::EVENT_INPUT) != 0 && (event & ~Replay::EVENT_INPUT) < (1u << Replay::KEYS.size()));
+    }
+
+    template<typename T>
+    T readAt(const uint8_t* data, size_t offset)
+    {
+        T value;
+        std::memcpy(&value, data + offset, sizeof(T));
+        return value;
+    }
+} // end anonymous namespace
+
+
+std::unique_ptr<Replay>
+Replay::Open(const std::string& filepath)
+{ // Static function
+    std::unique_ptr<MappedFile> file = MappedFile::Open(filepath);
+    if (file == nullptr) {
+        return nullptr;
+    }
+    if (file->GetSize() < HEADER_SIZE + FOOTER_SIZE) {
+        Logger::Critical("\"{}\" is not a replay", filepath);
+        return nullptr;
+    }
+
+    StateReader header(file->GetData(), HEADER_SIZE);
+    uint32_t magic = 0, version = 0, seed = 0, keyframeInterval = 0;
+    uint8_t  mode  = 0;
+    header.Read(magic);
+    header.Read(version);
+    header.Read(mode);
+    header.Read(seed);
+    header.Read(keyframeInterval);
+
+    StateReader footer(file->GetData() + file->GetSize() - FOOTER_SIZE, FOOTER_SIZE);
+    uint64_t updatesCount = 0, indexOffset = 0;
+    uint32_t keyframesCount = 0, footerMagic = 0;
+    footer.Read(updatesCount);
+    footer.Read(keyframesCount);
+    footer.Read(indexOffset);
+    footer.Read(footerMagic);
+
+    if (magic != REPLAY_MAGIC || footerMagic != REPLAY_MAGIC) {
+        Logger::Critical("\"{}\" is not a replay, or its recording was not finished", filepath);
+        return nullptr;
+    }
+    if (version != FILE_VERSION) {
+        Logger::Critical("\"{}\" is a replay of version {}, expected {}", filepath, version, FILE_VERSION);
+        return nullptr;
+    }
+    if (mode > static_cast<uint8_t>(GameLevel::Mode::ENDLESS) || keyframesCount == 0 || indexOffset < HEADER_SIZE
+        || indexOffset + keyframesCount * INDEX_SIZE + FOOTER_SIZE != file->GetSize())
+    {
+        Logger::Critical("\"{}\" is a corrupted replay", filepath);
+        return nullptr;
+    }
+
+    std::unique_ptr<Replay> replay(new Replay(std::move(file)));
+    replay->_mode         = static_cast<GameLevel::Mode>(mode);
+    replay->_seed         = seed;
+    replay->_updatesCount = static_cast<size_t>(updatesCount);
+    replay->_recordsEnd   = static_cast<size_t>(indexOffset);
+    replay->_keyframes.reserve(keyframesCount);
+
+    // Only the keyframes are validated up front, the runs are validated while playing
+    const uint8_t* data = replay->_file->GetData();
+    for (size_t i = 0; i < keyframesCount; ++i)
+    {
+        const size_t   entry    = replay->_recordsEnd + i * INDEX_SIZE;
+        const Keyframe keyframe = {
+            static_cast<size_t>(readAt<uint64_t>(data, entry)),
+            static_cast<size_t>(readAt<uint64_t>(data, entry + sizeof(uint64_t)))
+        };
+
+        const bool ordered = i == 0 ? keyframe.Update == 0 : keyframe.Update > replay->_keyframes.back().Update;
+        if (!ordered || keyframe.Update > replay->_updatesCount || keyframe.Offset < HEADER_SIZE
+            || keyframe.Offset + KEYFRAME_SIZE > replay->_recordsEnd || data[keyframe.Offset] != RECORD_KEYFRAME
+            || readAt<uint32_t>(data, keyframe.Offset + 1) > replay->_recordsEnd - keyframe.Offset - KEYFRAME_SIZE)
+        {
+            Logger::Critical("\"{}\" is a corrupted replay", filepath);
+            return nullptr;
+        }
+        replay->_keyframes.push_back(keyframe);
+    }
+
+    return replay;
+}
+
+GameLevel::Mode
+Replay::GetMode(void) const { return _mode; }
+
+unsigned int
+Replay::GetSeed(void) const { return _seed; }
+
+size_t
+Replay::GetUpdatesCount(void) const { return _updatesCount; }
+
+size_t
+Replay::GetKeyframesCount(void) const { return _keyframes.size(); }
+
+size_t
+Replay::GetFileSize(void) const { return _file->GetSize(); }
+
+uint8_t
+Replay::GetKeys(const Input& input)
+{ // Static function
+    uint8_t keys = 0;
+    for (size_t i = 0; i < KEYS.size(); ++i) {
+        if (input.IsPressed(KEYS[i])) {
+            keys |= static_cast<uint8_t>(1u << i);
+        }
+    }
+    return keys;
+}
+
+void
+Replay::SetKeys(uint8_t keys, Input& input)
+{ // Static function
+    for (size_t i = 0; i < KEYS.size(); ++i) {
+        input.SetKeyPressed(KEYS[i], (keys & (1u << i)) != 0);
+    }
+}
+
+// Private methods
+Replay::Replay(std::unique_ptr<MappedFile> file)
+    : _file(std::move(file))
+    , _mode(GameLevel::Mode::FIXED)
+    , _seed(0)
+    , _updatesCount(0)
+    , _recordsEnd(0)
+    , _keyframes()
+{
+    //
+}
+
+
+ReplayRecorder::ReplayRecorder(const GameLevel& level, const std::string& filepath)
+    : _level(level)
+    , _file(filepath, std::ios::binary | std::ios::trunc)
+    , _buffer()
+    , _state()
+    , _keyframes()
+    , _fileSize(0)
+    , _keyframeInterval(Replay::KEYFRAME_SECONDS * Constants::TARGET_UPS)
+    , _updatesCount(0)
+    , _finished(false)
+    , _frameOpen(false)
+    , _frameEvent(Replay::EVENT_UPDATE)
+    , _frameUpdates(0)
+    , _runEvent(Replay::EVENT_UPDATE)
+    , _runUpdates(0)
+    , _runCount(0)
+{
+    if (!_file) {
+        Logger::Critical("Unable to open \"{}\" for writing, the level is not recorded", filepath);
+    }
+
+    _buffer.reserve(BUFFER_SIZE);
+    append(REPLAY_MAGIC);
+    append(Replay::FILE_VERSION);
+    append(static_cast<uint8_t>(level.GetMode()));
+    append(static_cast<uint32_t>(level.GetSeed()));
+    append(static_cast<uint32_t>(_keyframeInterval));
+    writeKeyframe();
+}
+
+ReplayRecorder::~ReplayRecorder(void)
+{
+    Finish();
+}
+
+void
+ReplayRecorder::RecordInput(const Input& input)
+{
+    assert(!_finished);
+    closeFrame();
+    _frameOpen    = true;
+    _frameEvent   = Replay::EVENT_INPUT | Replay::GetKeys(input);
+    _frameUpdates = 0;
+}
+
+void
+ReplayRecorder::RecordUpdate(void)
+{
+    assert(!_finished);
+    if (!_frameOpen || _frameUpdates == std::numeric_limits<uint8_t>::max())
+    {
+        closeFrame();
+        _frameOpen    = true;
+        _frameEvent   = Replay::EVENT_UPDATE;
+        _frameUpdates = 0;
+    }
+
+    ++_frameUpdates;
+    ++_updatesCount;
+
+    if (_updatesCount % _keyframeInterval == 0)
+    {
+        closeFrame();
+        writeRun();
+        writeKeyframe();
+    }
+}
+
+bool
+ReplayRecorder::Finish(void)
+{
+    if (_finished) {
+        return !_file.fail();
+    }
+
+    closeFrame();
+    writeRun();
+
+    const uint64_t indexOffset = _fileSize;
+    for (const Replay::Keyframe& keyframe : _keyframes)
+    {
+        append(static_cast<uint64_t>(keyframe.Update));
+        append(static_cast<uint64_t>(keyframe.Offset));
+    }
+    append(static_cast<uint64_t>(_updatesCount));
+    append(static_cast<uint32_t>(_keyframes.size()));
+    append(indexOffset);
+    append(REPLAY_MAGIC);
+
+    flush();
+    _file.close();
+    _finished = true;
+
+    return !_file.fail();
+}
+
+size_t
+ReplayRecorder::GetUpdatesCount(void) const { return _updatesCount; }
+
+// Private methods
+void
+ReplayRecorder::closeFrame(void)
+{
+    if (!_frameOpen) {
+        return;
+    }
+    _frameOpen = false;
+
+    if (_runCount > 0 && _runCount < std::numeric_limits<uint16_t>::max()
+        && _runEvent == _frameEvent && _runUpdates == _frameUpdates)
+    {
+        ++_runCount;
+        return;
+    }
+
+    writeRun();
+    _runEvent   = _frameEvent;
+    _runUpdates = _frameUpdates;
+    _runCount   = 1;
+}
+
+void
+ReplayRecorder::writeRun(void)
+{
+    if (_runCount == 0) {
+        return;
+    }
+
+    append(_runEvent);
+    append(_runUpdates);
+    append(_runCount);
+    _runCount = 0;
+}
+
+void
+ReplayRecorder::writeKeyframe(void)
+{
+    _level.SaveState(_state);
+    _keyframes.push_back({ _updatesCount, _fileSize });
+
+    append(RECORD_KEYFRAME);
+    append(static_cast<uint32_t>(_state.size()));
+    append(_state.data(), _state.size());
+}
+
+void
+ReplayRecorder::flush(void)
+{
+    if (_file) {
+        _file.write(reinterpret_cast<const char*>(_buffer.data()), static_cast<std::streamsize>(_buffer.size()));
+    }
+    _buffer.clear();
+}
+
+void
+ReplayRecorder::append(const void* data, size_t size)
+{
+    if (_buffer.size() + size > BUFFER_SIZE) {
+        flush();
+    }
+
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    _buffer.insert(_buffer.end(), bytes, bytes + size);
+    _fileSize += size;
+}
+
+
+ReplayPlayer::ReplayPlayer(const Replay& replay, GameLevel& level, Input& input)
+    : _replay(replay)
+    , _level(level)
+    , _input(input)
+    , _update(0)
+    , _offset(0)
+    , _runEvent(Replay::EVENT_UPDATE)
+    , _runUpdates(0)
+    , _framesLeft(0)
+    , _updatesLeft(0)
+    , _failed(false)
+{
+    assert(level.GetMode() == replay.GetMode());
+    loadKeyframe(_replay._keyframes.front());
+}
+
+bool
+ReplayPlayer::PlayUpdate(Timestep dt)
+{
+    while (_updatesLeft == 0)
+    {
+        if (_failed || (_framesLeft == 0 && !readRun())) {
+            return false;
+        }
+
+        --_framesLeft;
+        _updatesLeft = _runUpdates;
+        if (_runEvent != Replay::EVENT_UPDATE)
+        {
+            Replay::SetKeys(static_cast<uint8_t>(_runEvent & ~Replay::EVENT_INPUT), _input);
+            _level.HandleInput();
+        }
+    }
+
+    _level.Update(dt);
+    _level.HandleCollisions();
+    --_updatesLeft;
+    ++_update;
+
+    return true;
+}
+
+bool
+ReplayPlayer::Seek(size_t update, Timestep dt)
+{
+    update = std::min(update, _replay.GetUpdatesCount());
+
+    const std::vector<Replay::Keyframe>& keyframes = _replay._keyframes;
+    const auto next = std::upper_bound(keyframes.begin(), keyframes.end(), update,
+        [](size_t u, const Replay::Keyframe& keyframe) { return u < keyframe.Update; }
+    );
+    const Replay::Keyframe& keyframe = *(next - 1); // The first keyframe is at the update 0
+
+    // Playing forward is cheaper than loading a keyframe, unless there is a keyframe in between
+    if (_failed || update < _update || keyframe.Update > _update)
+    {
+        if (!loadKeyframe(keyframe)) {
+            return false;
+        }
+    }
+
+    while (_update < update && PlayUpdate(dt)) {
+        //
+    }
+    return !_failed;
+}
+
+size_t
+ReplayPlayer::GetUpdate(void) const { return _update; }
+
+bool
+ReplayPlayer::IsFinished(void) const { return _failed || _update >= _replay.GetUpdatesCount(); }
+
+ReplayPlayer::Summary
+ReplayPlayer::PlayHeadless(const Replay& replay)
+{ // Static function
+    Input input;
+    std::unique_ptr<PlayerObject> player = GameObject::CreatePlayer(
+        input, 0.0f, 0.0f,
+        Constants::Player::MOVE_FORCE,
+        Constants::Player::RADIUS,
+        nullptr,
+        Constants::Colors::LIGHT
+    );
+    std::unique_ptr<GameLevel> level = GameLevel::CreateHeadlessLevel(
+        input, replay.GetMode(), replay.GetSeed(), Constants::Level::ARENA_SIZE,
+        Constants::Level::GRAVITY, Constants::Level::FRICTION, Constants::Level::INITIAL_TIME,
+        player.get()
+    );
+
+    const Timestep dt(1.0 / static_cast<double>(Constants::TARGET_UPS));
+    ReplayPlayer replayPlayer(replay, *level, input);
+    size_t updates = 0;
+
+    Timer timer(false);
+    while (replayPlayer.PlayUpdate(dt)) {
+        ++updates;
+    }
+    const double seconds = static_cast<double>(timer.Elapsed<std::chrono::microseconds>()) / 1.0e6;
+
+    return {
+        updates,
+        seconds,
+        level->GetPlayerDistance(),
+        level->GetScore(),
+        level->GetFallsCount(),
+        level->IsCompleted()
+    };
+}
+
+// Private methods
+bool
+ReplayPlayer::loadKeyframe(const Replay::Keyframe& keyframe)
+{
+    const uint8_t* data = _replay._file->GetData();
+    const size_t   size = readAt<uint32_t>(data, keyframe.Offset + 1);
+
+    _update      = keyframe.Update;
+    _offset      = keyframe.Offset + KEYFRAME_SIZE + size;
+    _framesLeft  = 0;
+    _updatesLeft = 0;
+    _failed      = false;
+
+    if (!_level.LoadState(data + keyframe.Offset + KEYFRAME_SIZE, size)) {
+        fail();
+        return false;
+    }
+    return true;
+}
+
+bool
+ReplayPlayer::readRun(void)
+{
+    const uint8_t* data = _replay._file->GetData();
+    while (_offset < _replay._recordsEnd)
+    {
+        const uint8_t tag = data[_offset];
+        if (tag == RECORD_KEYFRAME && _offset + KEYFRAME_SIZE <= _replay._recordsEnd)
+        { // Keyframes are only needed for seeking
+            _offset += KEYFRAME_SIZE + readAt<uint32_t>(data, _offset + 1);
+            continue;
+        }
+        if (!isFrameEvent(tag) || _offset + RUN_SIZE > _replay._recordsEnd || readAt<uint16_t>(data, _offset + 2) == 0) {
+            break;
+        }
+
+        _runEvent   = tag;
+        _runUpdates = data[_offset + 1];
+        _framesLeft = readAt<uint16_t>(data, _offset + 2);
+        _offset    += RUN_SIZE;
+        return true;
+    }
+
+    if (_offset != _replay._recordsEnd || _update != _replay.GetUpdatesCount()) {
+        fail();
+    }
+    return false;
+}
+
+void
+ReplayPlayer::fail(void)
+{
+    Logger::Critical("The replay is corrupted, stopped playing it after {} updates", _update);
+    _failed = true;
+}
@@ -0,0 +1,209 @@
+#ifndef REPLAY_HPP
+#define REPLAY_HPP
+
+#include "GameLevel.hpp"
+#include "Input.hpp"
+#include "MappedFile.hpp"
+#include "Timetools.hpp"
+
+#include <array>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+
+/// A recorded play session, opened for playback. The level is generated from the seed and the
+/// simulation only depends on the keys that control the player, so the input handlings and the fixed
+/// updates in between them are enough to reproduce the session.
+///
+/// The file is a header followed by records and an index of the keyframes:
+/// - A run record holds a frame (the keys held at an input handling and the amount of updates run
+///   after it) and how many times the same frame repeats. The held keys rarely change between frames,
+///   so an hour of play fits in some hundreds of kilobytes.
+/// - A keyframe record holds the whole level state, as saved by GameLevel::SaveState, taken every
+///   KEYFRAME_SECONDS of game time. Seeking loads the closest keyframe and plays from there.
+/// The file is memory mapped, so opening even a long replay does not read it.
+class Replay
+{
+public:
+    /// The keys that control the player, the index of a key is its bit in the key bitmasks.
+    inline static constexpr std::array<Input::KeyCode, 5> KEYS = {
+        Input::KeyCode::UP,
+        Input::KeyCode::DOWN,
+        Input::KeyCode::LEFT,
+        Input::KeyCode::RIGHT,
+        Input::KeyCode::SPACE
+    };
+
+    inline static constexpr uint8_t  EVENT_UPDATE = 0x00; // A frame that begins without an input handling
+    inline static constexpr uint8_t  EVENT_INPUT  = 0x80; // The lower bits hold the keys
+
+    /// The version of the file format, must be bumped whenever the format changes.
+    inline static constexpr uint32_t FILE_VERSION     = 2;
+    inline static constexpr size_t   KEYFRAME_SECONDS = 10;
+
+public:
+    /// @return The replay in the file, nullptr if the file is not a valid replay.
+    static std::unique_ptr<Replay> Open(const std::string& filepath);
+
+    Replay(const Replay& other) = delete;
+    Replay(Replay&& other)      = delete;
+    ~Replay(void) = default;
+
+    GameLevel::Mode GetMode(void)           const;
+    unsigned int    GetSeed(void)           const;
+    size_t          GetUpdatesCount(void)   const;
+    size_t          GetKeyframesCount(void) const;
+    size_t          GetFileSize(void)       const;
+
+    /// @return The keys held on the input as a bitmask.
+    static uint8_t GetKeys(const Input& input);
+
+    /// Sets every key of the bitmask as held on the input, and releases the rest of the KEYS.
+    static void    SetKeys(uint8_t keys, Input& input);
+
+private:
+    struct Keyframe
+    {
+        size_t Update;
+        size_t Offset; // Of the keyframe record
+    };
+
+    Replay(std::unique_ptr<MappedFile> file);
+
+    friend class ReplayRecorder;
+    friend class ReplayPlayer;
+
+private:
+    std::unique_ptr<MappedFile> _file;
+    GameLevel::Mode             _mode;
+    unsigned int                _seed;
+    size_t                      _updatesCount;
+    size_t                      _recordsEnd; // The index follows the records
+    std::vector<Keyframe>       _keyframes;
+
+};
+
+
+/// Records a level into a replay file while it is played. The records are appended into a buffer
+/// that is written to the file only when it fills up, so recording does not touch the disk on every
+/// frame.
+class ReplayRecorder
+{
+public:
+    /// Starts recording the level from its current state into the file, replacing the file.
+    ReplayRecorder(const GameLevel& level, const std::string& filepath);
+    ReplayRecorder(const ReplayRecorder& other) = delete;
+    ReplayRecorder(ReplayRecorder&& other)      = delete;
+    ~ReplayRecorder(void);
+
+    /// Must be called every time the level handles input.
+    void RecordInput(const Input& input);
+
+    /// Must be called every time the level is updated, after the collisions have been handled.
+    void RecordUpdate(void);
+
+    /// Writes the index of the keyframes and closes the file, nothing can be recorded after this.
+    /// Called by the destructor if not called before.
+    /// @return true if the whole replay was written to the file.
+    bool Finish(void);
+
+    size_t GetUpdatesCount(void) const;
+
+private:
+    void closeFrame(void);
+    void writeRun(void);
+    void writeKeyframe(void);
+    void flush(void);
+
+    template<typename T>
+    void append(const T& value)
+    {
+        append(&value, sizeof(T));
+    }
+    void append(const void* data, size_t size);
+
+private:
+    const GameLevel&              _level;
+    std::ofstream                 _file;
+    std::vector<uint8_t>          _buffer;    // The records not yet written to the file
+    std::vector<uint8_t>          _state;     // Reused for every keyframe
+    std::vector<Replay::Keyframe> _keyframes;
+    size_t                        _fileSize;  // Including the buffered records
+    size_t                        _keyframeInterval;
+    size_t                        _updatesCount;
+    bool                          _finished;
+
+    // The frame being recorded and the run of identical frames it may continue
+    bool                          _frameOpen;
+    uint8_t                       _frameEvent;
+    uint8_t                       _frameUpdates;
+    uint8_t                       _runEvent;
+    uint8_t                       _runUpdates;
+    uint16_t                      _runCount;
+
+};
+
+
+/// Plays a replay on a level through the same fixed-step path as the game loop: the recorded keys are
+/// fed to the input the level reads, and the level handles input and updates in the recorded order.
+class ReplayPlayer
+{
+public:
+    struct Summary
+    {
+        size_t Updates;
+        double Seconds;  // Wall time used for playing
+        double Distance;
+        int    Score;
+        int    Falls;
+        bool   Completed;
+    };
+
+public:
+    /// Restores the level to the state the replay begins from.
+    /// @param level A level created with the mode and the seed of the replay.
+    /// @param input The input read by the level.
+    ReplayPlayer(const Replay& replay, GameLevel& level, Input& input);
+    ReplayPlayer(const ReplayPlayer& other) = delete;
+    ReplayPlayer(ReplayPlayer&& other)      = delete;
+    ~ReplayPlayer(void) = default;
+
+    /// Plays the events up to and including the next update.
+    /// @return false if the replay has ended and there was nothing to play.
+    bool PlayUpdate(Timestep dt);
+
+    /// Moves the playback to the state after the given amount of updates, by loading the closest
+    /// keyframe before it, unless the update is closer ahead, and playing from there.
+    /// @return false if the keyframe could not be loaded, in which case the playback has finished.
+    bool Seek(size_t update, Timestep dt);
+
+    /// @return The amount of updates played from the beginning of the replay.
+    size_t GetUpdate(void)  const;
+    bool   IsFinished(void) const;
+
+    /// Plays the whole replay in a headless level as fast as possible.
+    static Summary PlayHeadless(const Replay& replay);
+
+private:
+    bool loadKeyframe(const Replay::Keyframe& keyframe);
+    bool readRun(void);
+    void fail(void);
+
+private:
+    const Replay& _replay;
+    GameLevel&    _level;
+    Input&        _input;
+    size_t        _update;
+    size_t        _offset;       // Of the next record
+    uint8_t       _runEvent;
+    uint8_t       _runUpdates;
+    size_t        _framesLeft;   // In the current run
+    size_t        _updatesLeft;  // In the current frame
+    bool          _failed;
+
+};
+
+#endif // REPLAY_HPP
@@ -0,0 +1,85 @@
+#ifndef RINGBUFFER_HPP
+#define RINGBUFFER_HPP
+
+#include <array>
+#include <cstddef>
+#include <cassert>
+
+
+/// A fixed capacity circular buffer. All elements are default constructed up front and live
+/// for the whole lifetime of the buffer, pushing to a full buffer recycles the oldest element
+/// in place instead of destroying it. Elements can thus keep their own (heap) resources between
+/// uses, which keeps the total memory usage bounded.
+/// Indexing is logical: index 0 is the oldest element and Size() - 1 the newest.
+template<typename T, size_t Capacity>
+class RingBuffer
+{
+    static_assert(Capacity > 0, "RingBuffer capacity must be positive");
+
+public:
+    RingBuffer(void)
+        : _elements()
+        , _head(0)
+        , _size(0)
+    {
+        //
+    }
+
+    RingBuffer(const RingBuffer& other) = delete;
+    RingBuffer(RingBuffer&& other)      = delete;
+    ~RingBuffer(void) = default;
+
+    /// Makes room for a new element at the back of the buffer. If the buffer is full, the oldest
+    /// element is dropped from the front and its slot reused.
+    /// NOTE: The returned element is NOT reset, it holds the state of the recycled element (if any).
+    /// @return Reference to the new last element.
+    T& PushBack(void)
+    {
+        if (IsFull()) {
+            _head = wrap(_head + 1);
+        } else {
+            ++_size;
+        }
+        return Back();
+    }
+
+    /// Drops the oldest element. The element itself is left untouched and will be reused.
+    void PopFront(void)
+    {
+        assert(!IsEmpty());
+        _head = wrap(_head + 1);
+        --_size;
+    }
+
+    /// Drops all elements, no element is destructed.
+    void Clear(void)
+    {
+        _head = 0;
+        _size = 0;
+    }
+
+    T&       operator[](size_t index)       { assert(index < _size); return _elements[wrap(_head + index)]; }
+    const T& operator[](size_t index) const { assert(index < _size); return _elements[wrap(_head + index)]; }
+
+    T&       Front(void)       { return (*this)[0]; }
+    const T& Front(void) const { return (*this)[0]; }
+    T&       Back(void)        { return (*this)[_size - 1]; }
+    const T& Back(void)  const { return (*this)[_size - 1]; }
+
+    size_t Size(void)    const { return _size; }
+    bool   IsEmpty(void) const { return _size == 0; }
+    bool   IsFull(void)  const { return _size == Capacity; }
+
+    static constexpr size_t GetCapacity(void) { return Capacity; }
+
+private:
+    static constexpr size_t wrap(size_t index) { return index % Capacity; }
+
+private:
+    std::array<T, Capacity> _elements;
+    size_t                  _head; // Physical index of the oldest element
+    size_t                  _size;
+
+};
+
+#endif // RINGBUFFER_HPP
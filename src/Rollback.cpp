@@ -0,0 +1,159 @@
+#include "Rollback.hpp"
+#include "Logger.hpp"
+#include "Replay.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+
+RollbackSession::RollbackSession(GameLevel& level, Input& input)
+    : _level(level)
+    , _input(input)
+    , _ticks()
+    , _futureInputs()
+    , _tick(0)
+    , _rollbackTick(0)
+    , _mispredicted(false)
+    , _stats{ 0, 0, 0, 0, 0 }
+{
+    //
+}
+
+bool
+RollbackSession::AddInput(size_t tick, uint8_t keys)
+{
+    if (tick >= _tick) {
+        _futureInputs.emplace_back(tick, keys);
+        return true;
+    }
+
+    const size_t oldestTick = _tick - _ticks.Size();
+    if (tick < oldestTick)
+    {
+        ++_stats.RejectedInputs;
+        Logger::Critical("The input of the tick {} arrived {} ticks late, which is too late to roll back", tick, _tick - tick);
+        return false;
+    }
+
+    Tick& simulated = _ticks[tick - oldestTick];
+    simulated.Confirmed = true;
+    if (simulated.Keys != keys)
+    {
+        simulated.Keys = keys;
+        _rollbackTick  = _mispredicted ? std::min(_rollbackTick, tick) : tick;
+        _mispredicted  = true;
+    }
+    return true;
+}
+
+void
+RollbackSession::Synchronize(Timestep dt)
+{
+    if (!_mispredicted) {
+        return;
+    }
+    _mispredicted = false;
+
+    Timer timer(false);
+    const size_t first = _rollbackTick - (_tick - _ticks.Size());
+    if (!_level.LoadState(_ticks[first].State)) {
+        Logger::Critical("Unable to roll back to the tick {}", _rollbackTick);
+        return;
+    }
+
+    for (size_t i = first; i < _ticks.Size(); ++i)
+    {
+        Tick& tick = _ticks[i];
+        if (!tick.Confirmed && i > 0) {
+            tick.Keys = _ticks[i - 1].Keys; // Predicted again from the corrected input
+        }
+        simulate(tick, i != first, dt);
+    }
+
+    const size_t resimulated = _ticks.Size() - first;
+    ++_stats.Rollbacks;
+    _stats.ResimulatedTicks   += resimulated;
+    _stats.MaxResimulatedTicks = std::max(_stats.MaxResimulatedTicks, resimulated);
+    _stats.MaxRollbackNs       = std::max(_stats.MaxRollbackNs, timer.Elapsed<std::chrono::nanoseconds>());
+}
+
+void
+RollbackSession::AdvanceTick(Timestep dt)
+{
+    Synchronize(dt);
+
+    // Predicted to be the same as the previous input, unless the actual input has already arrived
+    const uint8_t predicted = _ticks.IsEmpty() ? 0 : _ticks.Back().Keys;
+    const auto    arrived   = std::find_if(_futureInputs.begin(), _futureInputs.end(),
+        [this](const std::pair<size_t, uint8_t>& input) { return input.first == _tick; }
+    );
+
+    Tick& tick = _ticks.PushBack(); // Recycles the oldest tick, and its state buffer
+    tick.Confirmed = arrived != _futureInputs.end();
+    tick.Keys      = tick.Confirmed ? arrived->second : predicted;
+    if (tick.Confirmed) {
+        _futureInputs.erase(arrived);
+    }
+
+    simulate(tick, true, dt);
+    ++_tick;
+}
+
+size_t
+RollbackSession::GetTick(void) const { return _tick; }
+
+const RollbackSession::Stats&
+RollbackSession::GetStats(void) const { return _stats; }
+
+// Private methods
+void
+RollbackSession::simulate(Tick& tick, bool saveState, Timestep dt)
+{
+    if (saveState) {
+        _level.SaveState(tick.State);
+    }
+
+    Replay::SetKeys(tick.Keys, _input);
+    _level.HandleInput();
+    _level.Update(dt);
+    _level.HandleCollisions();
+}
+
+
+LocalPeer::LocalPeer(size_t delayTicks, size_t jitterTicks, unsigned int seed)
+    : _delay(delayTicks)
+    , _jitter(jitterTicks)
+    , _random(seed)
+    , _inFlight()
+{
+    //
+}
+
+void
+LocalPeer::Send(size_t tick, uint8_t keys)
+{
+    const float  jitter  = _random.FloatInRange(0.0f, static_cast<float>(_jitter) + 0.999f);
+    const size_t arrival = tick + _delay + static_cast<size_t>(jitter);
+    _inFlight.push_back({ arrival, tick, keys });
+}
+
+void
+LocalPeer::Deliver(size_t tick, RollbackSession& session)
+{
+    const auto arrived = std::stable_partition(_inFlight.begin(), _inFlight.end(),
+        [tick](const Message& message) { return message.Arrival > tick; }
+    );
+    for (auto it = arrived; it != _inFlight.end(); ++it) {
+        session.AddInput(it->Tick, it->Keys);
+    }
+    _inFlight.erase(arrived, _inFlight.end());
+}
+
+void
+LocalPeer::Flush(RollbackSession& session)
+{
+    for (const Message& message : _inFlight) {
+        session.AddInput(message.Tick, message.Keys);
+    }
+    _inFlight.clear();
+}
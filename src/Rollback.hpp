@@ -0,0 +1,120 @@
+#ifndef ROLLBACK_HPP
+#define ROLLBACK_HPP
+
+#include "GameLevel.hpp"
+#include "Helpers.hpp"
+#include "Input.hpp"
+#include "RingBuffer.hpp"
+#include "Timetools.hpp"
+
+#include <cstdint>
+#include <vector>
+
+
+/// Simulates a level one fixed update (tick) at a time with inputs that may arrive late, as the inputs
+/// of a remote player do. A tick whose input has not arrived yet is simulated with a predicted input,
+/// the input of the previous tick. When the actual input of a tick arrives and differs from the
+/// prediction, the level is rolled back to the state it had before that tick, and the ticks from there
+/// on are simulated again.
+///
+/// The states before the last MAX_ROLLBACK_TICKS ticks are kept in a ring buffer whose buffers are
+/// reused, so simulating does not allocate once the buffer is full. Inputs are key bitmasks in the
+/// format of Replay::GetKeys.
+class RollbackSession
+{
+public:
+    /// How late an input can arrive, 1/4 of a second at the default update rate.
+    inline static constexpr size_t MAX_ROLLBACK_TICKS = 30;
+
+    struct Stats
+    {
+        size_t  Rollbacks;
+        size_t  ResimulatedTicks;
+        size_t  MaxResimulatedTicks; // In a single rollback
+        size_t  RejectedInputs;      // Arrived too late to roll back to
+        int64_t MaxRollbackNs;       // Loading the state and simulating again
+    };
+
+public:
+    /// @param level A new level, the session simulates it from its current state.
+    /// @param input The input read by the level.
+    RollbackSession(GameLevel& level, Input& input);
+    RollbackSession(const RollbackSession& other) = delete;
+    RollbackSession(RollbackSession&& other)      = delete;
+    ~RollbackSession(void) = default;
+
+    /// Adds the actual input of a tick. An input of a tick that has already been simulated is applied
+    /// by the next Synchronize or AdvanceTick.
+    /// @return false if the tick is too old to roll back to, in which case the input is ignored.
+    bool AddInput(size_t tick, uint8_t keys);
+
+    /// Rolls back and simulates again from the earliest tick whose prediction was wrong, if any.
+    void Synchronize(Timestep dt);
+
+    /// Synchronizes and simulates the next tick.
+    void AdvanceTick(Timestep dt);
+
+    /// @return The amount of ticks simulated.
+    size_t       GetTick(void)  const;
+    const Stats& GetStats(void) const;
+
+private:
+    struct Tick
+    {
+        std::vector<uint8_t> State; // Of the level before the tick was simulated
+        uint8_t              Keys;
+        bool                 Confirmed;
+    };
+
+    void simulate(Tick& tick, bool saveState, Timestep dt);
+
+private:
+    GameLevel&                                _level;
+    Input&                                    _input;
+    RingBuffer<Tick, MAX_ROLLBACK_TICKS>      _ticks;         // The newest is the last simulated tick
+    std::vector<std::pair<size_t, uint8_t>>   _futureInputs;  // Of the ticks not yet simulated
+    size_t                                    _tick;
+    size_t                                    _rollbackTick;  // The earliest mispredicted tick
+    bool                                      _mispredicted;
+    Stats                                     _stats;
+
+};
+
+
+/// An in-process stand-in for a remote peer: the inputs sent to it are delivered to a session after a
+/// delay that varies randomly between delay and delay + jitter ticks, so they may also arrive out of
+/// order, as over an unreliable network.
+class LocalPeer
+{
+public:
+    LocalPeer(size_t delayTicks, size_t jitterTicks, unsigned int seed);
+    LocalPeer(const LocalPeer& other) = delete;
+    LocalPeer(LocalPeer&& other)      = delete;
+    ~LocalPeer(void) = default;
+
+    /// Sends the input of the peer for the tick, the tick is also the time of sending.
+    void Send(size_t tick, uint8_t keys);
+
+    /// Delivers to the session every input that has arrived by the tick.
+    void Deliver(size_t tick, RollbackSession& session);
+
+    /// Delivers every input still in flight.
+    void Flush(RollbackSession& session);
+
+private:
+    struct Message
+    {
+        size_t  Arrival;
+        size_t  Tick;
+        uint8_t Keys;
+    };
+
+private:
+    size_t                     _delay;
+    size_t                     _jitter;
+    Helpers::random::Generator _random;
+    std::vector<Message>       _inFlight;
+
+};
+
+#endif // ROLLBACK_HPP
@@ -264,83 +264,25 @@ Sdl2::RegisterQuitEventCallback(const EventCallback quitCallback)
 Point2D
 Sdl2::PollEvents(void)
 {
-    while (SDL_PollEvent(&_event))
-    {
-        switch (_event.type)
-        {
-            case SDL_MOUSEMOTION:     // Fall through
-            case SDL_MOUSEBUTTONDOWN: // Fall through
-            case SDL_MOUSEBUTTONUP:   // Fall through
-            case SDL_KEYDOWN:         // Fall through, handle all input events in case SDL_KEYUP
-            case SDL_KEYUP:
-                _input.HandleEvent(&_event);
-                break;
-            case SDL_QUIT:
-                if (_quitEventCallback) { _quitEventCallback(); }
-#ifndef NDEBUG
-                else { Logger::Debug("Quit handler not registered"); }
-#endif
-                break;
-            case SDL_RENDER_DEVICE_RESET:
-                Logger::Debug("Event: RENDER_DEVICE_RESET");
-                break;
-            case SDL_RENDER_TARGETS_RESET:
-                Logger::Debug("Event: RENDER_TARGETS_RESET");
-                break;
-            case SDL_WINDOWEVENT: // Triggered when toggling fullscreen
-                switch (_event.window.event)
-                {
-/*
-                    case ::SDL_WINDOWEVENT_SHOWN:
-                        Logger::Info("Window shown");
-                        break;
-                    case ::SDL_WINDOWEVENT_HIDDEN:
-                        Logger::Info("Window hidden");
-                        break;
-                    case ::SDL_WINDOWEVENT_EXPOSED:
-                        Logger::Info("Window exposed");
-                        break;
-                    case ::SDL_WINDOWEVENT_MOVED:
-                        Logger::Info("Window moved");
-                        break;
-*/
-                    case ::SDL_WINDOWEVENT_RESIZED: // Docs: This event is always preceeded by ::SDL_WINDOWEVENT_SIZE_CHANGED
-                        break;
-                    case ::SDL_WINDOWEVENT_SIZE_CHANGED:
-                        //_renderer.SetViewport();
-                        //_renderer.SetRenderTarget();
-                        break;
-/*
-                    case ::SDL_WINDOWEVENT_MINIMIZED:
-                        Logger::Info("Window minimized");
-                        break;
-                    case ::SDL_WINDOWEVENT_MAXIMIZED:
-                        Logger::Info("Window maximized");
-                        break;
-                    case ::SDL_WINDOWEVENT_RESTORED:
-                        Logger::Info("Window restored");
-                        break;
-                    case ::SDL_WINDOWEVENT_ENTER:
-                        Logger::Info("Mouse entered");
-                        break;
-                    case ::SDL_WINDOWEVENT_CLOSE:
-                        Logger::Info("Window closed");
-                        break;
-*/
-                    default:
-                        //Logger::Info("Unhandled windowevent occured");
-                        break;
-                }
-                break;
-            default:
-                //Logger::Debug("Unhandled event occured");
-                break;
-        }
+    while (SDL_PollEvent(&_event)) {
+        handleEvent();
     }
 
     return _input.GetMousePos();
 }
 
+bool
+Sdl2::WaitEvents(int timeoutMs)
+{
+    if (SDL_WaitEventTimeout(&_event, timeoutMs) == 0) {
+        return false;
+    }
+
+    handleEvent();
+    PollEvents();
+    return true;
+}
+
 Input&
 Sdl2::GetInput(void)
 {
@@ -376,3 +318,82 @@ Sdl2::GetMixer(void)
 {
     return _mixer;
 }
+
+// Private methods
+
+void
+Sdl2::handleEvent(void)
+{
+    switch (_event.type)
+    {
+        case SDL_MOUSEMOTION:     // Fall through
+        case SDL_MOUSEBUTTONDOWN: // Fall through
+        case SDL_MOUSEBUTTONUP:   // Fall through
+        case SDL_KEYDOWN:         // Fall through, handle all input events in case SDL_KEYUP
+        case SDL_KEYUP:
+            _input.HandleEvent(&_event);
+            break;
+        case SDL_QUIT:
+            if (_quitEventCallback) { _quitEventCallback(); }
+#ifndef NDEBUG
+            else { Logger::Debug("Quit handler not registered"); }
+#endif
+            break;
+        case SDL_RENDER_DEVICE_RESET:
+            Logger::Debug("Event: RENDER_DEVICE_RESET");
+            _renderer.NotifyTargetsReset();
+            break;
+        case SDL_RENDER_TARGETS_RESET:
+            Logger::Debug("Event: RENDER_TARGETS_RESET");
+            _renderer.NotifyTargetsReset();
+            break;
+        case SDL_WINDOWEVENT: // Triggered when toggling fullscreen
+            switch (_event.window.event)
+            {
+/*
+                case ::SDL_WINDOWEVENT_SHOWN:
+                    Logger::Info("Window shown");
+                    break;
+                case ::SDL_WINDOWEVENT_HIDDEN:
+                    Logger::Info("Window hidden");
+                    break;
+                case ::SDL_WINDOWEVENT_EXPOSED:
+                    Logger::Info("Window exposed");
+                    break;
+                case ::SDL_WINDOWEVENT_MOVED:
+                    Logger::Info("Window moved");
+                    break;
+*/
+                case ::SDL_WINDOWEVENT_RESIZED: // Docs: This event is always preceeded by ::SDL_WINDOWEVENT_SIZE_CHANGED
+                    break;
+                case ::SDL_WINDOWEVENT_SIZE_CHANGED:
+                    //_renderer.SetViewport();
+                    //_renderer.SetRenderTarget();
+                    break;
+/*
+                case ::SDL_WINDOWEVENT_MINIMIZED:
+                    Logger::Info("Window minimized");
+                    break;
+                case ::SDL_WINDOWEVENT_MAXIMIZED:
+                    Logger::Info("Window maximized");
+                    break;
+                case ::SDL_WINDOWEVENT_RESTORED:
+                    Logger::Info("Window restored");
+                    break;
+                case ::SDL_WINDOWEVENT_ENTER:
+                    Logger::Info("Mouse entered");
+                    break;
+                case ::SDL_WINDOWEVENT_CLOSE:
+                    Logger::Info("Window closed");
+                    break;
+*/
+                default:
+                    //Logger::Info("Unhandled windowevent occured");
+                    break;
+            }
+            break;
+        default:
+            //Logger::Debug("Unhandled event occured");
+            break;
+    }
+}
@@ -43,6 +43,11 @@ public:
     void RegisterQuitEventCallback(const EventCallback quitCallback);
 
     Point2D PollEvents(void);
+
+    /// Blocks until an event arrives or timeoutMs milliseconds have passed, then handles every
+    /// queued event like PollEvents.
+    /// @return false if no event arrived before the timeout.
+    bool    WaitEvents(int timeoutMs);
     Input&  GetInput(void);
 
     const Window&   GetWindow(void)      const;
@@ -51,6 +56,10 @@ public:
     SDL_Renderer*   GetSdlRenderer(void) const;
     Mixer&          GetMixer(void);
 
+private:
+    /// Dispatches _event.
+    void handleEvent(void);
+
 private:
     inline static bool s_isInitialized      = false;
     inline static bool s_ttfIsInitialized   = false;
@@ -0,0 +1,125 @@
+#include "SkylinePacker.hpp"
+
+#include <algorithm>
+#include <limits>
+
+
+SkylinePacker::SkylinePacker(Dimensions2D size)
+    : _size(size)
+    , _skyline()
+    , _usedArea(0)
+{
+    Clear();
+}
+
+void
+SkylinePacker::Clear(void)
+{
+    _skyline.clear();
+    _skyline.push_back({ 0, 0, _size.W });
+    _usedArea = 0;
+}
+
+bool
+SkylinePacker::Insert(Dimensions2D size, Point2D& position)
+{
+    if (size.W <= 0 || size.H <= 0) {
+        return false;
+    }
+
+    size_t bestIndex = _skyline.size();
+    int    bestTop   = std::numeric_limits<int>::max();
+    int    bestWidth = std::numeric_limits<int>::max();
+    for (size_t i = 0; i < _skyline.size(); ++i)
+    {
+        const int y = fitAt(i, size);
+        if (y < 0) {
+            continue;
+        }
+
+        const int top = y + size.H;
+        if (top < bestTop || (top == bestTop && _skyline[i].Width < bestWidth))
+        {
+            bestIndex = i;
+            bestTop   = top;
+            bestWidth = _skyline[i].Width;
+            position  = { _skyline[i].X, y };
+        }
+    }
+    if (bestIndex == _skyline.size()) {
+        return false;
+    }
+
+    // The new segment covers the start of the segments it was placed on, which are cut or removed
+    const Node node = { position.X, bestTop, size.W };
+    _skyline.insert(_skyline.begin() + static_cast<std::ptrdiff_t>(bestIndex), node);
+    for (size_t i = bestIndex + 1; i < _skyline.size(); )
+    {
+        Node& next = _skyline[i];
+        const int covered = node.X + node.Width - next.X;
+        if (covered <= 0) {
+            break;
+        }
+
+        next.X     += covered;
+        next.Width -= covered;
+        if (next.Width > 0) {
+            break;
+        }
+        _skyline.erase(_skyline.begin() + static_cast<std::ptrdiff_t>(i));
+    }
+    mergeNodes();
+
+    _usedArea += static_cast<int64_t>(size.W) * size.H;
+    return true;
+}
+
+Dimensions2D
+SkylinePacker::GetSize(void) const { return _size; }
+
+float
+SkylinePacker::GetOccupancy(void) const
+{
+    const int64_t area = static_cast<int64_t>(_size.W) * _size.H;
+    return area > 0 ? static_cast<float>(_usedArea) / static_cast<float>(area) : 0.0f;
+}
+
+// Private methods
+
+int
+SkylinePacker::fitAt(size_t index, Dimensions2D size) const
+{
+    if (_skyline[index].X + size.W > _size.W) {
+        return -1;
+    }
+
+    // The rectangle rests on the highest of the segments below it, which cover the whole width
+    int y         = 0;
+    int remaining = size.W;
+    for (size_t i = index; remaining > 0; ++i)
+    {
+        y = std::max(y, _skyline[i].Y);
+        if (y + size.H > _size.H) {
+            return -1;
+        }
+        remaining -= _skyline[i].Width;
+    }
+    return y;
+}
+
+void
+SkylinePacker::mergeNodes(void)
+{
+    for (size_t i = 0; i + 1 < _skyline.size(); )
+    {
+        if (_skyline[i].Y == _skyline[i + 1].Y)
+        {
+            _skyline[i].Width += _skyline[i + 1].Width;
+            _skyline.erase(_skyline.begin() + static_cast<std::ptrdiff_t>(i + 1));
+        }
+        else
+        {
+            ++i;
+        }
+    }
+}
@@ -0,0 +1,59 @@
+#ifndef SKYLINEPACKER_HPP
+#define SKYLINEPACKER_HPP
+
+#include "Geometry.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+
+/// Packs rectangles into an area of a fixed size with the skyline bottom-left heuristic. The packed
+/// area is described by its skyline, the top edge of the rectangles packed so far as seen from
+/// above, which is a list of horizontal segments. A rectangle is placed where its top edge ends up
+/// the lowest, on the narrowest segment if there is a tie. Rectangles can not be removed one by one,
+/// only all of them at once.
+class SkylinePacker
+{
+public:
+    SkylinePacker(Dimensions2D size);
+    SkylinePacker(const SkylinePacker& other) = default;
+    SkylinePacker(SkylinePacker&& other)      = default;
+    ~SkylinePacker(void) = default;
+
+    /// Removes every packed rectangle.
+    void Clear(void);
+
+    /// Finds room for a rectangle and reserves it.
+    /// @param position Set to the top left corner of the rectangle if it fits.
+    /// @return false if the rectangle does not fit.
+    bool Insert(Dimensions2D size, Point2D& position);
+
+    Dimensions2D GetSize(void) const;
+
+    /// @return The fraction of the area covered by the packed rectangles.
+    float GetOccupancy(void) const;
+
+private:
+    struct Node
+    {
+        int X;
+        int Y;     // The top of the segment, the area above it is free
+        int Width;
+    };
+
+    /// @return The y-coordinate of a rectangle of size placed with its left edge on the node at index,
+    ///         or -1 if it does not fit there.
+    int  fitAt(size_t index, Dimensions2D size) const;
+
+    /// Joins the neighbouring segments that are at the same height.
+    void mergeNodes(void);
+
+private:
+    Dimensions2D      _size;
+    std::vector<Node> _skyline; // Sorted by x, the segments cover the whole width
+    int64_t           _usedArea;
+
+};
+
+#endif // SKYLINEPACKER_HPP
@@ -0,0 +1,109 @@
+#include "StateSerializer.hpp"
+#include "Logger.hpp"
+
+#include <cassert>
+#include <fstream>
+
+
+StateWriter::StateWriter(std::vector<uint8_t>& buffer, size_t size)
+    : _buffer(buffer)
+    , _offset(0)
+{
+    _buffer.resize(size);
+}
+
+void
+StateWriter::WriteBytes(const void* data, size_t size)
+{
+    std::memcpy(at(_offset, size), data, size);
+    _offset += size;
+}
+
+size_t
+StateWriter::GetSize(void) const { return _offset; }
+
+bool
+StateWriter::IsComplete(void) const { return _offset == _buffer.size(); }
+
+bool
+StateWriter::WriteFile(const std::string& filepath, const std::vector<uint8_t>& buffer)
+{ // Static function
+    std::ofstream file(filepath, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        Logger::Critical("Unable to open \"{}\" for writing", filepath);
+        return false;
+    }
+
+    file.write(reinterpret_cast<const char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+    return static_cast<bool>(file);
+}
+
+// Private methods
+uint8_t*
+StateWriter::at(size_t offset, size_t size)
+{
+    assert(offset + size <= _buffer.size());
+    return _buffer.data() + offset;
+}
+
+
+StateReader::StateReader(const uint8_t* data, size_t size)
+    : _data(data)
+    , _size(size)
+    , _offset(0)
+    , _failed(false)
+{
+    //
+}
+
+bool
+StateReader::ReadBytes(void* data, size_t size)
+{
+    if (_failed || size > _size - _offset) {
+        _failed = true;
+        return false;
+    }
+
+    std::memcpy(data, _data + _offset, size);
+    _offset += size;
+    return true;
+}
+
+const uint8_t*
+StateReader::ReadView(size_t size)
+{
+    if (_failed || size > _size - _offset) {
+        _failed = true;
+        return nullptr;
+    }
+
+    const uint8_t* view = _data + _offset;
+    _offset += size;
+    return view;
+}
+
+bool
+StateReader::HasFailed(void) const { return _failed; }
+
+size_t
+StateReader::GetRemaining(void) const { return _size - _offset; }
+
+bool
+StateReader::ReadFile(const std::string& filepath, std::vector<uint8_t>& buffer)
+{ // Static function
+    std::ifstream file(filepath, std::ios::binary | std::ios::ate);
+    if (!file) {
+        Logger::Critical("Unable to open \"{}\" for reading", filepath);
+        return false;
+    }
+
+    const std::streamsize size = file.tellg();
+    if (size < 0) {
+        return false;
+    }
+
+    buffer.resize(static_cast<size_t>(size));
+    file.seekg(0);
+    file.read(reinterpret_cast<char*>(buffer.data()), size);
+    return static_cast<bool>(file);
+}
@@ -0,0 +1,96 @@
+#ifndef STATESERIALIZER_HPP
+#define STATESERIALIZER_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+
+/// Writes plain values into a byte buffer in the native byte order. The buffer is owned by the
+/// caller and sized once up front, so a buffer reused for every save only allocates when the
+/// state grows, and writing a value is a plain copy.
+class StateWriter
+{
+public:
+    /// Resizes the buffer to size bytes, which must be exactly the amount of bytes written.
+    StateWriter(std::vector<uint8_t>& buffer, size_t size);
+    StateWriter(const StateWriter& other) = delete;
+    StateWriter(StateWriter&& other)      = delete;
+    ~StateWriter(void) = default;
+
+    template<typename T>
+    void Write(const T& value)
+    {
+        static_assert(std::is_arithmetic_v<T>, "Only arithmetic values have a fixed binary layout");
+        WriteBytes(&value, sizeof(T));
+    }
+
+    void WriteBytes(const void* data, size_t size);
+
+    /// Overwrites a value written earlier, used for fields that are known only at the end.
+    template<typename T>
+    void Overwrite(size_t offset, const T& value)
+    {
+        static_assert(std::is_arithmetic_v<T>, "Only arithmetic values have a fixed binary layout");
+        std::memcpy(at(offset, sizeof(T)), &value, sizeof(T));
+    }
+
+    /// @return The amount of bytes written.
+    size_t GetSize(void) const;
+
+    /// @return true if exactly the size given to the constructor has been written.
+    bool   IsComplete(void) const;
+
+    /// @return true if the whole buffer was written to the file.
+    static bool WriteFile(const std::string& filepath, const std::vector<uint8_t>& buffer);
+
+private:
+    uint8_t* at(size_t offset, size_t size);
+
+private:
+    std::vector<uint8_t>& _buffer;
+    size_t                _offset;
+
+};
+
+
+/// Reads the values written by a StateWriter in the same order. Reading past the end of the data
+/// fails the reader, after which every read fails, so the result only has to be checked once.
+class StateReader
+{
+public:
+    StateReader(const uint8_t* data, size_t size);
+    StateReader(const StateReader& other) = delete;
+    StateReader(StateReader&& other)      = delete;
+    ~StateReader(void) = default;
+
+    template<typename T>
+    bool Read(T& value)
+    {
+        static_assert(std::is_arithmetic_v<T>, "Only arithmetic values have a fixed binary layout");
+        return ReadBytes(&value, sizeof(T));
+    }
+
+    bool ReadBytes(void* data, size_t size);
+
+    /// Skips over size bytes without copying them.
+    /// @return The skipped bytes, nullptr if there are not enough of them.
+    const uint8_t* ReadView(size_t size);
+
+    bool   HasFailed(void)    const;
+    size_t GetRemaining(void) const;
+
+    /// @return true if the whole file was read into the buffer.
+    static bool ReadFile(const std::string& filepath, std::vector<uint8_t>& buffer);
+
+private:
+    const uint8_t* _data;
+    size_t         _size;
+    size_t         _offset;
+    bool           _failed;
+
+};
+
+#endif // STATESERIALIZER_HPP
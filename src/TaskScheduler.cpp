@@ -0,0 +1,152 @@
+#include "TaskScheduler.hpp"
+#include "Logger.hpp"
+#include "Timetools.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+
+
+TaskScheduler::TaskScheduler(void)
+    : _tasks()
+    , _nextId(NULL_TASK + 1)
+{ }
+
+TaskScheduler::TaskId
+TaskScheduler::Add(const std::string& name, Step step, Microseconds budget)
+{
+    _tasks.push_back({ _nextId, name, std::move(step), budget, 0, 0 });
+    return _nextId++;
+}
+
+void
+TaskScheduler::Cancel(TaskId id)
+{
+    const size_t index = findPending(id);
+    if (index < _tasks.size())
+    {
+        Logger::Debug("Task \"{}\" cancelled after {} steps", _tasks[index].Name, _tasks[index].Steps);
+        _tasks[index].NextStep = nullptr;
+    }
+}
+
+void
+TaskScheduler::Finish(TaskId id)
+{
+    const size_t index = findPending(id);
+    if (index >= _tasks.size()) {
+        return;
+    }
+
+    ++_tasks[index].Frames;
+    while (_tasks[index].NextStep != nullptr) {
+        runStep(index);
+    }
+}
+
+void
+TaskScheduler::RunFrame(Microseconds frameBudget)
+{
+    Timer frameTimer(false);
+    bool  stepped = false;
+
+    // The tasks added by the steps are appended, and run in this frame if there is time left
+    for (size_t i = 0; i < _tasks.size(); ++i)
+    {
+        if (_tasks[i].NextStep == nullptr) {
+            continue;
+        }
+
+        ++_tasks[i].Frames;
+        Timer taskTimer(false);
+        while (_tasks[i].NextStep != nullptr)
+        {
+            if (stepped && frameTimer.Elapsed<std::chrono::microseconds>() >= frameBudget.count()) {
+                break;
+            }
+            runStep(i);
+            stepped = true;
+            if (taskTimer.Elapsed<std::chrono::microseconds>() >= _tasks[i].Budget.count()) {
+                break;
+            }
+        }
+    }
+
+    removeDone();
+}
+
+void
+TaskScheduler::RunAll(void)
+{
+    for (size_t i = 0; i < _tasks.size(); ++i)
+    {
+        if (_tasks[i].NextStep != nullptr) {
+            Finish(_tasks[i].Id);
+        }
+    }
+    removeDone();
+}
+
+bool
+TaskScheduler::IsPending(TaskId id) const
+{
+    return findPending(id) < _tasks.size();
+}
+
+size_t
+TaskScheduler::GetPendingCount(void) const
+{
+    return static_cast<size_t>(std::count_if(_tasks.begin(), _tasks.end(), [](const Task& task) {
+        return task.NextStep != nullptr;
+    }));
+}
+
+TaskScheduler::Step
+TaskScheduler::ForEach(size_t count, std::function<void(size_t)> work)
+{ // Static function
+    // Shared, because the copies of a step must resume from the same index
+    std::shared_ptr<size_t> next = std::make_shared<size_t>(0);
+    return [count, work = std::move(work), next]()
+    {
+        if (*next < count) {
+            work((*next)++);
+        }
+        return *next >= count;
+    };
+}
+
+// Private methods
+
+size_t
+TaskScheduler::findPending(TaskId id) const
+{
+    const auto it = std::find_if(_tasks.begin(), _tasks.end(), [id](const Task& task) {
+        return task.Id == id && task.NextStep != nullptr;
+    });
+    return static_cast<size_t>(it - _tasks.begin());
+}
+
+void
+TaskScheduler::runStep(size_t index)
+{
+    // The step is moved out of the vector while it runs, the vector may grow under it
+    Step step = std::move(_tasks[index].NextStep);
+    _tasks[index].NextStep = nullptr;
+    const bool finished = step();
+
+    Task& task = _tasks[index];
+    ++task.Steps;
+    if (finished) {
+        Logger::Debug("Task \"{}\" finished in {} steps over {} frames", task.Name, task.Steps, task.Frames);
+    } else {
+        task.NextStep = std::move(step);
+    }
+}
+
+void
+TaskScheduler::removeDone(void)
+{
+    _tasks.erase(std::remove_if(_tasks.begin(), _tasks.end(), [](const Task& task) {
+        return task.NextStep == nullptr;
+    }), _tasks.end());
+}
@@ -0,0 +1,89 @@
+#ifndef TASKSCHEDULER_HPP
+#define TASKSCHEDULER_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+
+/// Spreads heavy work, such as rasterizing the textures of a menu, across several frames instead of
+/// doing it in one synchronous call that stalls the frame it happens in. A task is a resumable step
+/// function that does a small slice of its work per call. Once per frame RunFrame calls the steps of
+/// the pending tasks, oldest first, until the budget of the task or the frame is spent, and the rest
+/// of the work continues in the next frame. The oldest task always gets at least one step per frame,
+/// so every task finishes even when there is no time left in the frames.
+/// Tasks run on the calling thread, the steps may thus use the renderer.
+class TaskScheduler
+{
+public:
+    using TaskId       = size_t;
+    using Microseconds = std::chrono::microseconds;
+
+    /// Does the next slice of the work of a task.
+    /// @return true when the task is finished.
+    using Step = std::function<bool(void)>;
+
+    inline static constexpr TaskId       NULL_TASK      = 0;
+    inline static constexpr Microseconds DEFAULT_BUDGET = Microseconds(2000);
+
+    TaskScheduler(void);
+    TaskScheduler(const TaskScheduler& other) = delete;
+    TaskScheduler(TaskScheduler&& other)      = delete;
+    ~TaskScheduler(void) = default;
+
+    /// @param name Identifies the task in the log.
+    /// @param budget The most time to spend on the task per frame, measured after every step.
+    /// @return The id of the task, never NULL_TASK.
+    TaskId Add(const std::string& name, Step step, Microseconds budget = DEFAULT_BUDGET);
+
+    /// Drops a task without running the rest of its steps, must be called before anything the steps
+    /// refer to is destroyed. Does nothing if the task is already finished.
+    void   Cancel(TaskId id);
+
+    /// Runs the rest of the steps of a task right away, when its result is needed in this frame.
+    /// Does nothing if the task is already finished.
+    void   Finish(TaskId id);
+
+    /// Runs the steps of the pending tasks for one frame.
+    /// @param frameBudget The most time to spend on all of the tasks together.
+    void   RunFrame(Microseconds frameBudget = Microseconds::max());
+
+    /// Runs every pending task to completion.
+    void   RunAll(void);
+
+    bool   IsPending(TaskId id)  const;
+    size_t GetPendingCount(void) const;
+
+    /// @return A step that calls work once for every index in [0, count), one index per step.
+    static Step ForEach(size_t count, std::function<void(size_t)> work);
+
+private:
+    struct Task
+    {
+        TaskId       Id;
+        std::string  Name;
+        Step         NextStep; // nullptr once the task is finished or cancelled
+        Microseconds Budget;
+        size_t       Steps;
+        size_t       Frames;
+    };
+
+    /// @return The index of the task, or the amount of tasks if it is not pending.
+    size_t findPending(TaskId id) const;
+
+    /// Runs one step of the pending task at index. The steps may add tasks, which can move the
+    /// tasks in the vector, so tasks are referred to by their index while a step runs.
+    void   runStep(size_t index);
+
+    /// Removes the finished and the cancelled tasks, never while a step runs.
+    void   removeDone(void);
+
+private:
+    std::vector<Task> _tasks;
+    TaskId            _nextId;
+
+};
+
+#endif // TASKSCHEDULER_HPP
@@ -0,0 +1,278 @@
+#include "TerrainCache.hpp"
+#include "Logger.hpp"
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+
+
+namespace
+{
+    int chunkOf(float x)
+    {
+        return static_cast<int>(std::floor(x / static_cast<float>(TerrainCache::CHUNK_WIDTH)));
+    }
+} // end anonymous namespace
+
+
+TerrainCache::TerrainCache(int height)
+    : _height(height)
+    , _blocks()
+    , _chunkBlocks()
+    , _slots()
+    , _targetsResetCount(0)
+    , _bakesCount(0)
+    , _targetsSupported(true)
+    , _bakeQueue()
+{
+    for (Slot& slot : _slots)
+    {
+        slot.Chunk    = -1;
+        slot.Checksum = 0;
+    }
+}
+
+void
+TerrainCache::SetBlocks(const std::vector<std::unique_ptr<GameObject>>& blocks)
+{
+    _blocks.clear();
+    _chunkBlocks.clear();
+    for (Slot& slot : _slots) {
+        slot.Chunk = -1;
+    }
+
+    for (const auto& o : blocks)
+    {
+        const BoxObject* box = dynamic_cast<const BoxObject*>(o.get());
+        if (box == nullptr) {
+            continue;
+        }
+
+        const RectangleF rect  = box->GetCollissionRect();
+        const int        first = std::max(0, chunkOf(rect.X));
+        const int        last  = chunkOf(rect.X + rect.W);
+        if (last < first) {
+            continue;
+        }
+        if (static_cast<size_t>(last) >= _chunkBlocks.size()) {
+            _chunkBlocks.resize(static_cast<size_t>(last) + 1);
+        }
+        for (int chunk = first; chunk <= last; ++chunk) {
+            _chunkBlocks[static_cast<size_t>(chunk)].push_back(_blocks.size());
+        }
+        _blocks.push_back(box);
+    }
+}
+
+bool
+TerrainCache::NeedsBaking(const Renderer& renderer, const Camera& camera) const
+{
+    if (!_targetsSupported) {
+        return false;
+    }
+    if (renderer.GetTargetsResetCount() != _targetsResetCount) {
+        return true;
+    }
+
+    int first, last;
+    GetBakeRange(camera, first, last);
+    for (int chunk = first; chunk <= last; ++chunk) {
+        if (!IsBaked(chunk)) { return true; }
+    }
+    return false;
+}
+
+void
+TerrainCache::Bake(const Renderer& renderer, const Camera& camera)
+{
+    if (SDL_RenderTargetSupported(renderer.GetSdlRenderer()) != SDL_TRUE)
+    {
+        if (_targetsSupported) {
+            Logger::Critical("The renderer does not support render targets, the terrain is drawn block by block");
+        }
+        _targetsSupported = false;
+        return;
+    }
+
+    // The contents of the render targets are lost, and after a device reset the textures too
+    if (renderer.GetTargetsResetCount() != _targetsResetCount)
+    {
+        Logger::Debug("Render targets reset, baking the terrain chunks again");
+        for (Slot& slot : _slots)
+        {
+            if (slot.ChunkTexture.GetTexture() != nullptr) {
+                createChunkTexture(renderer, slot);
+            }
+            slot.Chunk = -1;
+        }
+        _targetsResetCount = renderer.GetTargetsResetCount();
+    }
+
+    int first, last;
+    GetBakeRange(camera, first, last);
+    for (int chunk = first; chunk <= last; ++chunk)
+    {
+        const int baked = findSlot(chunk);
+        if (baked >= 0 && _slots[static_cast<size_t>(baked)].Checksum == getChecksum(chunk)) {
+            continue;
+        }
+
+        Slot& slot = baked >= 0 ? _slots[static_cast<size_t>(baked)] : takeSlot(first, last);
+        if (!bakeChunk(renderer, camera, slot, chunk)) {
+            slot.Chunk = -1;
+        }
+    }
+    renderer.SetRenderTarget(nullptr);
+}
+
+void
+TerrainCache::Draw(RenderQueue& queue, const Camera& camera) const
+{
+    if (_chunkBlocks.empty()) {
+        return;
+    }
+
+    const int first = std::max(0, chunkOf(static_cast<float>(camera.GetX())));
+    const int last  = std::min(static_cast<int>(_chunkBlocks.size()) - 1,
+                               chunkOf(static_cast<float>(camera.GetX() + camera.GetWidth() - 1)));
+    for (int chunk = first; chunk <= last; ++chunk)
+    {
+        const int slot = findSlot(chunk);
+        if (slot < 0 || _slots[static_cast<size_t>(slot)].Checksum != getChecksum(chunk))
+        {
+            drawBlocks(queue, camera, chunk);
+            continue;
+        }
+
+        const SDL_Rect dstrect = { chunk * CHUNK_WIDTH - camera.GetX(), 0, CHUNK_WIDTH, _height };
+        queue.Copy(RenderQueue::Layer::TERRAIN, _slots[static_cast<size_t>(slot)].ChunkTexture.GetTexture(),
+                   nullptr, &dstrect);
+    }
+
+#ifdef DRAW_COLLIDERS
+    for (const BoxObject* box : _blocks)
+    {
+        if (camera.RectangleIsInViewport(box->GetCollissionRect())) {
+            queue.DrawRectangle(RenderQueue::Layer::DEBUG, camera.TransformRectangle(box->GetCollissionRect()),
+                                { Constants::Colors::WHITE });
+        }
+    }
+#endif
+}
+
+void
+TerrainCache::GetBakeRange(const Camera& camera, int& first, int& last) const
+{
+    const float left  = static_cast<float>(camera.GetX() - CHUNK_WIDTH / 2);
+    const float right = static_cast<float>(camera.GetX() + camera.GetWidth() + CHUNK_WIDTH / 2 - 1);
+    first = std::max(0, chunkOf(left));
+    last  = std::min(static_cast<int>(_chunkBlocks.size()) - 1, chunkOf(right));
+
+    // A wide viewport would otherwise evict the chunks it is about to draw, keep the ones closest to the centre
+    const int centreChunk = chunkOf(camera.GetCenterPositionF().X);
+    while (last - first + 1 > static_cast<int>(POOL_SIZE))
+    {
+        if (centreChunk - first > last - centreChunk) { ++first; }
+        else { --last; }
+    }
+}
+
+bool
+TerrainCache::IsBaked(int chunk) const
+{
+    const int slot = findSlot(chunk);
+    return slot >= 0 && _slots[static_cast<size_t>(slot)].Checksum == getChecksum(chunk);
+}
+
+size_t
+TerrainCache::GetBakesCount(void) const { return _bakesCount; }
+
+// Private methods
+
+uint32_t
+TerrainCache::getChecksum(int chunk) const
+{
+    // FNV-1a over the colors
+    uint32_t hash = 2166136261u;
+    for (const size_t index : _chunkBlocks[static_cast<size_t>(chunk)])
+    {
+        hash ^= Color::ToUint32_t(_blocks[index]->GetColor());
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+int
+TerrainCache::findSlot(int chunk) const
+{
+    for (size_t i = 0; i < _slots.size(); ++i) {
+        if (_slots[i].Chunk == chunk) { return static_cast<int>(i); }
+    }
+    return -1;
+}
+
+TerrainCache::Slot&
+TerrainCache::takeSlot(int first, int last)
+{
+    // The chunks in the range are never farther than the ones outside of it
+    const auto distance = [first, last](const Slot& slot) {
+        if (slot.Chunk < 0) {
+            return INT_MAX;
+        }
+        return std::max({ 0, first - slot.Chunk, slot.Chunk - last });
+    };
+    return *std::max_element(_slots.begin(), _slots.end(), [&distance](const Slot& a, const Slot& b) {
+        return distance(a) < distance(b);
+    });
+}
+
+bool
+TerrainCache::createChunkTexture(const Renderer& renderer, Slot& slot) const
+{
+    slot.ChunkTexture.CreateTexture(renderer, { CHUNK_WIDTH, _height });
+    if (slot.ChunkTexture.GetTexture() == nullptr) {
+        return false;
+    }
+    slot.ChunkTexture.SetBlendMode(Renderer::BlendMode::BLEND);
+    return true;
+}
+
+bool
+TerrainCache::bakeChunk(const Renderer& renderer, const Camera& camera, Slot& slot, int chunk)
+{
+    if (slot.ChunkTexture.GetTexture() == nullptr && !createChunkTexture(renderer, slot)) {
+        return false;
+    }
+
+    renderer.SetRenderTarget(slot.ChunkTexture.GetTexture());
+    renderer.SetDrawBlendMode(Renderer::BlendMode::NONE);
+    renderer.SetRenderDrawColor({ 0, 0, 0, 0 });
+    renderer.RenderClear();
+
+    // Offset the screen rectangles of the blocks by the camera so that they land on exactly the same
+    // pixels as when the blocks are filled one by one
+    const int offsetX = camera.GetX() - chunk * CHUNK_WIDTH;
+    for (const size_t index : _chunkBlocks[static_cast<size_t>(chunk)])
+    {
+        const BoxObject* box  = _blocks[index];
+        Rectangle        rect = box->GetScreenRect(camera, Timestep());
+        rect.X += offsetX;
+        _bakeQueue.FillRectangle(RenderQueue::Layer::TERRAIN, rect, box->GetColor());
+    }
+    _bakeQueue.Flush(renderer);
+
+    slot.Chunk    = chunk;
+    slot.Checksum = getChecksum(chunk);
+    ++_bakesCount;
+    return true;
+}
+
+void
+TerrainCache::drawBlocks(RenderQueue& queue, const Camera& camera, int chunk) const
+{
+    for (const size_t index : _chunkBlocks[static_cast<size_t>(chunk)])
+    {
+        const BoxObject* box = _blocks[index];
+        queue.FillRectangle(RenderQueue::Layer::TERRAIN, box->GetScreenRect(camera, Timestep()), box->GetColor());
+    }
+}
@@ -0,0 +1,99 @@
+#ifndef TERRAINCACHE_HPP
+#define TERRAINCACHE_HPP
+
+#include "Camera.hpp"
+#include "Color.hpp"
+#include "GameObject.hpp"
+#include "Geometry.hpp"
+#include "RenderQueue.hpp"
+#include "Renderer.hpp"
+#include "Texture.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+
+/// The blocks of a FIXED level never move, so instead of filling every visible block each frame they
+/// are baked into render target textures, one per chunk of CHUNK_WIDTH pixels of the level, and a frame
+/// copies the two or three chunks in the viewport. The chunks are baked when the camera approaches them,
+/// into a small pool of textures that is recycled from the chunks farthest away from the camera. A chunk
+/// is baked again when the color of one of its blocks changes, or when the render targets are reset.
+class TerrainCache
+{
+public:
+    inline static constexpr int    CHUNK_WIDTH = 1024;
+    inline static constexpr size_t POOL_SIZE   = 4;
+
+    /// @param height The height of the chunk textures, the blocks are drawn on the y-axis as they are.
+    TerrainCache(int height);
+    TerrainCache(const TerrainCache& other) = delete;
+    TerrainCache(TerrainCache&& other)      = delete;
+    ~TerrainCache(void) = default;
+
+    /// Assigns the blocks to the chunks they overlap, and discards the baked chunks. The objects that
+    /// are not boxes are ignored. The blocks must outlive the cache or the next call.
+    void SetBlocks(const std::vector<std::unique_ptr<GameObject>>& blocks);
+
+    /// @return true if a chunk near the viewport is not baked or is out of date.
+    bool NeedsBaking(const Renderer& renderer, const Camera& camera) const;
+
+    /// Bakes the chunks near the viewport that need it, does nothing if the renderer does not support
+    /// render targets. This changes the render target and draws into textures that the previously
+    /// recorded frames may refer to.
+    void Bake(const Renderer& renderer, const Camera& camera);
+
+    /// Submits the copies of the chunks in the viewport. The blocks of a chunk that is not baked, or is
+    /// out of date, are filled one by one instead.
+    void Draw(RenderQueue& queue, const Camera& camera) const;
+
+    /// The chunks that are kept baked for camera, as [first, last]: the chunks overlapping the viewport
+    /// widened by half a chunk on both sides, trimmed around the centre of the viewport to POOL_SIZE.
+    /// Empty, last < first, if there are no blocks in it.
+    void GetBakeRange(const Camera& camera, int& first, int& last) const;
+
+    /// @return true if chunk is baked and none of its blocks has been recolored since.
+    bool IsBaked(int chunk) const;
+
+    /// @return The amount of chunks baked since the cache was created.
+    size_t GetBakesCount(void) const;
+
+private:
+    struct Slot
+    {
+        Texture  ChunkTexture;
+        int      Chunk;    // -1 if the slot is free
+        uint32_t Checksum; // Of the block colors of the chunk when it was baked
+    };
+
+    /// @return A hash of the colors of the blocks of chunk, changes when one of them is recolored.
+    uint32_t getChecksum(int chunk) const;
+
+    /// @return The index of the slot that holds chunk, or -1.
+    int   findSlot(int chunk) const;
+
+    /// @return A free slot, or the slot of the chunk farthest from the chunks [first, last] being baked.
+    Slot& takeSlot(int first, int last);
+
+    /// Creates the render target texture of slot, replacing its previous texture.
+    bool createChunkTexture(const Renderer& renderer, Slot& slot) const;
+
+    bool bakeChunk(const Renderer& renderer, const Camera& camera, Slot& slot, int chunk);
+
+    void drawBlocks(RenderQueue& queue, const Camera& camera, int chunk) const;
+
+private:
+    int                                  _height;
+    std::vector<const BoxObject*>        _blocks;
+    std::vector<std::vector<size_t>>     _chunkBlocks; // Indices into _blocks, of the blocks overlapping each chunk
+    std::array<Slot, POOL_SIZE>          _slots;
+    uint32_t                             _targetsResetCount; // Of the renderer, when the slots were baked
+    size_t                               _bakesCount;
+    bool                                 _targetsSupported; // false if baking is not possible
+    RenderQueue                          _bakeQueue;
+
+};
+
+#endif // TERRAINCACHE_HPP
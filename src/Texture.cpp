@@ -6,20 +6,27 @@
 
 Texture::Texture(void)
     : _texture(nullptr)
+    , _region({ 0, 0, 0, 0 })
+    , _isRegion(false)
 {
     //
 }
 
 Texture::Texture(const Renderer& renderer, SDL_Surface* surface)
     : _texture(nullptr)
+    , _region({ 0, 0, 0, 0 })
+    , _isRegion(false)
 {
     CreateTexture(renderer, surface);
 }
 
 Texture::Texture(Texture&& other) noexcept
     : _texture(other._texture)
+    , _region(other._region)
+    , _isRegion(other._isRegion)
 {
-    other._texture = nullptr;
+    other._texture  = nullptr;
+    other._isRegion = false;
 }
 
 Texture::~Texture(void)
@@ -73,6 +80,15 @@ Texture::CreaateTextureTiled(const Renderer& renderer, Dimensions2D size, SDL_Su
     surfTex = nullptr;
 }
 
+void
+Texture::SetRegion(SDL_Texture* texture, const SDL_Rect& region)
+{
+    destroyTexture();
+    _texture  = texture;
+    _region   = region;
+    _isRegion = true;
+}
+
 void
 Texture::SetColorModulation(Color color) const
 {
@@ -106,6 +122,10 @@ Texture::GetTexture(void) const
 Dimensions2D
 Texture::GetSize(void) const
 {
+    if (_isRegion) {
+        return { _region.w, _region.h };
+    }
+
     Dimensions2D size;
     if (SDL_QueryTexture(_texture, nullptr, nullptr, &size.W, &size.H) != 0) {
         Logger::Critical("Unable to query the the size for texture: {}", SDL_GetError());
@@ -114,11 +134,35 @@ Texture::GetSize(void) const
     return size;
 }
 
+bool
+Texture::IsRegion(void) const { return _isRegion; }
+
+SDL_Rect
+Texture::GetRegion(void) const
+{
+    if (_isRegion) {
+        return _region;
+    }
+
+    const Dimensions2D size = GetSize();
+    return { 0, 0, size.W, size.H };
+}
+
 void
 Texture::Render(const Renderer& renderer, const SDL_Rect* srcrect, const SDL_Rect* dstrect) const
 {
     assert(_texture != nullptr); // Need to call CreateTexture before rendering
-    renderer.RenderCopy(_texture, srcrect, dstrect);
+    if (!_isRegion)
+    {
+        renderer.RenderCopy(_texture, srcrect, dstrect);
+        return;
+    }
+
+    SDL_Rect regionSrc = _region;
+    if (srcrect != nullptr) {
+        regionSrc = { _region.x + srcrect->x, _region.y + srcrect->y, srcrect->w, srcrect->h };
+    }
+    renderer.RenderCopy(_texture, &regionSrc, dstrect);
 }
 
 // Private functions
@@ -128,6 +172,9 @@ Texture::destroyTexture(void)
     if (_texture == nullptr) {
         return;
     }
-    SDL_DestroyTexture(_texture);
-    _texture = nullptr;
+    if (!_isRegion) {
+        SDL_DestroyTexture(_texture);
+    }
+    _texture  = nullptr;
+    _isRegion = false;
 }
@@ -31,6 +31,11 @@ public:
     /// Creates a horizontally tiled (2 times) texture from the surface.
     void CreaateTextureTiled(const Renderer& renderer, Dimensions2D size, SDL_Surface* surface);
 
+    /// Makes this refer to a region of a texture that it does not own, such as a page of a
+    /// TextureAtlas. Render then copies from the region and GetSize returns the size of the region.
+    /// NOTE: The modulation and the blend mode are those of the whole texture, not of the region.
+    void SetRegion(SDL_Texture* texture, const SDL_Rect& region);
+
     /// Modulates each of the color values of the texture according to the formula
     /// srcC = srcC * (color / 255) when it is rendered.
     void SetColorModulation(Color color) const;
@@ -42,12 +47,16 @@ public:
 
     SDL_Texture*       GetTexture(void) const;
     Dimensions2D       GetSize(void)    const;
+    bool               IsRegion(void)   const;
+
+    /// @return The area of GetTexture that is rendered, the whole texture if this is not a region.
+    SDL_Rect           GetRegion(void)  const;
 
     /// Copies the texture to the renderer target.
     /// NOTE: If stretchToRenderingTarget is passed the argument false then you also must
     ///       pass a pointer to dstrect.
     /// @param stretchToRenderingTarget true = stretch the texture to fill the whole rendering target.
-    /// @param srcrect The area of the texture to use. nullptr = use the whole texture.
+    /// @param srcrect The area of the texture to use. nullptr = use the whole texture. Relative to the region, if any.
     /// @param dstrect The area of the destination rectangle to copy the texture to. Use default arg dstrect = nullptr to fill the whole target.
     void Render(const Renderer& renderer,
                 const SDL_Rect* srcrect = nullptr,
@@ -58,6 +67,8 @@ private:
 
 private:
     SDL_Texture* _texture;
+    SDL_Rect     _region;
+    bool         _isRegion; // _texture is owned by someone else
 
 };
 
@@ -0,0 +1,121 @@
+#include "TextureAtlas.hpp"
+#include "Logger.hpp"
+
+#include <algorithm>
+#include <cstdint>
+
+
+TextureAtlas::TextureAtlas(Dimensions2D pageSize)
+    : _pageSize(pageSize)
+    , _pages()
+{
+    //
+}
+
+bool
+TextureAtlas::Add(const Renderer& renderer, SDL_Surface* surface, Texture& texture)
+{
+    if (surface == nullptr) {
+        return false;
+    }
+
+    const Dimensions2D padded = { surface->w + 2 * PADDING, surface->h + 2 * PADDING };
+    if (_pages.empty())
+    {
+        const Dimensions2D maxSize = renderer.GetMaxTextureSize();
+        if (maxSize.W > 0 && maxSize.H > 0) {
+            _pageSize = { std::min(_pageSize.W, maxSize.W), std::min(_pageSize.H, maxSize.H) };
+        }
+    }
+    if (padded.W > _pageSize.W || padded.H > _pageSize.H)
+    {
+        texture.CreateTexture(renderer, surface);
+        return texture.GetTexture() != nullptr;
+    }
+
+    Point2D position = { 0, 0 };
+    auto page = std::find_if(_pages.begin(), _pages.end(), [&padded, &position](Page& candidate) {
+        return candidate.Packer.Insert(padded, position);
+    });
+    if (page == _pages.end())
+    {
+        if (!createPage(renderer) || !_pages.back().Packer.Insert(padded, position)) {
+            return false;
+        }
+        page = _pages.end() - 1;
+    }
+
+    const SDL_Rect region = { position.X + PADDING, position.Y + PADDING, surface->w, surface->h };
+    if (!upload(*page, surface, region)) {
+        return false;
+    }
+    texture.SetRegion(page->PageTexture.GetTexture(), region);
+    return true;
+}
+
+void
+TextureAtlas::Clear(void)
+{
+    for (Page& page : _pages)
+    {
+        page.Packer.Clear();
+        clearPage(page);
+    }
+}
+
+size_t
+TextureAtlas::GetPageCount(void) const { return _pages.size(); }
+
+Dimensions2D
+TextureAtlas::GetPageSize(void) const { return _pageSize; }
+
+// Private methods
+
+bool
+TextureAtlas::createPage(const Renderer& renderer)
+{
+    _pages.push_back({ Texture(), SkylinePacker(_pageSize) });
+    Page& page = _pages.back();
+    page.PageTexture.CreateTexture(renderer, _pageSize, PIXEL_FORMAT, SDL_TEXTUREACCESS_STATIC);
+    if (page.PageTexture.GetTexture() == nullptr)
+    {
+        _pages.pop_back();
+        return false;
+    }
+    page.PageTexture.SetBlendMode(Renderer::BlendMode::BLEND);
+
+    // The contents of a new texture are undefined
+    clearPage(page);
+
+    Logger::Debug("Created texture atlas page {} of size {}x{}", _pages.size(), _pageSize.W, _pageSize.H);
+    return true;
+}
+
+void
+TextureAtlas::clearPage(const Page& page) const
+{
+    const std::vector<uint32_t> transparent(static_cast<size_t>(_pageSize.W) * static_cast<size_t>(_pageSize.H), 0u);
+    if (SDL_UpdateTexture(page.PageTexture.GetTexture(), nullptr, transparent.data(),
+                          _pageSize.W * static_cast<int>(sizeof(uint32_t))) != 0) {
+        Logger::Critical("Unable to clear texture atlas page: {}", SDL_GetError());
+    }
+}
+
+bool
+TextureAtlas::upload(const Page& page, SDL_Surface* surface, const SDL_Rect& region) const
+{
+    SDL_Surface* converted = SDL_ConvertSurfaceFormat(surface, PIXEL_FORMAT, 0);
+    if (converted == nullptr)
+    {
+        Logger::Critical("Unable to convert surface for texture atlas: {}", SDL_GetError());
+        return false;
+    }
+
+    const bool updated = SDL_UpdateTexture(page.PageTexture.GetTexture(), &region,
+                                           converted->pixels, converted->pitch) == 0;
+    if (!updated) {
+        Logger::Critical("Unable to copy surface into texture atlas page: {}", SDL_GetError());
+    }
+    SDL_FreeSurface(converted);
+    return updated;
+}
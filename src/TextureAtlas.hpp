@@ -0,0 +1,69 @@
+#ifndef TEXTUREATLAS_HPP
+#define TEXTUREATLAS_HPP
+
+#include "Geometry.hpp"
+#include "Renderer.hpp"
+#include "SkylinePacker.hpp"
+#include "Texture.hpp"
+
+#include <SDL.h>
+#include <cstddef>
+#include <vector>
+
+
+/// Packs small surfaces into a few large textures, the pages, so that drawing the textures one
+/// after another does not switch the texture between them, as in drawing the labels of a menu.
+/// The surfaces are copied into the pages, and the Textures they are added to refer to their
+/// regions of the pages. The pages are created when they are first needed and live as long as the
+/// atlas, which must thus outlive the Textures.
+class TextureAtlas
+{
+public:
+    inline static constexpr Dimensions2D DEFAULT_PAGE_SIZE = { 1024, 1024 };
+
+    /// @param pageSize Clamped to the largest texture size of the renderer.
+    TextureAtlas(Dimensions2D pageSize = DEFAULT_PAGE_SIZE);
+    TextureAtlas(const TextureAtlas& other) = delete;
+    TextureAtlas(TextureAtlas&& other)      = delete;
+    ~TextureAtlas(void) = default;
+
+    /// Copies surface into a page and makes texture refer to its region. A surface that is too large
+    /// for an empty page gets a texture of its own instead.
+    /// @return false if the surface could not be copied.
+    bool Add(const Renderer& renderer, SDL_Surface* surface, Texture& texture);
+
+    /// Frees the space of every page for adding the surfaces again, the regions added until now are
+    /// overwritten by the next ones. The textures of the pages are kept and made transparent again.
+    void Clear(void);
+
+    size_t       GetPageCount(void) const;
+    Dimensions2D GetPageSize(void)  const;
+
+private:
+    // The format that the surfaces are converted to, with an alpha channel for the text
+    inline static constexpr Uint32 PIXEL_FORMAT = SDL_PIXELFORMAT_ARGB8888;
+
+    // Between the regions, so that the neighbours do not bleed in when a region is scaled
+    inline static constexpr int PADDING = 1;
+
+    struct Page
+    {
+        Texture       PageTexture;
+        SkylinePacker Packer;
+    };
+
+    /// Creates an empty, fully transparent page.
+    bool createPage(const Renderer& renderer);
+
+    /// Makes every pixel of the page transparent, which the padding around the regions relies on.
+    void clearPage(const Page& page) const;
+
+    bool upload(const Page& page, SDL_Surface* surface, const SDL_Rect& region) const;
+
+private:
+    Dimensions2D      _pageSize;
+    std::vector<Page> _pages;
+
+};
+
+#endif // TEXTUREATLAS_HPP
@@ -0,0 +1,216 @@
+#include "TileMap.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+
+TileMap::TileMap(void)
+    : _origin{ 0.0f, 0.0f }
+    , _columns(0)
+    , _rows(0)
+    , _tileSize(1.0f)
+    , _tiles()
+    , _vertices()
+    , _indices()
+{
+    //
+}
+
+void
+TileMap::Reset(Point2DF origin, int columns, int rows, float tileSize)
+{
+    assert(columns >= 0 && rows >= 0);
+    assert(tileSize > 0.0f);
+
+    _origin   = origin;
+    _columns  = columns;
+    _rows     = rows;
+    _tileSize = tileSize;
+    _tiles.assign(static_cast<size_t>(_columns) * static_cast<size_t>(_rows), Tileset::EMPTY);
+}
+
+void
+TileMap::FillGroundBlock(RectangleF block, TileIndex top, TileIndex fill)
+{
+    const int colBegin = std::max(0,        static_cast<int>(std::lround((block.X - _origin.X) / _tileSize)));
+    const int colEnd   = std::min(_columns, static_cast<int>(std::lround((block.X + block.W - _origin.X) / _tileSize)));
+    const int rowTop   = std::max(0,        static_cast<int>(std::lround((block.Y - _origin.Y) / _tileSize)));
+
+    for (int col = colBegin; col < colEnd; ++col)
+    {
+        if (rowTop < _rows) {
+            SetTile(col, rowTop, top);
+        }
+        for (int row = rowTop + 1; row < _rows; ++row) {
+            SetTile(col, row, fill);
+        }
+    }
+}
+
+void
+TileMap::BuildColliders(std::vector<RectangleF>& rectangles) const
+{
+    int col = 0;
+    while (col < _columns)
+    {
+        const int height = columnHeight(col);
+        int runEnd = col + 1;
+        while (runEnd < _columns && columnHeight(runEnd) == height) {
+            ++runEnd;
+        }
+
+        if (height > 0)
+        {
+            rectangles.push_back({
+                _origin.X + static_cast<float>(col) * _tileSize,
+                _origin.Y + static_cast<float>(_rows - height) * _tileSize,
+                static_cast<float>(runEnd - col) * _tileSize,
+                static_cast<float>(height) * _tileSize
+            });
+        }
+
+        col = runEnd;
+    }
+}
+
+void
+TileMap::TranslateX(float dx)
+{
+    _origin.X += dx;
+}
+
+TileMap::TileIndex
+TileMap::GetTile(int column, int row) const
+{
+    return _tiles[index(column, row)];
+}
+
+void
+TileMap::SetTile(int column, int row, TileIndex tile)
+{
+    _tiles[index(column, row)] = tile;
+}
+
+const TileMap::TileIndex*
+TileMap::GetTiles(void) const { return _tiles.data(); }
+
+TileMap::TileIndex*
+TileMap::GetMutableTiles(void) { return _tiles.data(); }
+
+size_t
+TileMap::GetTilesCount(void) const { return _tiles.size(); }
+
+int
+TileMap::GetColumns(void) const { return _columns; }
+
+int
+TileMap::GetRows(void) const { return _rows; }
+
+float
+TileMap::GetTileSize(void) const { return _tileSize; }
+
+RectangleF
+TileMap::GetRectangleF(void) const
+{
+    return {
+        _origin.X,
+        _origin.Y,
+        static_cast<float>(_columns) * _tileSize,
+        static_cast<float>(_rows) * _tileSize
+    };
+}
+
+void
+TileMap::Draw(const Renderer& renderer, const Camera& camera, const Tileset& tileset) const
+{
+    if (!buildVertices(camera, tileset)) {
+        return;
+    }
+
+    renderer.RenderGeometry(
+        tileset.GetTexture().GetTexture(),
+        _vertices.data(), static_cast<int>(_vertices.size()),
+        _indices.data(),  static_cast<int>(_indices.size())
+    );
+}
+
+void
+TileMap::Draw(RenderQueue& queue, const Camera& camera, const Tileset& tileset) const
+{
+    if (!buildVertices(camera, tileset)) {
+        return;
+    }
+
+    queue.Geometry(
+        RenderQueue::Layer::TILES, tileset.GetTexture().GetTexture(),
+        _vertices.data(), static_cast<int>(_vertices.size()),
+        _indices.data(),  static_cast<int>(_indices.size())
+    );
+}
+
+// Private methods
+size_t
+TileMap::index(int column, int row) const
+{
+    assert(0 <= column && column < _columns);
+    assert(0 <= row    && row    < _rows);
+    return static_cast<size_t>(row) * static_cast<size_t>(_columns) + static_cast<size_t>(column);
+}
+
+int
+TileMap::columnHeight(int column) const
+{ // All terrain is anchored to the bottom, so the height is the count of tiles below the topmost solid one
+    for (int row = 0; row < _rows; ++row) {
+        if (GetTile(column, row) != Tileset::EMPTY) {
+            return _rows - row;
+        }
+    }
+    return 0;
+}
+
+bool
+TileMap::buildVertices(const Camera& camera, const Tileset& tileset) const
+{
+    const float cameraX  = static_cast<float>(camera.GetX());
+    const int   colBegin = std::max(0,        static_cast<int>(std::floor((cameraX - _origin.X) / _tileSize)));
+    const int   colEnd   = std::min(_columns, static_cast<int>(std::ceil((cameraX + static_cast<float>(camera.GetWidth()) - _origin.X) / _tileSize)));
+
+    if (colBegin >= colEnd) {
+        return false;
+    }
+
+    _vertices.clear();
+    _indices.clear();
+
+    const SDL_Color white = { 255, 255, 255, 255 };
+
+    for (int row = 0; row < _rows; ++row)
+    {
+        const float y0 = _origin.Y + static_cast<float>(row) * _tileSize;
+        const float y1 = y0 + _tileSize;
+
+        for (int col = colBegin; col < colEnd; ++col)
+        {
+            const TileIndex tile = GetTile(col, row);
+            if (tile == Tileset::EMPTY) {
+                continue;
+            }
+
+            // Camera transformations are only defined for the x-axis
+            const float x0 = _origin.X + static_cast<float>(col) * _tileSize - cameraX;
+            const float x1 = x0 + _tileSize;
+            const RectangleF uv = tileset.GetTexCoords(tile);
+            const int base = static_cast<int>(_vertices.size());
+
+            _vertices.push_back({ { x0, y0 }, white, { uv.X,        uv.Y        } });
+            _vertices.push_back({ { x1, y0 }, white, { uv.X + uv.W, uv.Y        } });
+            _vertices.push_back({ { x1, y1 }, white, { uv.X + uv.W, uv.Y + uv.H } });
+            _vertices.push_back({ { x0, y1 }, white, { uv.X,        uv.Y + uv.H } });
+
+            _indices.insert(_indices.end(), { base, base + 1, base + 2, base + 2, base + 3, base });
+        }
+    }
+
+    return !_vertices.empty();
+}
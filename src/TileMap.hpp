@@ -0,0 +1,80 @@
+#ifndef TILEMAP_HPP
+#define TILEMAP_HPP
+
+#include "Camera.hpp"
+#include "Geometry.hpp"
+#include "RenderQueue.hpp"
+#include "Renderer.hpp"
+#include "Tileset.hpp"
+
+#include <SDL.h>
+#include <vector>
+
+
+/// A grid of tile indices covering a rectangular area of the level. The grid is both drawn and
+/// used to derive the collision rectangles, so what is seen is exactly what is collided with.
+class TileMap
+{
+public:
+    using TileIndex = Tileset::TileIndex;
+
+public:
+    TileMap(void);
+    TileMap(const TileMap& other) = delete;
+    TileMap(TileMap&& other)      = delete;
+    ~TileMap(void) = default;
+
+    /// Empties the grid and resizes it, keeps the already allocated storage when possible.
+    /// @param origin The world coordinates of the top left corner of the grid.
+    void Reset(Point2DF origin, int columns, int rows, float tileSize);
+
+    /// Fills the tiles covered by a block that is standing on the bottom of the grid. The top
+    /// row of the block gets the tile top and the rest the tile fill. The block is snapped to
+    /// the grid and clipped to its boundaries.
+    void FillGroundBlock(RectangleF block, TileIndex top, TileIndex fill);
+
+    /// Merges consecutive columns of equal height into collision rectangles, in world coordinates.
+    /// @param rectangles The computed rectangles are appended to this vector.
+    void BuildColliders(std::vector<RectangleF>& rectangles) const;
+
+    void TranslateX(float dx);
+
+    TileIndex GetTile(int column, int row) const;
+    void      SetTile(int column, int row, TileIndex tile);
+
+    /// @return All GetTilesCount() tiles of the grid in row major order.
+    const TileIndex* GetTiles(void)        const;
+    TileIndex*       GetMutableTiles(void);
+    size_t           GetTilesCount(void)   const;
+
+    int        GetColumns(void)  const;
+    int        GetRows(void)     const;
+    float      GetTileSize(void) const;
+    RectangleF GetRectangleF(void) const;
+
+    /// Draws all the tiles of the grid that are inside the camera viewport with one draw call.
+    void Draw(const Renderer& renderer, const Camera& camera, const Tileset& tileset) const;
+    void Draw(RenderQueue& queue, const Camera& camera, const Tileset& tileset)       const;
+
+private:
+    size_t index(int column, int row) const;
+    int    columnHeight(int column)   const;
+
+    /// Builds the vertices of the tiles inside the camera viewport.
+    /// @return false if there are none.
+    bool   buildVertices(const Camera& camera, const Tileset& tileset) const;
+
+private:
+    Point2DF               _origin;
+    int                    _columns;
+    int                    _rows;
+    float                  _tileSize;
+    std::vector<TileIndex> _tiles; // Row major
+
+    // Reused between frames so that drawing does not allocate in the steady state
+    mutable std::vector<SDL_Vertex> _vertices;
+    mutable std::vector<int>        _indices;
+
+};
+
+#endif // TILEMAP_HPP
@@ -0,0 +1,61 @@
+#include "Tileset.hpp"
+#include "Constants.hpp"
+#include "Logger.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+
+Tileset::Tileset(int tileSize)
+    : _tileSize(tileSize)
+    , _atlas()
+{
+    assert(_tileSize > 0);
+}
+
+void
+Tileset::UpdateTexture(const Renderer& renderer)
+{
+    // NOTE: Only the background of the free platformer tileset is included in the resources, so the
+    //       tiles are painted here in the colors used for the rest of the level.
+    SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormat(
+        0, TILES_COUNT * _tileSize, _tileSize, 32, SDL_PIXELFORMAT_RGBA32
+    );
+    if (surface == nullptr) {
+        Logger::Critical("Unable to create surface for the tileset atlas: {}", SDL_GetError());
+        return;
+    }
+
+    auto fill = [surface](SDL_Rect rect, Color c) {
+        if (SDL_FillRect(surface, &rect, SDL_MapRGBA(surface->format, c.r, c.g, c.b, c.a)) != 0) {
+            Logger::Debug("Unable to fill tileset atlas rectangle: {}", SDL_GetError());
+        }
+    };
+
+    const int edge = std::max(1, _tileSize / 8);
+
+    fill({ 0, 0, surface->w, surface->h }, Color(0x0000'0000)); // EMPTY, transparent
+
+    const int topX = GROUND_TOP * _tileSize;
+    fill({ topX, 0,    _tileSize, _tileSize },        Constants::Colors::DARK);
+    fill({ topX, 0,    _tileSize, 2 * edge },         Constants::Colors::LIGHT);
+    fill({ topX, 0,    _tileSize, edge / 2 + 1 },     Constants::Colors::LIGHTEST);
+
+    const int fillX = GROUND_FILL * _tileSize;
+    fill({ fillX, 0,   _tileSize, _tileSize },        Constants::Colors::DARK);
+    fill({ fillX, 0,   edge,      _tileSize },        Constants::Colors::DARKEST);
+
+    _atlas.CreateTexture(renderer, surface);
+    SDL_FreeSurface(surface);
+}
+
+RectangleF
+Tileset::GetTexCoords(TileIndex tile) const
+{
+    assert(tile < TILES_COUNT);
+    const float tileWidth = 1.0f / static_cast<float>(TILES_COUNT);
+    return { static_cast<float>(tile) * tileWidth, 0.0f, tileWidth, 1.0f };
+}
+
+const Texture&
+Tileset::GetTexture(void) const { return _atlas; }
@@ -0,0 +1,42 @@
+#ifndef TILESET_HPP
+#define TILESET_HPP
+
+#include "Color.hpp"
+#include "Geometry.hpp"
+#include "Renderer.hpp"
+#include "Texture.hpp"
+
+#include <cstdint>
+
+
+/// A texture atlas holding all the tiles of a tileset in a single row, so that any amount
+/// of tiles can be drawn with one draw call.
+class Tileset
+{
+public:
+    using TileIndex = uint8_t;
+
+    /// Index 0 is reserved for empty tiles and is never drawn.
+    enum Tiles : TileIndex { EMPTY = 0, GROUND_TOP, GROUND_FILL, TILES_COUNT };
+
+public:
+    /// @param tileSize The width and height in pixels of one tile in the atlas.
+    Tileset(int tileSize);
+    Tileset(const Tileset& other) = delete;
+    Tileset(Tileset&& other)      = delete;
+    ~Tileset(void) = default;
+
+    /// (Re)creates the atlas texture. Must be called before the tileset is drawn.
+    void UpdateTexture(const Renderer& renderer);
+
+    /// @return The area of the tile in the atlas in normalized [0,1] texture coordinates.
+    RectangleF     GetTexCoords(TileIndex tile) const;
+    const Texture& GetTexture(void)             const;
+
+private:
+    const int _tileSize;
+    Texture   _atlas;
+
+};
+
+#endif // TILESET_HPP
@@ -135,6 +135,12 @@ LevelTimer::DeductTime(Timestep ts)
     _timeLeft -= Duration(ts);
 }
 
+void
+LevelTimer::SetTimeLeft(Timestep ts)
+{
+    _timeLeft = Duration(ts);
+}
+
 bool
 LevelTimer::IsPositive(void) const
 {
@@ -155,6 +161,9 @@ GameloopTimer::GameloopTimer(size_t iterationFreq, size_t updateFreq, double upd
     , _timeCurrent(Clock::now())
     , _updatesLimit(static_cast<size_t>(updateTimeMax * DUR_ONE_SECOND / _dtUpdate))
     , _updatesDone(0)
+    , _fastForwardUpdates(0)
+    , _fastForwardUpdatesDone(0)
+    , _fastForwardStart(Clock::now())
 {
     //
 }
@@ -179,6 +188,16 @@ GameloopTimer::InitIteration(void)
 bool
 GameloopTimer::ShouldDoUpdates(void)
 {
+    if (_fastForwardUpdates > 0)
+    {
+        if (_updatesDone == _fastForwardUpdates) {
+            return false;
+        }
+        ++_updatesDone;
+        ++_fastForwardUpdatesDone;
+        return true;
+    }
+
     if (_accumulatedLag < _dtUpdate) {
         return false;
     }
@@ -215,15 +234,41 @@ GameloopTimer::GetUpdateDeltaTime(void) const
 Timestep
 GameloopTimer::GetLag(void) const
 {
-    return { _accumulatedLag.count() };
+    return { _fastForwardUpdates > 0 ? 0.0 : _accumulatedLag.count() };
 }
 
 Timestep
 GameloopTimer::GetSleeptime(void) const
 {
+    if (_fastForwardUpdates > 0) {
+        return { 0.0 };
+    }
     return { (_targetTime - Duration{Clock::now() - _timeCurrent}).count() };
 }
 
+void
+GameloopTimer::SetFastForward(size_t updatesPerIteration)
+{
+    _fastForwardUpdates     = updatesPerIteration;
+    _fastForwardUpdatesDone = 0;
+    _fastForwardStart       = Clock::now();
+    // The time passed while fast-forwarding has already been simulated
+    ResetFields();
+}
+
+bool
+GameloopTimer::IsFastForward(void) const { return _fastForwardUpdates > 0; }
+
+double
+GameloopTimer::GetFastForwardSpeed(void) const
+{
+    const Duration elapsed = Clock::now() - _fastForwardStart;
+    if (elapsed.count() <= 0.0) {
+        return 0.0;
+    }
+    return static_cast<double>(_fastForwardUpdatesDone) * _dtUpdate.count() / elapsed.count();
+}
+
 
 TimeEstimate::TimeEstimate(Timestep estimate, double mean)
     : _estimate(estimate)
@@ -83,6 +83,7 @@ public:
     ~LevelTimer(void) = default;
 
     void DeductTime(Timestep ts);
+    void SetTimeLeft(Timestep ts);
 
     bool IsPositive(void)      const;
     Timestep GetTimeLeft(void) const;
@@ -141,6 +142,14 @@ public:
     /// Returns the time delta between the target loop iteration time and the time spent in the loop.
     Timestep GetSleeptime(void) const;
 
+    /// In fast-forward, every loop iteration does exactly the given amount of updates back to back,
+    /// regardless of the time passed, and there is no time left to sleep. 0 returns to real time pacing.
+    void     SetFastForward(size_t updatesPerIteration);
+    bool     IsFastForward(void) const;
+
+    /// Returns the simulated time per real time since fast-forward was turned on.
+    double   GetFastForwardSpeed(void) const;
+
 private:
     inline static constexpr Duration DUR_ONE_SECOND = Duration(1.0);
 
@@ -153,6 +162,10 @@ private:
     size_t _updatesLimit; // Maximum number of updates to do per game loop iteration.
     size_t _updatesDone;  // Amount of updates done during this game loop iteration.
 
+    size_t     _fastForwardUpdates; // Updates per loop iteration in fast-forward, 0 when not fast-forwarding.
+    size_t     _fastForwardUpdatesDone;
+    Time_point _fastForwardStart;
+
 };
 
 /// This class computes an ever more precise estimate of a duration, based on historical durations.
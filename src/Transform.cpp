@@ -1,5 +1,6 @@
 #include "Transform.hpp"
 #include "Logger.hpp"
+#include "Motion.hpp"
 
 
 Transform::Transform(void)
@@ -43,51 +44,25 @@ Transform::Transform(const glm::vec3& position, const glm::vec3& velocity, const
 void
 Transform::BounceYAxis(void)
 {
-    if (_velocity.y > 0.0f) {
-        _velocity.y *= -1.0f;
-    }
+    _velocity.y = Motion::Bounce(_velocity.y);
 }
 
 void
 Transform::UpdatePhysics(const Physics& physicsEngine, RectangleF boundaries, Timestep dt)
 { // virtual override member function from PhysicsObject
-#define BOUNCE // TODO: Delete this hack
-
+    // The acceleration matrix only has the friction on its diagonal and the force in its translation
+    // column, so the axes are independent of each other
     const float deltaTime = static_cast<float>(dt);
-    physicsEngine.Update(*this);
-
-    // TODO: Vectorize all operations
-    _acceleration[0].x = glm::pow(_acceleration[0].x, deltaTime); // Diagonal (friction)
-    _acceleration[1].y = glm::pow(_acceleration[1].y, deltaTime); // Diagonal (friction)
-    _acceleration[2].z = glm::pow(_acceleration[2].z, deltaTime); // Diagonal (friction)
-
-    _acceleration[3].x *= deltaTime; // Transform (move)
-    _acceleration[3].y *= deltaTime; // Transform (move)
-    _acceleration[3].z *= deltaTime; // Transform (move)
-
-    _velocity = _acceleration * _velocity;
-
-    if (_position.x + _velocity.x < boundaries.X) {
-        _velocity.x = boundaries.X - _position.x;
-    } else if (_position.x + _velocity.x > boundaries.W) {
-        _velocity.x = boundaries.W - _position.x;
+    const glm::vec3& gravity  = physicsEngine.GetGravity();
+    const glm::vec3& friction = physicsEngine.GetFriction();
+    for (glm::length_t axis = 0; axis < 3; ++axis)
+    {
+        _velocity[axis] = Motion::StepAxis(gravity[axis], friction[axis], deltaTime,
+                                           _acceleration[axis][axis], _acceleration[3][axis], _velocity[axis]);
     }
 
-    if (_position.y + _velocity.y < boundaries.Y) {
-        _velocity.y = boundaries.Y - _position.y;
-    }
-
-
-#ifdef BOUNCE
-    else if (_velocity.y > 0.0f && _velocity.y + _position.y > boundaries.H) {
-        _velocity.y = boundaries.H - _position.y + _velocity.y;
-    }
-#undef BOUNCE
-#else
-    else if (_position.y + _velocity.y > boundaries.H) {
-        _velocity.y = boundaries.H - _position.y;
-    }
-#endif
+    _velocity.x = Motion::LimitX(_position.x, _velocity.x, boundaries.X, boundaries.W);
+    _velocity.y = Motion::LimitY(_position.y, _velocity.y, boundaries.Y, boundaries.H);
 
     _position += _velocity;
 }
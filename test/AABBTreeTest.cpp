@@ -0,0 +1,155 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h" //EXPECT_THAT macro, matchers
+
+#include "AABBTree.hpp"
+#include "Helpers.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+
+namespace
+{
+    RectangleF randomRect(Helpers::random::Generator& random, float worldSize, float maxSize)
+    {
+        return {
+            random.FloatInRange(0.0f, worldSize), random.FloatInRange(0.0f, worldSize),
+            random.FloatInRange(1.0f, maxSize),   random.FloatInRange(1.0f, maxSize)
+        };
+    }
+
+    std::vector<size_t> queryIds(const AABBTree& tree, const RectangleF& rect)
+    {
+        std::vector<size_t> ids;
+        tree.QueryOverlaps(rect, [&tree, &ids](AABBTree::Proxy proxy)
+        {
+            ids.push_back(tree.GetId(proxy));
+            return true;
+        });
+        std::sort(ids.begin(), ids.end());
+        return ids;
+    }
+
+    std::vector<size_t> bruteForceIds(const std::vector<RectangleF>& rects, const std::vector<bool>& alive, const RectangleF& rect)
+    {
+        std::vector<size_t> ids;
+        for (size_t i = 0; i < rects.size(); ++i) {
+            if (alive[i] && rects[i].Overlaps(rect)) {
+                ids.push_back(i);
+            }
+        }
+        return ids;
+    }
+} // end anonymous namespace
+
+
+TEST(AABBTreeTest, QueriesMatchBruteForceWhileLeavesMove)
+{
+    Helpers::random::Generator random(1);
+    AABBTree tree(2.0f);
+    std::vector<RectangleF>       rects;
+    std::vector<bool>             alive;
+    std::vector<AABBTree::Proxy>  proxies;
+    for (size_t i = 0; i < 1000; ++i)
+    {
+        rects.push_back(randomRect(random, 1000.0f, 40.0f));
+        alive.push_back(true);
+        proxies.push_back(tree.Insert(rects.back(), i));
+    }
+    ASSERT_TRUE(tree.IsValid());
+
+    for (size_t round = 0; round < 20; ++round)
+    {
+        for (size_t i = 0; i < rects.size(); ++i)
+        {
+            if (!alive[i] || random.FloatInRange(0.0f, 1.0f) > 0.3f) {
+                continue;
+            }
+            rects[i].X += random.FloatInRange(-5.0f, 5.0f);
+            rects[i].Y += random.FloatInRange(-5.0f, 5.0f);
+            tree.Move(proxies[i], rects[i]);
+        }
+
+        // Remove some leaves and insert them back later
+        const size_t index = static_cast<size_t>(random.FloatInRange(0.0f, 999.0f));
+        if (alive[index]) {
+            tree.Remove(proxies[index]);
+        } else {
+            proxies[index] = tree.Insert(rects[index], index);
+        }
+        alive[index] = !alive[index];
+        ASSERT_TRUE(tree.IsValid()) << "Round " << round;
+
+        for (size_t q = 0; q < 50; ++q)
+        {
+            const RectangleF query = randomRect(random, 1000.0f, 100.0f);
+            ASSERT_EQ(bruteForceIds(rects, alive, query), queryIds(tree, query)) << "Round " << round;
+        }
+    }
+
+    EXPECT_EQ(static_cast<size_t>(std::count(alive.begin(), alive.end(), true)), tree.GetCount());
+    EXPECT_GE(24, tree.GetHeight());
+}
+
+TEST(AABBTreeTest, SmallMovesStayInTheLeaf)
+{
+    AABBTree tree(5.0f);
+    const AABBTree::Proxy proxy = tree.Insert({ 0.0f, 0.0f, 10.0f, 10.0f }, 7);
+
+    EXPECT_FALSE(tree.Move(proxy, { 4.0f, -4.0f, 10.0f, 10.0f }));
+    EXPECT_FLOAT_EQ(4.0f, tree.GetRect(proxy).X);
+    EXPECT_TRUE(tree.Move(proxy, { 10.0f, -4.0f, 10.0f, 10.0f }));
+
+    // Stretched in the direction of the last move
+    const AABBTree::Bounds fat = tree.GetFatBounds(proxy);
+    EXPECT_FLOAT_EQ(5.0f,  fat.MinX);
+    EXPECT_FLOAT_EQ(31.0f, fat.MaxX);
+    EXPECT_EQ(7, tree.GetId(proxy));
+    EXPECT_TRUE(tree.IsValid());
+}
+
+TEST(AABBTreeTest, QueryPairsFindsEveryOverlappingPair)
+{
+    Helpers::random::Generator random(2);
+    AABBTree tree(1.0f);
+    std::vector<RectangleF> rects;
+    for (size_t i = 0; i < 300; ++i)
+    {
+        rects.push_back(randomRect(random, 500.0f, 30.0f));
+        tree.Insert(rects.back(), i);
+    }
+
+    std::vector<std::pair<size_t, size_t>> expected, pairs;
+    for (size_t i = 0; i < rects.size(); ++i) {
+        for (size_t j = i + 1; j < rects.size(); ++j) {
+            if (rects[i].Overlaps(rects[j])) {
+                expected.emplace_back(i, j);
+            }
+        }
+    }
+    tree.QueryPairs(pairs);
+    std::sort(pairs.begin(), pairs.end());
+
+    EXPECT_FALSE(expected.empty());
+    EXPECT_EQ(expected, pairs);
+}
+
+TEST(AABBTreeTest, RayCastHitsTheClosestLeaf)
+{
+    AABBTree tree(1.0f);
+    tree.Insert({ 50.0f, -5.0f, 10.0f, 10.0f }, 0);
+    tree.Insert({ 20.0f, -5.0f, 10.0f, 10.0f }, 1);
+    tree.Insert({ 30.0f, 20.0f, 10.0f, 10.0f }, 2);
+
+    const std::optional<AABBTree::RayHit> hit = tree.RayCast({ 0.0f, 0.0f }, { 100.0f, 0.0f });
+    ASSERT_TRUE(hit.has_value());
+    EXPECT_EQ(1, tree.GetId(hit->HitProxy));
+    EXPECT_FLOAT_EQ(0.2f,  hit->Fraction);
+    EXPECT_FLOAT_EQ(20.0f, hit->Point.X);
+
+    EXPECT_FALSE(tree.RayCast({ 0.0f, 0.0f }, { 15.0f, 0.0f }).has_value());
+    EXPECT_FALSE(tree.RayCast({ 0.0f, 10.0f }, { 100.0f, 10.0f }).has_value());
+}
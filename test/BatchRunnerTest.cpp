@@ -0,0 +1,74 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h" //EXPECT_THAT macro, matchers
+
+#include "BatchRunner.hpp"
+#include "Constants.hpp"
+#include "Logger.hpp"
+
+#include <vector>
+
+
+namespace
+{
+    void expectEqualResults(const BatchRunner::Result& expected, const BatchRunner::Result& actual)
+    {
+        EXPECT_EQ(expected.Seed,      actual.Seed);
+        EXPECT_EQ(expected.Completed, actual.Completed);
+        EXPECT_DOUBLE_EQ(expected.TimeUsed, actual.TimeUsed);
+        EXPECT_EQ(expected.Falls,     actual.Falls);
+        EXPECT_EQ(expected.Score,     actual.Score);
+        EXPECT_EQ(expected.Updates,   actual.Updates);
+    }
+} // end anonymous namespace
+
+
+class BatchRunnerTest : public ::testing::Test
+{
+protected:
+    void SetUp(void) override
+    {
+        Logger::SetLogLevel(Logger::Level::CRITICAL);
+    }
+};
+
+
+TEST_F(BatchRunnerTest, SameSeedGivesSameResult)
+{
+    const BatchRunner::Result first  = BatchRunner::RunSeed(42);
+    const BatchRunner::Result second = BatchRunner::RunSeed(42);
+
+    expectEqualResults(first, second);
+    EXPECT_GT(first.Updates, 0u);
+    EXPECT_LE(first.TimeUsed, Constants::Level::INITIAL_TIME + 1.0);
+}
+
+TEST_F(BatchRunnerTest, ResultsAreOrderedBySeed)
+{
+    const BatchRunner runner(2);
+    const std::vector<BatchRunner::Result> results = runner.Run(10, 3);
+
+    ASSERT_EQ(3u, results.size());
+    EXPECT_EQ(10u, results[0].Seed);
+    EXPECT_EQ(11u, results[1].Seed);
+    EXPECT_EQ(12u, results[2].Seed);
+}
+
+TEST_F(BatchRunnerTest, ResultsDoNotDependOnThreadsCount)
+{
+    const BatchRunner singleThreaded(1);
+    const BatchRunner multiThreaded(4);
+
+    const std::vector<BatchRunner::Result> expected = singleThreaded.Run(100, 4);
+    const std::vector<BatchRunner::Result> actual   = multiThreaded.Run(100, 4);
+
+    ASSERT_EQ(expected.size(), actual.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        expectEqualResults(expected[i], actual[i]);
+    }
+}
+
+TEST_F(BatchRunnerTest, RunWithoutSeedsReturnsNoResults)
+{
+    const BatchRunner runner(4);
+    EXPECT_TRUE(runner.Run(0, 0).empty());
+}
@@ -0,0 +1,202 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h" //EXPECT_THAT macro, matchers
+
+#include "BotSwarm.hpp"
+#include "Constants.hpp"
+#include "GameLevel.hpp"
+#include "GameObject.hpp"
+#include "Input.hpp"
+#include "Logger.hpp"
+#include "Replay.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+
+namespace
+{
+    const Timestep DT(1.0 / static_cast<double>(Constants::TARGET_UPS));
+
+    /// A headless FIXED level along with the player and the input it is played with.
+    struct HeadlessLevel
+    {
+        HeadlessLevel(unsigned int seed, GameLevel::Mode mode = GameLevel::Mode::FIXED)
+            : input()
+            , player(GameObject::CreatePlayer(
+                input, 0.0f, 0.0f,
+                Constants::Player::MOVE_FORCE,
+                Constants::Player::RADIUS,
+                nullptr,
+                Constants::Colors::LIGHT
+            ))
+            , level(GameLevel::CreateHeadlessLevel(
+                input, mode, seed, Constants::Level::ARENA_SIZE,
+                Constants::Level::GRAVITY, Constants::Level::FRICTION, Constants::Level::INITIAL_TIME,
+                player.get()
+            ))
+        {
+            Logger::SetLogLevel(Logger::Level::CRITICAL);
+        }
+
+        Input                         input;
+        std::unique_ptr<PlayerObject> player;
+        std::unique_ptr<GameLevel>    level;
+    };
+
+    /// @return The distance the world origin of the level has moved.
+    double getOriginX(const HeadlessLevel& headless)
+    {
+        return headless.level->GetPlayerDistance() - static_cast<double>(headless.player->GetPosition().x);
+    }
+
+    BotSwarm createSwarm(size_t count, size_t threadsCount)
+    {
+        return BotSwarm(count, Constants::Player::MOVE_FORCE, Constants::Player::RADIUS, 3, threadsCount);
+    }
+} // end anonymous namespace
+
+
+class BotSwarmModeTest : public ::testing::TestWithParam<GameLevel::Mode> {};
+
+TEST_P(BotSwarmModeTest, BotMovesLikeThePlayerWithTheSameKeys)
+{
+    for (unsigned int seed = 31; seed < 36; ++seed)
+    {
+        HeadlessLevel headless(seed, GetParam());
+        const Dimensions2DF arenaSize  = headless.level->GetArenaSize();
+        const Dimensions2D  boundaries = { static_cast<int>(arenaSize.W), static_cast<int>(arenaSize.H) };
+
+        BotSwarm bots = createSwarm(1, 1);
+        bots.SetPosition(0, { headless.player->GetPosition().x, headless.player->GetPosition().y });
+
+        bool landed = false;
+        for (size_t tick = 0; tick < 3000; ++tick)
+        {
+            if (tick % 2 == 0)
+            {
+                headless.input.SetKeyPressed(Input::KeyCode::RIGHT, tick % 600 < 500);
+                headless.input.SetKeyPressed(Input::KeyCode::LEFT,  tick % 600 >= 540);
+                headless.input.SetKeyPressed(Input::KeyCode::UP,    tick % 120 < 30);
+                headless.input.SetKeyPressed(Input::KeyCode::SPACE, tick % 180 < 4);
+                headless.level->HandleInput();
+                bots.HandleInput(Replay::GetKeys(headless.input));
+            }
+
+            // The endless mode moves the world origin after updating the player, the bot follows it
+            const double originX = getOriginX(headless);
+            headless.level->Update(DT);
+            bots.Update(headless.level->GetPhysics(), boundaries, DT);
+            const double dx = originX - getOriginX(headless);
+            if (dx != 0.0) {
+                bots.TranslateX(static_cast<float>(dx));
+            }
+
+            headless.level->HandleCollisions();
+            bots.HandleCollisions(headless.level->GetTerrain());
+
+            ASSERT_FLOAT_EQ(headless.player->GetPosition().x, bots.GetPosition(0).X) << "Seed " << seed << ", tick " << tick;
+            ASSERT_FLOAT_EQ(headless.player->GetPosition().y, bots.GetPosition(0).Y) << "Seed " << seed << ", tick " << tick;
+            landed = landed || bots.IsOnGround(0);
+        }
+        EXPECT_TRUE(landed) << "Seed " << seed;
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    Modes, BotSwarmModeTest,
+    ::testing::Values(GameLevel::Mode::FIXED, GameLevel::Mode::ENDLESS)
+);
+
+TEST(BotSwarmTest, ThreadedStepIsEqualToOneThread)
+{
+    HeadlessLevel headless(32);
+    const Heightfield& terrain = headless.level->GetTerrain();
+
+    BotSwarm single   = createSwarm(3000, 1);
+    BotSwarm threaded = createSwarm(3000, 4);
+    for (size_t tick = 0; tick < 1200; ++tick)
+    {
+        single.Step(headless.level->GetPhysics(),   Constants::Level::ARENA_SIZE, terrain, DT, tick % 2 == 0);
+        threaded.Step(headless.level->GetPhysics(), Constants::Level::ARENA_SIZE, terrain, DT, tick % 2 == 0);
+    }
+
+    for (size_t i = 0; i < single.GetCount(); ++i)
+    {
+        ASSERT_EQ(single.GetPosition(i).X, threaded.GetPosition(i).X) << "Bot " << i;
+        ASSERT_EQ(single.GetPosition(i).Y, threaded.GetPosition(i).Y) << "Bot " << i;
+    }
+}
+
+TEST(BotSwarmTest, BotsJumpOverTheGaps)
+{
+    HeadlessLevel headless(33);
+    std::vector<RectangleF> blocks;
+    headless.level->GetBlocks(blocks);
+
+    BotSwarm bots = createSwarm(200, 1);
+    for (size_t tick = 0; tick < 30 * Constants::TARGET_UPS; ++tick) {
+        bots.Step(headless.level->GetPhysics(), Constants::Level::ARENA_SIZE, headless.level->GetTerrain(), DT, tick % 2 == 0);
+    }
+
+    // Running right without jumping ends in the first gap
+    for (size_t i = 0; i < bots.GetCount(); ++i) {
+        EXPECT_GT(bots.GetPosition(i).X, blocks[10].X) << "Bot " << i;
+    }
+}
+
+TEST(BotSwarmTest, LevelStepsItsBots)
+{
+    HeadlessLevel headless(34);
+    headless.level->SetBotsCount(100);
+    const BotSwarm* bots = headless.level->GetBots();
+    ASSERT_NE(nullptr, bots);
+    ASSERT_EQ(100u, bots->GetCount());
+
+    std::vector<Point2DF> positions;
+    for (size_t i = 0; i < bots->GetCount(); ++i) {
+        positions.push_back(bots->GetPosition(i));
+    }
+
+    for (size_t tick = 0; tick < 5 * Constants::TARGET_UPS; ++tick)
+    {
+        if (tick % 2 == 0) {
+            headless.level->HandleInput();
+        }
+        headless.level->Update(DT);
+        headless.level->HandleCollisions();
+    }
+
+    size_t moved = 0;
+    for (size_t i = 0; i < bots->GetCount(); ++i) {
+        moved += bots->GetPosition(i).X > positions[i].X ? 1 : 0;
+    }
+    EXPECT_EQ(bots->GetCount(), moved);
+
+    // Restarting puts every bot back where it started
+    headless.level->Restart();
+    for (size_t i = 0; i < bots->GetCount(); ++i)
+    {
+        EXPECT_FLOAT_EQ(positions[i].X, bots->GetPosition(i).X) << "Bot " << i;
+        EXPECT_FLOAT_EQ(positions[i].Y, bots->GetPosition(i).Y) << "Bot " << i;
+    }
+
+    headless.level->SetBotsCount(0);
+    EXPECT_EQ(nullptr, headless.level->GetBots());
+}
+
+TEST(BotSwarmTest, TranslateMovesEveryBot)
+{
+    BotSwarm bots = createSwarm(10, 1);
+    std::vector<Point2DF> positions;
+    for (size_t i = 0; i < bots.GetCount(); ++i) {
+        positions.push_back(bots.GetPosition(i));
+    }
+
+    bots.TranslateX(-100.0f);
+    for (size_t i = 0; i < bots.GetCount(); ++i)
+    {
+        EXPECT_FLOAT_EQ(positions[i].X - 100.0f, bots.GetPosition(i).X);
+        EXPECT_FLOAT_EQ(positions[i].Y, bots.GetPosition(i).Y);
+    }
+}
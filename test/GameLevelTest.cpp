@@ -0,0 +1,225 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h" //EXPECT_THAT macro, matchers
+
+#include "Constants.hpp"
+#include "GameLevel.hpp"
+#include "GameObject.hpp"
+#include "Input.hpp"
+#include "LevelValidator.hpp"
+#include "Logger.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+
+namespace
+{
+    /// A headless level along with the player and the input it is played with.
+    struct HeadlessLevel
+    {
+        HeadlessLevel(GameLevel::Mode mode, unsigned int seed)
+            : input()
+            , player(GameObject::CreatePlayer(
+                input, 0.0f, 0.0f,
+                Constants::Player::MOVE_FORCE,
+                Constants::Player::RADIUS,
+                nullptr,
+                Constants::Colors::LIGHT
+            ))
+            , level(GameLevel::CreateHeadlessLevel(
+                input, mode, seed, Constants::Level::ARENA_SIZE,
+                Constants::Level::GRAVITY, Constants::Level::FRICTION, Constants::Level::INITIAL_TIME,
+                player.get()
+            ))
+        {
+            input.SetKeyPressed(Input::KeyCode::RIGHT, true);
+            input.SetKeyPressed(Input::KeyCode::UP,    true);
+            input.SetKeyPressed(Input::KeyCode::SPACE, true);
+        }
+
+        /// Plays the level the same way as the game loop does.
+        void Play(size_t inputsCount)
+        {
+            const Timestep dt(1.0 / static_cast<double>(Constants::TARGET_UPS));
+            for (size_t i = 0; i < inputsCount; ++i)
+            {
+                level->HandleInput();
+                for (size_t u = 0; u < Constants::TARGET_UPS / Constants::TARGET_FPS; ++u)
+                {
+                    level->Update(dt);
+                    level->HandleCollisions();
+                }
+            }
+        }
+
+        Input                         input;
+        std::unique_ptr<PlayerObject> player;
+        std::unique_ptr<GameLevel>    level;
+    };
+
+    void expectEqualLevels(const HeadlessLevel& expected, const HeadlessLevel& actual)
+    {
+        EXPECT_FLOAT_EQ(expected.player->GetPosition().x, actual.player->GetPosition().x);
+        EXPECT_FLOAT_EQ(expected.player->GetPosition().y, actual.player->GetPosition().y);
+        EXPECT_FLOAT_EQ(expected.player->GetVelocity().x, actual.player->GetVelocity().x);
+        EXPECT_FLOAT_EQ(expected.player->GetVelocity().y, actual.player->GetVelocity().y);
+        EXPECT_DOUBLE_EQ(expected.level->GetPlayerDistance(), actual.level->GetPlayerDistance());
+        EXPECT_DOUBLE_EQ(expected.level->GetTimeLeft(), actual.level->GetTimeLeft());
+        EXPECT_EQ(expected.level->GetScore(),      actual.level->GetScore());
+        EXPECT_EQ(expected.level->GetFallsCount(), actual.level->GetFallsCount());
+    }
+} // end anonymous namespace
+
+
+class GameLevelTest : public ::testing::TestWithParam<GameLevel::Mode>
+{
+protected:
+    void SetUp(void) override
+    {
+        Logger::SetLogLevel(Logger::Level::CRITICAL);
+    }
+};
+
+
+TEST_P(GameLevelTest, RestartRestoresTheLoadedState)
+{
+    HeadlessLevel fresh(GetParam(), 7);
+    HeadlessLevel restarted(GetParam(), 7);
+
+    restarted.Play(1000);
+    ASSERT_GT(restarted.level->GetScore(), fresh.level->GetScore());
+
+    restarted.level->Restart();
+    expectEqualLevels(fresh, restarted);
+}
+
+TEST_P(GameLevelTest, RestartedLevelPlaysLikeAFreshOne)
+{
+    HeadlessLevel fresh(GetParam(), 7);
+    HeadlessLevel restarted(GetParam(), 7);
+
+    restarted.Play(1000);
+    restarted.level->Restart();
+
+    // Enough to land, jump and fall a few times, and to recycle endless chunks
+    fresh.Play(1000);
+    restarted.Play(1000);
+    expectEqualLevels(fresh, restarted);
+}
+
+TEST_P(GameLevelTest, RestartCanBeRepeated)
+{
+    HeadlessLevel fresh(GetParam(), 7);
+    HeadlessLevel restarted(GetParam(), 7);
+
+    for (size_t i = 0; i < 3; ++i)
+    {
+        restarted.Play(300);
+        restarted.level->Restart();
+    }
+
+    fresh.Play(300);
+    restarted.Play(300);
+    expectEqualLevels(fresh, restarted);
+}
+
+TEST_P(GameLevelTest, LoadedStatePlaysLikeTheSavedOne)
+{
+    HeadlessLevel saved(GetParam(), 7);
+    HeadlessLevel loaded(GetParam(), 7);
+
+    std::vector<uint8_t> state;
+    saved.Play(700);
+    saved.level->SaveState(state);
+    saved.Play(700);
+
+    loaded.Play(100);
+    ASSERT_TRUE(loaded.level->LoadState(state));
+    loaded.Play(700);
+
+    expectEqualLevels(saved, loaded);
+}
+
+TEST_P(GameLevelTest, SaveIntoTheSameBufferDoesNotReallocate)
+{
+    HeadlessLevel level(GetParam(), 7);
+
+    std::vector<uint8_t> state;
+    for (size_t i = 0; i < 100; ++i)
+    {
+        const uint8_t* data     = state.data();
+        const size_t   capacity = state.capacity();
+
+        level.Play(10);
+        level.level->SaveState(state);
+        if (i > 0 && state.size() <= capacity) { // Endless states grow with the blocks overhanging into the next chunk
+            EXPECT_EQ(data, state.data());
+        }
+    }
+}
+
+TEST_P(GameLevelTest, LoadRejectsStatesOfOtherLevels)
+{
+    HeadlessLevel level(GetParam(), 7);
+    HeadlessLevel other(GetParam(), 8);
+
+    std::vector<uint8_t> state;
+    other.Play(300);
+    other.level->SaveState(state);
+
+    level.Play(300);
+    const double distance = level.level->GetPlayerDistance();
+    EXPECT_FALSE(level.level->LoadState(state));
+    EXPECT_DOUBLE_EQ(distance, level.level->GetPlayerDistance());
+}
+
+TEST_P(GameLevelTest, LoadRejectsInvalidData)
+{
+    HeadlessLevel level(GetParam(), 7);
+
+    std::vector<uint8_t> state;
+    level.level->SaveState(state);
+
+    std::vector<uint8_t> truncated(state.begin(), state.end() - 1);
+    EXPECT_FALSE(level.level->LoadState(truncated));
+    EXPECT_FALSE(level.level->LoadState({}));
+
+    std::vector<uint8_t> newerVersion = state;
+    newerVersion[4] = static_cast<uint8_t>(GameLevel::STATE_VERSION + 1);
+    EXPECT_FALSE(level.level->LoadState(newerVersion));
+
+    EXPECT_TRUE(level.level->LoadState(state));
+}
+
+TEST_P(GameLevelTest, EveryBlockIsReachable)
+{
+    // In endless mode the blocks are stored as tiles, and the colliders are built from the tiles
+    const Timestep dt(1.0 / static_cast<double>(Constants::TARGET_UPS));
+    for (unsigned int seed = 1; seed <= 10; ++seed)
+    {
+        HeadlessLevel level(GetParam(), seed);
+        const JumpEnvelope envelope(
+            level.level->GetPhysics(), level.player->GetTransform().GetMoveForce(), level.player->GetRadius(),
+            dt, Constants::TARGET_UPS / Constants::TARGET_FPS, static_cast<float>(Constants::Level::ARENA_SIZE.H)
+        );
+        const LevelValidator validator(envelope, 1);
+
+        std::vector<RectangleF> blocks;
+        for (int i = 0; i < 20; ++i)
+        {
+            level.level->GetBlocks(blocks);
+            EXPECT_THAT(validator.FindUnreachable(blocks), ::testing::IsEmpty()) << "Seed " << seed << ", step " << i;
+
+            // Moves the player far enough ahead for the endless mode to generate the next chunk
+            const RectangleF last = blocks.back();
+            level.player->SetPosition(last.X - 0.5f * last.W, 0.0f);
+            level.level->Update(dt);
+        }
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    Modes, GameLevelTest,
+    ::testing::Values(GameLevel::Mode::FIXED, GameLevel::Mode::ENDLESS)
+);
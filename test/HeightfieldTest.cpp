@@ -0,0 +1,100 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h" //EXPECT_THAT macro, matchers
+
+#include "Heightfield.hpp"
+#include "Helpers.hpp"
+
+#include <vector>
+
+
+namespace
+{
+    constexpr float BOTTOM = 1000.0f;
+
+    /// Blocks standing on the bottom, separated by random gaps.
+    std::vector<RectangleF> createBlocks(Helpers::random::Generator& random, size_t count)
+    {
+        std::vector<RectangleF> blocks;
+        float x = 0.0f;
+        for (size_t i = 0; i < count; ++i)
+        {
+            const float width  = random.FloatInRange(20.0f, 200.0f);
+            const float height = random.FloatInRange(10.0f, 500.0f);
+            blocks.push_back({ x, BOTTOM - height, width, height });
+            x += width + random.FloatInRange(0.0f, 100.0f);
+        }
+        return blocks;
+    }
+
+    std::vector<size_t> queryIds(const Heightfield& heightfield, const RectangleF& rect)
+    {
+        std::vector<size_t> ids;
+        heightfield.QueryOverlaps(rect, [&ids](const Heightfield::Span& span)
+        {
+            ids.push_back(span.Id);
+            return true;
+        });
+        return ids;
+    }
+} // end anonymous namespace
+
+
+TEST(HeightfieldTest, QueriesMatchRectangleTests)
+{
+    Helpers::random::Generator random(1);
+    const std::vector<RectangleF> blocks = createBlocks(random, 500);
+    Heightfield heightfield(BOTTOM);
+    for (size_t i = 0; i < blocks.size(); ++i) {
+        heightfield.Add(blocks[i], i);
+    }
+    ASSERT_EQ(blocks.size(), heightfield.GetCount());
+
+    const float width = blocks.back().X + blocks.back().W;
+    for (size_t q = 0; q < 2000; ++q)
+    {
+        const RectangleF rect = {
+            random.FloatInRange(-100.0f, width), random.FloatInRange(0.0f, BOTTOM),
+            random.FloatInRange(1.0f, 150.0f),   random.FloatInRange(1.0f, 150.0f)
+        };
+
+        std::vector<size_t> expected;
+        for (size_t i = 0; i < blocks.size(); ++i) {
+            if (blocks[i].Overlaps(rect)) {
+                expected.push_back(i);
+            }
+        }
+        ASSERT_EQ(expected, queryIds(heightfield, rect)) << "Query " << q;
+    }
+}
+
+TEST(HeightfieldTest, GroundHeight)
+{
+    Heightfield heightfield(BOTTOM);
+    heightfield.Add({   0.0f, 900.0f, 100.0f, 100.0f }, 0);
+    heightfield.Add({  95.0f, 800.0f, 100.0f, 200.0f }, 1); // Overlaps the first one
+    heightfield.Add({ 300.0f, 700.0f,  50.0f, 300.0f }, 2);
+
+    EXPECT_FLOAT_EQ(900.0f, heightfield.GetGroundY(50.0f));
+    EXPECT_FLOAT_EQ(800.0f, heightfield.GetGroundY(97.0f));
+    EXPECT_FLOAT_EQ(BOTTOM, heightfield.GetGroundY(250.0f));
+    EXPECT_FLOAT_EQ(700.0f, heightfield.GetGroundY(350.0f));
+    EXPECT_FLOAT_EQ(BOTTOM, heightfield.GetGroundY(-1.0f));
+
+    heightfield.TranslateX(-300.0f);
+    EXPECT_FLOAT_EQ(700.0f, heightfield.GetGroundY(0.0f));
+    EXPECT_FLOAT_EQ(BOTTOM, heightfield.GetGroundY(51.0f));
+}
+
+TEST(HeightfieldTest, RunsOfTouchingSpans)
+{
+    Heightfield heightfield(BOTTOM);
+    heightfield.Add({   0.0f, 900.0f, 100.0f, 100.0f }, 0);
+    heightfield.Add({ 100.0f, 900.0f,  50.0f, 100.0f }, 1);
+    heightfield.Add({ 150.0f, 900.0f,  50.0f, 100.0f }, 2);
+    heightfield.Add({ 200.0f, 850.0f,  50.0f, 150.0f }, 3); // Higher
+    heightfield.Add({ 260.0f, 850.0f,  50.0f, 150.0f }, 4); // Apart
+
+    EXPECT_EQ(std::make_pair(0.0f, 200.0f),   heightfield.GetRunBounds(heightfield.GetSpan(1)));
+    EXPECT_EQ(std::make_pair(200.0f, 250.0f), heightfield.GetRunBounds(heightfield.GetSpan(3)));
+    EXPECT_EQ(std::make_pair(260.0f, 310.0f), heightfield.GetRunBounds(heightfield.GetSpan(4)));
+}
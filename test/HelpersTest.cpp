@@ -0,0 +1,73 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h" //EXPECT_THAT macro, matchers
+
+#include "Helpers.hpp"
+
+#include <string>
+
+
+TEST(HelpersTest, ReplaceAllReplacesEveryOccurrence)
+{
+    std::string str = "a-b-c";
+    EXPECT_EQ("a+b+c", Helpers::ReplaceAll(str, "-", "+"));
+    EXPECT_EQ("a+b+c", str);
+}
+
+TEST(HelpersTest, GeneratorIsDeterministic)
+{
+    Helpers::random::Generator first(1337);
+    Helpers::random::Generator second(1337);
+
+    for (int i = 0; i < 1000; ++i) {
+        EXPECT_EQ(first.FloatInRange(0.0f, 100.0f), second.FloatInRange(0.0f, 100.0f));
+    }
+}
+
+TEST(HelpersTest, GeneratorSeedRestartsTheSequence)
+{
+    Helpers::random::Generator generator(7);
+    const float first = generator.FloatInRange(-1.0f, 1.0f);
+    generator.FloatInRange(-1.0f, 1.0f);
+
+    generator.Seed(7);
+    EXPECT_EQ(first, generator.FloatInRange(-1.0f, 1.0f));
+}
+
+TEST(HelpersTest, GeneratorStaysInRange)
+{
+    Helpers::random::Generator generator(0);
+    for (int i = 0; i < 10000; ++i)
+    {
+        const float f = generator.FloatInRange(60.0f, 250.0f);
+        EXPECT_GE(f, 60.0f);
+        EXPECT_LE(f, 250.0f);
+    }
+}
+
+TEST(HelpersTest, GeneratorsDoNotShareState)
+{
+    Helpers::random::Generator first(3);
+    Helpers::random::Generator second(3);
+
+    const float expected = second.FloatInRange(0.0f, 1.0f);
+    for (int i = 0; i < 100; ++i) {
+        first.FloatInRange(0.0f, 1.0f);
+    }
+
+    Helpers::random::Generator third(3);
+    EXPECT_EQ(expected, third.FloatInRange(0.0f, 1.0f));
+}
+
+TEST(HelpersTest, GeneratorRewindRestoresTheState)
+{
+    Helpers::random::Generator generator(11);
+    for (int i = 0; i < 50; ++i) {
+        generator.FloatInRange(0.0f, 1.0f);
+    }
+    const uint64_t drawsCount = generator.GetDrawsCount();
+    const float    expected   = generator.FloatInRange(0.0f, 1.0f);
+
+    generator.Rewind(drawsCount);
+    EXPECT_EQ(drawsCount, generator.GetDrawsCount());
+    EXPECT_EQ(expected, generator.FloatInRange(0.0f, 1.0f));
+}
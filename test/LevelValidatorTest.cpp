@@ -0,0 +1,111 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h" //EXPECT_THAT macro, matchers
+
+#include "LevelValidator.hpp"
+#include "Physics.hpp"
+
+#include <limits>
+#include <vector>
+
+
+class LevelValidatorTest : public ::testing::Test
+{
+protected:
+    LevelValidatorTest(void)
+        : physics(100.0f, 0.9f)
+        , envelope(physics, 75.0f, RADIUS, 1.0 / 120.0, 2, 750.0f)
+    {
+        //
+    }
+
+    /// @return A block standing on the bottom of the level.
+    static RectangleF block(float x, float width, float height)
+    {
+        return { x, LEVEL_HEIGHT - height, width, height };
+    }
+
+    inline static constexpr float RADIUS       = 30.0f;
+    inline static constexpr float LEVEL_HEIGHT = 750.0f;
+
+    Physics      physics;
+    JumpEnvelope envelope;
+};
+
+
+TEST_F(LevelValidatorTest, MaxRiseIsNonIncreasingWithTheGap)
+{
+    float previous = envelope.GetMaxRise(0.0f);
+    EXPECT_GT(previous, 0.0f);
+
+    for (float gap = 1.0f; gap < 2000.0f; gap += 1.0f)
+    {
+        const float rise = envelope.GetMaxRise(gap);
+        EXPECT_LE(rise, previous);
+        previous = rise;
+    }
+}
+
+TEST_F(LevelValidatorTest, GapsWithinTwoRadiusesAreWalkable)
+{
+    EXPECT_FLOAT_EQ(envelope.GetMaxRise(0.0f), envelope.GetMaxRise(2.0f * RADIUS));
+    EXPECT_FLOAT_EQ(envelope.GetMaxRise(-100.0f), envelope.GetMaxRise(0.0f));
+}
+
+TEST_F(LevelValidatorTest, VeryWideGapsAreUnreachable)
+{
+    EXPECT_EQ(std::numeric_limits<float>::lowest(), envelope.GetMaxRise(1.0e6f));
+    EXPECT_FALSE(envelope.CanReach(block(0.0f, 100.0f, 100.0f), block(1.0e6f, 100.0f, 100.0f)));
+}
+
+TEST_F(LevelValidatorTest, MaxGapMatchesCanReach)
+{
+    for (float height : { 30.0f, 100.0f, 200.0f })
+    {
+        const RectangleF from = block(0.0f, 100.0f, 100.0f);
+        const float maxGap = envelope.GetMaxGap(height - from.H);
+        ASSERT_GT(maxGap, 0.0f);
+
+        EXPECT_TRUE(envelope.CanReach(from,  block(from.W + maxGap - 1.0f, 100.0f, height)));
+        EXPECT_FALSE(envelope.CanReach(from, block(from.W + maxGap + 2.0f, 100.0f, height)));
+    }
+}
+
+TEST_F(LevelValidatorTest, TooHighWallIsUnreachable)
+{
+    const float maxRise = envelope.GetMaxRise(0.0f);
+
+    EXPECT_EQ(-1.0f, envelope.GetMaxGap(maxRise + 1.0f));
+    EXPECT_TRUE(envelope.CanReach(block(0.0f, 100.0f, 30.0f),  block(100.0f, 100.0f, 30.0f + maxRise - 1.0f)));
+    EXPECT_FALSE(envelope.CanReach(block(0.0f, 100.0f, 30.0f), block(100.0f, 100.0f, 30.0f + maxRise + 1.0f)));
+}
+
+TEST_F(LevelValidatorTest, FindUnreachableReturnsIndicesInOrder)
+{
+    const float unreachableHeight = envelope.GetMaxRise(0.0f) + 100.0f;
+
+    std::vector<RectangleF> blocks;
+    std::vector<size_t>     expected;
+    for (size_t i = 0; i < 50000; ++i)
+    {
+        const bool  wall   = i % 997 == 0 && i > 0;
+        const float height = wall ? unreachableHeight : 50.0f;
+        if (wall) {
+            expected.push_back(i - 1);
+        }
+        blocks.push_back(block(static_cast<float>(i) * 200.0f, 100.0f, height));
+    }
+
+    const LevelValidator singleThreaded(envelope, 1);
+    const LevelValidator multiThreaded(envelope, 8);
+
+    EXPECT_EQ(expected, singleThreaded.FindUnreachable(blocks));
+    EXPECT_EQ(expected, multiThreaded.FindUnreachable(blocks));
+}
+
+TEST_F(LevelValidatorTest, FindUnreachableHandlesTinyLevels)
+{
+    const LevelValidator validator(envelope, 4);
+
+    EXPECT_TRUE(validator.FindUnreachable({}).empty());
+    EXPECT_TRUE(validator.FindUnreachable({ block(0.0f, 100.0f, 50.0f) }).empty());
+}
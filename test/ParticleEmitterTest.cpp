@@ -0,0 +1,112 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h" //EXPECT_THAT macro, matchers
+
+#include "ParticleEmitter.hpp"
+
+#include <cstdint>
+
+
+namespace
+{
+    const Timestep DT(1.0 / 120.0);
+
+    ParticleEmitter::Properties createProperties(void)
+    {
+        return {
+            { 255, 255, 255, 255 }, { 0, 0, 0, 0 },
+            10.0f, 100.0f, -90.0f, 90.0f, 1.0f, 2.0f, 0.0f, 0.0f, 4.0f
+        };
+    }
+} // end anonymous namespace
+
+
+TEST(ParticleEmitterTest, EmitIsLimitedByTheCapacity)
+{
+    ParticleEmitter emitter(100, createProperties(), 1);
+
+    EXPECT_EQ(60, emitter.Emit({ 0.0f, 0.0f }, 60));
+    EXPECT_EQ(40, emitter.Emit({ 0.0f, 0.0f }, 60));
+    EXPECT_EQ(0,  emitter.Emit({ 0.0f, 0.0f }, 60));
+    EXPECT_EQ(100, emitter.GetCount());
+
+    emitter.Clear();
+    EXPECT_EQ(0, emitter.GetCount());
+    EXPECT_EQ(10, emitter.Emit({ 0.0f, 0.0f }, 10));
+}
+
+TEST(ParticleEmitterTest, ParticlesDieWhenTheirLifetimeRunsOut)
+{
+    ParticleEmitter emitter(1000, createProperties(), 2);
+    emitter.Emit({ 0.0f, 0.0f }, 1000);
+
+    // Every lifetime is in the range [1,2] seconds
+    for (size_t tick = 0; tick < 110; ++tick) {
+        emitter.Update(DT);
+    }
+    EXPECT_EQ(1000, emitter.GetCount());
+
+    for (size_t tick = 0; tick < 60; ++tick) {
+        emitter.Update(DT);
+    }
+    EXPECT_GT(1000, emitter.GetCount());
+    EXPECT_LT(0,    emitter.GetCount());
+
+    for (size_t tick = 0; tick < 130; ++tick) {
+        emitter.Update(DT);
+    }
+    EXPECT_EQ(0, emitter.GetCount());
+}
+
+TEST(ParticleEmitterTest, ColorFadesFromStartToEnd)
+{
+    ParticleEmitter::Properties properties = createProperties();
+    properties.MinLifetime = 1.0f;
+    properties.MaxLifetime = 1.0001f;
+    ParticleEmitter emitter(10, properties, 3);
+    emitter.Emit({ 0.0f, 0.0f }, 10);
+
+    for (size_t tick = 0; tick < 60; ++tick) {
+        emitter.Update(DT);
+    }
+
+    for (size_t i = 0; i < emitter.GetCount(); ++i)
+    {
+        const Color color = emitter.GetColor(i);
+        EXPECT_NEAR(128, color.r, 1);
+        EXPECT_NEAR(128, color.a, 1);
+    }
+}
+
+TEST(ParticleEmitterTest, GravityPullsTheParticlesDown)
+{
+    ParticleEmitter::Properties properties = createProperties();
+    properties.MinSpeed = 0.0f;
+    properties.MaxSpeed = 0.0001f;
+    properties.MinAngle = 179.0f;
+    properties.MaxAngle = 181.0f;
+    properties.Gravity  = 100.0f;
+    ParticleEmitter emitter(10, properties, 4);
+    emitter.Emit({ 5.0f, 5.0f }, 10);
+
+    for (size_t tick = 0; tick < 120; ++tick) {
+        emitter.Update(DT);
+    }
+
+    // y = g * t^2 / 2 when integrated continuously
+    for (size_t i = 0; i < emitter.GetCount(); ++i)
+    {
+        EXPECT_NEAR(5.0f, emitter.GetPosition(i).X, 0.001f);
+        EXPECT_NEAR(55.0f, emitter.GetPosition(i).Y, 1.0f);
+    }
+}
+
+TEST(ParticleEmitterTest, TranslateMovesEveryParticle)
+{
+    ParticleEmitter emitter(10, createProperties(), 5);
+    emitter.Emit({ 100.0f, 0.0f }, 10);
+    emitter.TranslateX(-100.0f);
+
+    for (size_t i = 0; i < emitter.GetCount(); ++i) {
+        EXPECT_FLOAT_EQ(0.0f, emitter.GetPosition(i).X);
+    }
+}
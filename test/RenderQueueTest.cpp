@@ -0,0 +1,175 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h" //EXPECT_THAT macro, matchers
+
+#include "RenderQueue.hpp"
+#include "Renderer.hpp"
+#include "Window.hpp"
+
+#include <SDL.h>
+#include <cstdint>
+#include <memory>
+
+
+namespace
+{
+    using Layer = RenderQueue::Layer;
+
+    const Color RED   = { 255, 0, 0, 255 };
+    const Color GREEN = { 0, 255, 0, 255 };
+    const Color BLUE  = { 0, 0, 255, 255 };
+
+    /// Draws with the software renderer of the dummy video driver, no display is needed.
+    class RenderQueueTest : public ::testing::Test
+    {
+    protected:
+        void SetUp(void) override
+        {
+            SDL_setenv("SDL_VIDEODRIVER", "dummy", 1);
+            ASSERT_EQ(0, SDL_Init(SDL_INIT_VIDEO)) << SDL_GetError();
+            _window   = std::make_unique<Window>("RenderQueueTest", Dimensions2D{ 64, 64 });
+            _renderer = std::make_unique<Renderer>(*_window, false, false);
+            ASSERT_NE(nullptr, _renderer->GetSdlRenderer()) << SDL_GetError();
+
+            _renderer->SetRenderDrawColor({ 0, 0, 0, 255 });
+            _renderer->RenderClear();
+        }
+
+        void TearDown(void) override
+        {
+            _renderer.reset();
+            _window.reset();
+            SDL_Quit();
+        }
+
+        /// @return The color of the pixel at x, y of the current rendering target, as 0xRRGGBB.
+        uint32_t readPixel(int x, int y) const
+        {
+            const SDL_Rect rect  = { x, y, 1, 1 };
+            uint32_t       pixel = 0;
+            EXPECT_EQ(0, SDL_RenderReadPixels(_renderer->GetSdlRenderer(), &rect, SDL_PIXELFORMAT_ARGB8888,
+                                              &pixel, static_cast<int>(sizeof(pixel))));
+            return pixel & 0xffffff;
+        }
+
+        std::unique_ptr<Window>   _window;
+        std::unique_ptr<Renderer> _renderer;
+        RenderQueue               _queue;
+    };
+} // end anonymous namespace
+
+
+TEST_F(RenderQueueTest, FlushEmptiesQueue)
+{
+    _queue.FillRectangle(Layer::TERRAIN, { 0, 0, 8, 8 }, RED);
+    _queue.DrawRectangle(Layer::DEBUG, { 0, 0, 8, 8 }, GREEN);
+    EXPECT_EQ(2u, _queue.GetCount());
+
+    _queue.Flush(*_renderer);
+    EXPECT_EQ(0u, _queue.GetCount());
+    EXPECT_EQ(2u, _queue.GetFrameStats().Commands);
+
+    _queue.Flush(*_renderer);
+    EXPECT_EQ(0u, _queue.GetFrameStats().Commands);
+    EXPECT_EQ(0u, _queue.GetFrameStats().DrawCalls);
+}
+
+TEST_F(RenderQueueTest, MergesFilledRectangles)
+{
+    // The vertices carry the color, so rectangles of any color are one call with one blend mode change
+    _queue.FillRectangle(Layer::TERRAIN, { 0,  0, 8, 8 }, RED);
+    _queue.FillRectangle(Layer::TERRAIN, { 8,  0, 8, 8 }, GREEN);
+    _queue.FillRectangle(Layer::TERRAIN, { 16, 0, 8, 8 }, BLUE);
+    _queue.Flush(*_renderer);
+
+    const RenderQueue::Stats stats = _queue.GetFrameStats();
+    EXPECT_EQ(3u, stats.Commands);
+    EXPECT_EQ(1u, stats.DrawCalls);
+    EXPECT_EQ(1u, stats.StateChanges);
+
+    EXPECT_EQ(0xff0000u, readPixel(4,  4));
+    EXPECT_EQ(0x00ff00u, readPixel(12, 4));
+    EXPECT_EQ(0x0000ffu, readPixel(20, 4));
+}
+
+TEST_F(RenderQueueTest, DoesNotMergeAcrossBlendModes)
+{
+    _queue.FillRectangle(Layer::TERRAIN, { 0, 0, 8, 8 }, RED);
+    _queue.FillRectangle(Layer::TERRAIN, { 8, 0, 8, 8 }, RED, Renderer::BlendMode::BLEND);
+    _queue.FillRectangle(Layer::TERRAIN, { 16, 0, 8, 8 }, RED);
+    _queue.Flush(*_renderer);
+
+    // The two opaque rectangles sort together
+    const RenderQueue::Stats stats = _queue.GetFrameStats();
+    EXPECT_EQ(2u, stats.DrawCalls);
+    EXPECT_EQ(2u, stats.StateChanges);
+}
+
+TEST_F(RenderQueueTest, MergesOutlinesOfSameColor)
+{
+    // Submitted interleaved, sorted into one run per color
+    _queue.DrawRectangle(Layer::DEBUG, { 0,  0, 8, 8 }, RED);
+    _queue.DrawRectangle(Layer::DEBUG, { 8,  0, 8, 8 }, BLUE);
+    _queue.DrawRectangle(Layer::DEBUG, { 16, 0, 8, 8 }, RED);
+    _queue.DrawRectangle(Layer::DEBUG, { 24, 0, 8, 8 }, BLUE);
+    _queue.Flush(*_renderer);
+
+    // One blend mode change and one color change per run
+    const RenderQueue::Stats stats = _queue.GetFrameStats();
+    EXPECT_EQ(4u, stats.Commands);
+    EXPECT_EQ(2u, stats.DrawCalls);
+    EXPECT_EQ(3u, stats.StateChanges);
+
+    EXPECT_EQ(0xff0000u, readPixel(0,  0));
+    EXPECT_EQ(0x0000ffu, readPixel(8,  0));
+    EXPECT_EQ(0xff0000u, readPixel(16, 0));
+    EXPECT_EQ(0x0000ffu, readPixel(24, 0));
+}
+
+TEST_F(RenderQueueTest, ElidesRedundantStateChanges)
+{
+    // The outline keeps the blend mode of the geometry, the circle the color of the outline
+    _queue.FillRectangle(Layer::PLAYER, { 0, 0, 8, 8 }, GREEN);
+    _queue.DrawRectangle(Layer::PLAYER, { 0, 16, 8, 8 }, RED);
+    _queue.FillCircle(Layer::PLAYER, { 40, 40 }, 4, RED);
+    _queue.Flush(*_renderer);
+
+    const RenderQueue::Stats stats = _queue.GetFrameStats();
+    EXPECT_EQ(3u, stats.DrawCalls);
+    EXPECT_EQ(2u, stats.StateChanges);
+
+    // The draw state is not trusted across frames, another user of the renderer may have changed it
+    _queue.DrawRectangle(Layer::PLAYER, { 0, 16, 8, 8 }, RED);
+    _queue.Flush(*_renderer);
+    EXPECT_EQ(2u, _queue.GetFrameStats().StateChanges);
+}
+
+TEST_F(RenderQueueTest, DrawsLayersInOrder)
+{
+    _queue.FillRectangle(Layer::HUD, { 0, 0, 16, 16 }, RED);
+    _queue.FillRectangle(Layer::BACKGROUND, { 0, 0, 32, 32 }, BLUE);
+    _queue.DrawRectangle(Layer::TERRAIN, { 0, 0, 32, 32 }, GREEN);
+    _queue.FillRectangle(Layer::PARTICLES, { 0, 0, 24, 24 }, GREEN);
+    _queue.Flush(*_renderer);
+
+    // The layers on both sides of the outlines are not merged over them
+    EXPECT_EQ(3u, _queue.GetFrameStats().DrawCalls);
+
+    EXPECT_EQ(0xff0000u, readPixel(8,  8));  // HUD over everything
+    EXPECT_EQ(0x00ff00u, readPixel(20, 20)); // PARTICLES over BACKGROUND
+    EXPECT_EQ(0x00ff00u, readPixel(0,  28)); // TERRAIN outline over BACKGROUND
+    EXPECT_EQ(0x0000ffu, readPixel(28, 28));
+}
+
+TEST_F(RenderQueueTest, KeepsSubmissionOrderOfEqualKeys)
+{
+    // Same layer and blend mode, the later rectangle is drawn over the earlier one
+    _queue.FillRectangle(Layer::TERRAIN, { 0, 0, 16, 16 }, RED);
+    _queue.FillRectangle(Layer::TERRAIN, { 8, 8, 16, 16 }, GREEN);
+    _queue.FillRectangle(Layer::TERRAIN, { 0, 0, 4, 4 }, BLUE);
+    _queue.Flush(*_renderer);
+
+    EXPECT_EQ(1u, _queue.GetFrameStats().DrawCalls);
+    EXPECT_EQ(0x0000ffu, readPixel(2,  2));
+    EXPECT_EQ(0xff0000u, readPixel(6,  6));
+    EXPECT_EQ(0x00ff00u, readPixel(12, 12));
+}
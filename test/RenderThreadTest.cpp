@@ -0,0 +1,129 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h" //EXPECT_THAT macro, matchers
+
+#include "RenderQueue.hpp"
+#include "RenderThread.hpp"
+#include "Renderer.hpp"
+#include "Window.hpp"
+
+#include <SDL.h>
+#include <chrono>
+#include <memory>
+#include <thread>
+
+
+namespace
+{
+    using Layer = RenderQueue::Layer;
+
+    const Color BLACK = { 0, 0, 0, 255 };
+    const Color RED   = { 255, 0, 0, 255 };
+    const Color GREEN = { 0, 255, 0, 255 };
+
+    /// Presents with the software renderer of the dummy video driver, no display is needed.
+    class RenderThreadTest : public ::testing::Test
+    {
+    protected:
+        void SetUp(void) override
+        {
+            SDL_setenv("SDL_VIDEODRIVER", "dummy", 1);
+            ASSERT_EQ(0, SDL_Init(SDL_INIT_VIDEO)) << SDL_GetError();
+            _window   = std::make_unique<Window>("RenderThreadTest", Dimensions2D{ 64, 64 });
+            _renderer = std::make_unique<Renderer>(*_window, false, false);
+            ASSERT_NE(nullptr, _renderer->GetSdlRenderer()) << SDL_GetError();
+            _thread   = std::make_unique<RenderThread>(*_renderer, BLACK);
+        }
+
+        void TearDown(void) override
+        {
+            _thread.reset();
+            _renderer.reset();
+            _window.reset();
+            SDL_Quit();
+        }
+
+        void recordFrame(RenderQueue& queue) const
+        {
+            queue.FillRectangle(Layer::TERRAIN, { 0, 0, 8, 8 }, RED);
+            queue.FillRectangle(Layer::TERRAIN, { 8, 0, 8, 8 }, GREEN);
+            queue.DrawRectangle(Layer::DEBUG, { 0, 0, 16, 8 }, GREEN);
+        }
+
+        std::unique_ptr<Window>       _window;
+        std::unique_ptr<Renderer>     _renderer;
+        std::unique_ptr<RenderThread> _thread;
+    };
+} // end anonymous namespace
+
+
+TEST_F(RenderThreadTest, PresentsSubmittedFrame)
+{
+    recordFrame(_thread->GetRecordQueue());
+    _thread->Submit(RenderThread::Clock::now());
+    _thread->Wait();
+
+    const RenderThread::FrameStats stats = _thread->GetFrameStats();
+    EXPECT_EQ(3u, stats.Queue.Commands);
+    EXPECT_EQ(2u, stats.Queue.DrawCalls);
+    EXPECT_EQ(stats.Queue.DrawCalls, stats.DrawCalls);
+    EXPECT_GE(stats.PresentUs, 0);
+}
+
+TEST_F(RenderThreadTest, AlternatesRecordQueues)
+{
+    RenderQueue* first = &_thread->GetRecordQueue();
+    recordFrame(*first);
+    _thread->Submit(RenderThread::Clock::now());
+
+    // The submitted queue is in flight, the next frame is recorded into the other one
+    RenderQueue* second = &_thread->GetRecordQueue();
+    EXPECT_NE(first, second);
+    EXPECT_EQ(0u, second->GetCount());
+    recordFrame(*second);
+
+    // Waits for the first frame before handing over the second one
+    _thread->Submit(RenderThread::Clock::now());
+    EXPECT_EQ(first, &_thread->GetRecordQueue());
+    _thread->Wait();
+    EXPECT_EQ(0u, first->GetCount());
+    EXPECT_EQ(0u, second->GetCount());
+}
+
+TEST_F(RenderThreadTest, MeasuresLatencyFromInputTime)
+{
+    const auto inputTime = RenderThread::Clock::now() - std::chrono::milliseconds(20);
+    _thread->Submit(inputTime);
+    _thread->Wait();
+
+    EXPECT_GE(_thread->GetFrameStats().LatencyUs, 20000);
+}
+
+TEST_F(RenderThreadTest, HandsRendererBackAfterWait)
+{
+    recordFrame(_thread->GetRecordQueue());
+    _thread->Submit(RenderThread::Clock::now());
+    _thread->Wait();
+
+    // Asserts in the debug builds if the render thread still owned it
+    _renderer->SetRenderDrawColor(RED);
+    _renderer->FillRectangle({ 0, 0, 4, 4 });
+    _renderer->RenderClear();
+}
+
+TEST_F(RenderThreadTest, PresentsFrameInFlightWhenDestroyed)
+{
+    recordFrame(_thread->GetRecordQueue());
+    _thread->Submit(RenderThread::Clock::now());
+    _thread.reset();
+
+    EXPECT_EQ(2u, _renderer->GetFrameDrawCalls());
+}
+
+TEST_F(RenderThreadTest, RendererAssertsOnOtherThreads)
+{
+    // Only the thread that created the renderer, or the one it was handed to, may use it
+    EXPECT_DEBUG_DEATH(
+        std::thread([this]() { _renderer->RenderClear(); }).join(),
+        ""
+    );
+}
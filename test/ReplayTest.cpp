@@ -0,0 +1,262 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h" //EXPECT_THAT macro, matchers
+
+#include "Constants.hpp"
+#include "GameLevel.hpp"
+#include "GameObject.hpp"
+#include "Input.hpp"
+#include "Logger.hpp"
+#include "Replay.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+
+namespace
+{
+    const std::string REPLAY_FILEPATH = "ReplayTest.bin";
+    const Timestep    DT(1.0 / static_cast<double>(Constants::TARGET_UPS));
+
+    /// A headless level along with the player and the input it is played with.
+    struct HeadlessLevel
+    {
+        HeadlessLevel(GameLevel::Mode mode, unsigned int seed)
+            : input()
+            , player(GameObject::CreatePlayer(
+                input, 0.0f, 0.0f,
+                Constants::Player::MOVE_FORCE,
+                Constants::Player::RADIUS,
+                nullptr,
+                Constants::Colors::LIGHT
+            ))
+            , level(GameLevel::CreateHeadlessLevel(
+                input, mode, seed, Constants::Level::ARENA_SIZE,
+                Constants::Level::GRAVITY, Constants::Level::FRICTION, Constants::Level::INITIAL_TIME,
+                player.get()
+            ))
+        {
+            //
+        }
+
+        Input                         input;
+        std::unique_ptr<PlayerObject> player;
+        std::unique_ptr<GameLevel>    level;
+    };
+
+    /// A headless level that is recorded into REPLAY_FILEPATH while it is played.
+    struct RecordedLevel : public HeadlessLevel
+    {
+        RecordedLevel(GameLevel::Mode mode, unsigned int seed)
+            : HeadlessLevel(mode, seed)
+            , recorder(*level, REPLAY_FILEPATH)
+        {
+            //
+        }
+
+        /// Plays the level like the game loop does on a machine with an uneven frame rate: the keys
+        /// change every now and then, and the amount of updates between the input handlings varies.
+        void Play(size_t inputsCount)
+        {
+            for (size_t i = 0; i < inputsCount; ++i)
+            {
+                input.SetKeyPressed(Input::KeyCode::RIGHT, i % 200 < 150);
+                input.SetKeyPressed(Input::KeyCode::LEFT,  i % 200 >= 170);
+                input.SetKeyPressed(Input::KeyCode::UP,    i % 30 < 10);
+                input.SetKeyPressed(Input::KeyCode::SPACE, i % 45 < 5);
+
+                level->HandleInput();
+                recorder.RecordInput(input);
+                for (size_t u = 0; u < i % 4; ++u)
+                {
+                    level->Update(DT);
+                    level->HandleCollisions();
+                    recorder.RecordUpdate();
+                }
+            }
+        }
+
+        ReplayRecorder recorder;
+    };
+
+    /// A headless level that plays a replay.
+    struct PlayedLevel : public HeadlessLevel
+    {
+        PlayedLevel(const Replay& replay)
+            : HeadlessLevel(replay.GetMode(), replay.GetSeed())
+            , replayPlayer(replay, *level, input)
+        {
+            //
+        }
+
+        ReplayPlayer replayPlayer;
+    };
+
+    void expectReproduced(const RecordedLevel& recorded, const ReplayPlayer::Summary& summary)
+    {
+        EXPECT_EQ(recorded.recorder.GetUpdatesCount(), summary.Updates);
+        EXPECT_DOUBLE_EQ(recorded.level->GetPlayerDistance(), summary.Distance);
+        EXPECT_EQ(recorded.level->GetScore(),      summary.Score);
+        EXPECT_EQ(recorded.level->GetFallsCount(), summary.Falls);
+        EXPECT_EQ(recorded.level->IsCompleted(),   summary.Completed);
+    }
+
+    void expectEqualLevels(const HeadlessLevel& expected, const HeadlessLevel& actual)
+    {
+        EXPECT_FLOAT_EQ(expected.player->GetPosition().x, actual.player->GetPosition().x);
+        EXPECT_FLOAT_EQ(expected.player->GetPosition().y, actual.player->GetPosition().y);
+        EXPECT_FLOAT_EQ(expected.player->GetVelocity().x, actual.player->GetVelocity().x);
+        EXPECT_FLOAT_EQ(expected.player->GetVelocity().y, actual.player->GetVelocity().y);
+        EXPECT_DOUBLE_EQ(expected.level->GetPlayerDistance(), actual.level->GetPlayerDistance());
+        EXPECT_DOUBLE_EQ(expected.level->GetTimeLeft(), actual.level->GetTimeLeft());
+        EXPECT_EQ(expected.level->GetFallsCount(), actual.level->GetFallsCount());
+    }
+} // end anonymous namespace
+
+
+class ReplayTest : public ::testing::TestWithParam<GameLevel::Mode>
+{
+protected:
+    void SetUp(void) override
+    {
+        Logger::SetLogLevel(Logger::Level::CRITICAL);
+    }
+
+    void TearDown(void) override
+    {
+        std::remove(REPLAY_FILEPATH.c_str());
+    }
+};
+
+
+TEST(ReplayKeysTest, KeysRoundTripThroughTheBitmask)
+{
+    Input input;
+    input.SetKeyPressed(Input::KeyCode::LEFT,  true);
+    input.SetKeyPressed(Input::KeyCode::SPACE, true);
+    const uint8_t keys = Replay::GetKeys(input);
+
+    Input played;
+    played.SetKeyPressed(Input::KeyCode::RIGHT, true);
+    Replay::SetKeys(keys, played);
+
+    for (Input::KeyCode key : Replay::KEYS) {
+        EXPECT_EQ(input.IsPressed(key), played.IsPressed(key));
+    }
+    EXPECT_EQ(0, keys & Replay::EVENT_INPUT);
+}
+
+TEST_P(ReplayTest, PlaybackReproducesTheSession)
+{
+    RecordedLevel recorded(GetParam(), 11);
+    recorded.Play(2000);
+    ASSERT_GT(recorded.level->GetScore(), 0);
+    ASSERT_TRUE(recorded.recorder.Finish());
+
+    std::unique_ptr<Replay> replay = Replay::Open(REPLAY_FILEPATH);
+    ASSERT_NE(nullptr, replay);
+    EXPECT_EQ(GetParam(), replay->GetMode());
+    EXPECT_EQ(11u, replay->GetSeed());
+    EXPECT_EQ(recorded.recorder.GetUpdatesCount(), replay->GetUpdatesCount());
+    EXPECT_EQ(1 + replay->GetUpdatesCount() / (Replay::KEYFRAME_SECONDS * Constants::TARGET_UPS), replay->GetKeyframesCount());
+
+    expectReproduced(recorded, ReplayPlayer::PlayHeadless(*replay));
+}
+
+TEST_P(ReplayTest, SeekMatchesPlayingFromTheStart)
+{
+    RecordedLevel recorded(GetParam(), 12);
+    recorded.Play(3000);
+    ASSERT_TRUE(recorded.recorder.Finish());
+
+    std::unique_ptr<Replay> replay = Replay::Open(REPLAY_FILEPATH);
+    ASSERT_NE(nullptr, replay);
+    ASSERT_GT(replay->GetKeyframesCount(), 2u);
+
+    const size_t keyframeInterval = Replay::KEYFRAME_SECONDS * Constants::TARGET_UPS;
+    const std::vector<size_t> updates = {
+        3000, 700, 701, keyframeInterval, keyframeInterval + 1, 2 * keyframeInterval - 1, replay->GetUpdatesCount()
+    };
+
+    PlayedLevel seeked(*replay);
+    for (size_t update : updates)
+    {
+        ASSERT_TRUE(seeked.replayPlayer.Seek(update, DT));
+        ASSERT_EQ(update, seeked.replayPlayer.GetUpdate());
+
+        PlayedLevel played(*replay);
+        while (played.replayPlayer.GetUpdate() < update) {
+            ASSERT_TRUE(played.replayPlayer.PlayUpdate(DT));
+        }
+        expectEqualLevels(played, seeked);
+    }
+
+    EXPECT_TRUE(seeked.replayPlayer.IsFinished());
+    EXPECT_DOUBLE_EQ(recorded.level->GetPlayerDistance(), seeked.level->GetPlayerDistance());
+}
+
+TEST_P(ReplayTest, RepeatedFramesAreStoredOnce)
+{
+    RecordedLevel recorded(GetParam(), 13);
+    recorded.input.SetKeyPressed(Input::KeyCode::RIGHT, true);
+    for (size_t i = 0; i < 60 * Constants::TARGET_FPS; ++i) // A minute at a steady frame rate
+    {
+        recorded.level->HandleInput();
+        recorded.recorder.RecordInput(recorded.input);
+        for (size_t u = 0; u < Constants::TARGET_UPS / Constants::TARGET_FPS; ++u)
+        {
+            recorded.level->Update(DT);
+            recorded.level->HandleCollisions();
+            recorded.recorder.RecordUpdate();
+        }
+    }
+    ASSERT_TRUE(recorded.recorder.Finish());
+
+    std::unique_ptr<Replay> replay = Replay::Open(REPLAY_FILEPATH);
+    ASSERT_NE(nullptr, replay);
+
+    // Apart from the keyframes, only a run per keyframe interval and the index remain
+    std::vector<uint8_t> state;
+    recorded.level->SaveState(state);
+    EXPECT_LT(replay->GetFileSize(), replay->GetKeyframesCount() * (state.size() + 64) + 64);
+}
+
+TEST_P(ReplayTest, OpenRejectsInvalidFiles)
+{
+    EXPECT_EQ(nullptr, Replay::Open(REPLAY_FILEPATH)); // Does not exist
+
+    {
+        RecordedLevel recorded(GetParam(), 14);
+        recorded.Play(10);
+    }
+    std::vector<uint8_t> contents;
+    {
+        std::ifstream file(REPLAY_FILEPATH, std::ios::binary);
+        contents.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+    ASSERT_NE(nullptr, Replay::Open(REPLAY_FILEPATH));
+
+    const auto writeFile = [](const std::vector<uint8_t>& bytes) {
+        std::ofstream file(REPLAY_FILEPATH, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    };
+
+    writeFile(std::vector<uint8_t>(contents.begin(), contents.end() - 1)); // Unfinished recording
+    EXPECT_EQ(nullptr, Replay::Open(REPLAY_FILEPATH));
+
+    std::vector<uint8_t> version = contents;
+    ++version[4];
+    writeFile(version);
+    EXPECT_EQ(nullptr, Replay::Open(REPLAY_FILEPATH));
+
+    writeFile(std::vector<uint8_t>(64, 0x47));
+    EXPECT_EQ(nullptr, Replay::Open(REPLAY_FILEPATH));
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    Modes, ReplayTest,
+    ::testing::Values(GameLevel::Mode::FIXED, GameLevel::Mode::ENDLESS)
+);
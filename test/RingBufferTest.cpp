@@ -0,0 +1,98 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h" //EXPECT_THAT macro, matchers
+
+#include "RingBuffer.hpp"
+
+
+TEST(RingBufferTest, DefaultConstructedIsEmpty)
+{
+    RingBuffer<int, 4> rb;
+
+    EXPECT_TRUE(rb.IsEmpty());
+    EXPECT_FALSE(rb.IsFull());
+    EXPECT_EQ(0u, rb.Size());
+    EXPECT_EQ(4u, rb.GetCapacity());
+}
+
+TEST(RingBufferTest, PushBackAddsElementsInOrder)
+{
+    RingBuffer<int, 4> rb;
+    rb.PushBack() = 1;
+    rb.PushBack() = 2;
+    rb.PushBack() = 3;
+
+    EXPECT_EQ(3u, rb.Size());
+    EXPECT_EQ(1, rb.Front());
+    EXPECT_EQ(3, rb.Back());
+    EXPECT_EQ(1, rb[0]);
+    EXPECT_EQ(2, rb[1]);
+    EXPECT_EQ(3, rb[2]);
+}
+
+TEST(RingBufferTest, PushBackToFullBufferDropsOldest)
+{
+    RingBuffer<int, 3> rb;
+    for (int i = 1; i <= 5; ++i) {
+        rb.PushBack() = i;
+    }
+
+    EXPECT_TRUE(rb.IsFull());
+    EXPECT_EQ(3u, rb.Size());
+    EXPECT_EQ(3, rb[0]);
+    EXPECT_EQ(4, rb[1]);
+    EXPECT_EQ(5, rb[2]);
+}
+
+TEST(RingBufferTest, PushBackToFullBufferRecyclesOldestElementInPlace)
+{
+    RingBuffer<int, 2> rb;
+    rb.PushBack() = 10;
+    rb.PushBack() = 20;
+
+    const int* oldestAddress = &rb.Front();
+    int& recycled = rb.PushBack();
+
+    EXPECT_EQ(oldestAddress, &recycled);
+    EXPECT_EQ(10, recycled); // Not reset
+    EXPECT_EQ(20, rb.Front());
+}
+
+TEST(RingBufferTest, PopFrontRemovesOldest)
+{
+    RingBuffer<int, 3> rb;
+    rb.PushBack() = 1;
+    rb.PushBack() = 2;
+    rb.PopFront();
+
+    EXPECT_EQ(1u, rb.Size());
+    EXPECT_EQ(2, rb.Front());
+    EXPECT_EQ(2, rb.Back());
+
+    rb.PopFront();
+    EXPECT_TRUE(rb.IsEmpty());
+}
+
+TEST(RingBufferTest, ClearEmptiesBuffer)
+{
+    RingBuffer<int, 3> rb;
+    rb.PushBack() = 1;
+    rb.PushBack() = 2;
+    rb.Clear();
+
+    EXPECT_TRUE(rb.IsEmpty());
+    rb.PushBack() = 3;
+    EXPECT_EQ(3, rb.Front());
+    EXPECT_EQ(1u, rb.Size());
+}
+
+TEST(RingBufferTest, WrapsAroundManyTimes)
+{
+    RingBuffer<size_t, 4> rb;
+    for (size_t i = 0; i < 1000; ++i) {
+        rb.PushBack() = i;
+    }
+
+    for (size_t i = 0; i < rb.Size(); ++i) {
+        EXPECT_EQ(996 + i, rb[i]);
+    }
+}
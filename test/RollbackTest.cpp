@@ -0,0 +1,147 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h" //EXPECT_THAT macro, matchers
+
+#include "Constants.hpp"
+#include "GameLevel.hpp"
+#include "GameObject.hpp"
+#include "Input.hpp"
+#include "Logger.hpp"
+#include "Replay.hpp"
+#include "Rollback.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+
+namespace
+{
+    const Timestep DT(1.0 / static_cast<double>(Constants::TARGET_UPS));
+
+    /// A headless level along with the player and the input it is played with.
+    struct HeadlessLevel
+    {
+        HeadlessLevel(GameLevel::Mode mode, unsigned int seed)
+            : input()
+            , player(GameObject::CreatePlayer(
+                input, 0.0f, 0.0f,
+                Constants::Player::MOVE_FORCE,
+                Constants::Player::RADIUS,
+                nullptr,
+                Constants::Colors::LIGHT
+            ))
+            , level(GameLevel::CreateHeadlessLevel(
+                input, mode, seed, Constants::Level::ARENA_SIZE,
+                Constants::Level::GRAVITY, Constants::Level::FRICTION, Constants::Level::INITIAL_TIME,
+                player.get()
+            ))
+        {
+            //
+        }
+
+        Input                         input;
+        std::unique_ptr<PlayerObject> player;
+        std::unique_ptr<GameLevel>    level;
+    };
+
+    /// The input of the remote player, which holds the keys for a while like a human would.
+    uint8_t getKeys(size_t tick)
+    {
+        Input input;
+        input.SetKeyPressed(Input::KeyCode::RIGHT, tick % 400 < 320);
+        input.SetKeyPressed(Input::KeyCode::LEFT,  tick % 400 >= 360);
+        input.SetKeyPressed(Input::KeyCode::UP,    tick % 60 < 15);
+        input.SetKeyPressed(Input::KeyCode::SPACE, tick % 90 < 6);
+        return Replay::GetKeys(input);
+    }
+
+    /// Simulates the level with the actual inputs, as if they had arrived in time.
+    void simulate(HeadlessLevel& headless, size_t ticks)
+    {
+        for (size_t tick = 0; tick < ticks; ++tick)
+        {
+            Replay::SetKeys(getKeys(tick), headless.input);
+            headless.level->HandleInput();
+            headless.level->Update(DT);
+            headless.level->HandleCollisions();
+        }
+    }
+
+    void expectEqualStates(const GameLevel& expected, const GameLevel& actual)
+    {
+        std::vector<uint8_t> expectedState, actualState;
+        expected.SaveState(expectedState);
+        actual.SaveState(actualState);
+        EXPECT_EQ(expectedState, actualState);
+        EXPECT_DOUBLE_EQ(expected.GetPlayerDistance(), actual.GetPlayerDistance());
+    }
+} // end anonymous namespace
+
+
+/// Parametrized with the level mode, the delay and the jitter of the peer.
+class RollbackTest : public ::testing::TestWithParam<std::tuple<GameLevel::Mode, size_t, size_t>>
+{
+protected:
+    void SetUp(void) override
+    {
+        Logger::SetLogLevel(Logger::Level::CRITICAL);
+    }
+};
+
+
+TEST_P(RollbackTest, LateInputsAreResimulatedToTheActualState)
+{
+    const auto [mode, delay, jitter] = GetParam();
+    const size_t ticks = 2400;
+
+    HeadlessLevel   rolledBack(mode, 21);
+    RollbackSession session(*rolledBack.level, rolledBack.input);
+    LocalPeer       peer(delay, jitter, 5);
+    for (size_t tick = 0; tick < ticks; ++tick)
+    {
+        peer.Send(tick, getKeys(tick));
+        peer.Deliver(tick, session);
+        session.AdvanceTick(DT);
+    }
+    peer.Flush(session);
+    session.Synchronize(DT);
+
+    HeadlessLevel actual(mode, 21);
+    simulate(actual, ticks);
+    ASSERT_GT(actual.level->GetScore(), 0);
+    expectEqualStates(*actual.level, *rolledBack.level);
+
+    const RollbackSession::Stats& stats = session.GetStats();
+    EXPECT_EQ(ticks, session.GetTick());
+    EXPECT_EQ(0u, stats.RejectedInputs);
+    EXPECT_LE(stats.MaxResimulatedTicks, delay + jitter + 1);
+    if (delay + jitter > 0) {
+        EXPECT_GT(stats.Rollbacks, 0u);
+    } else {
+        EXPECT_EQ(0u, stats.Rollbacks);
+    }
+}
+
+TEST(RollbackSessionTest, InputsOlderThanTheBufferAreRejected)
+{
+    Logger::SetLogLevel(Logger::Level::CRITICAL);
+    HeadlessLevel   headless(GameLevel::Mode::FIXED, 22);
+    RollbackSession session(*headless.level, headless.input);
+    for (size_t tick = 0; tick < RollbackSession::MAX_ROLLBACK_TICKS + 5; ++tick) {
+        session.AdvanceTick(DT);
+    }
+
+    EXPECT_FALSE(session.AddInput(4, getKeys(4)));
+    EXPECT_TRUE(session.AddInput(5, getKeys(5)));
+    EXPECT_EQ(1u, session.GetStats().RejectedInputs);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    Peers, RollbackTest,
+    ::testing::Combine(
+        ::testing::Values(GameLevel::Mode::FIXED, GameLevel::Mode::ENDLESS),
+        ::testing::Values(0, 6),     // Delay
+        ::testing::Values(0, 12)     // Jitter
+    )
+);
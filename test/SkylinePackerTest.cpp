@@ -0,0 +1,112 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h" //EXPECT_THAT macro, matchers
+
+#include "SkylinePacker.hpp"
+#include "Helpers.hpp"
+
+#include <vector>
+
+
+namespace
+{
+    bool overlaps(const Rectangle& a, const Rectangle& b)
+    {
+        return a.X < b.X + b.W && b.X < a.X + a.W && a.Y < b.Y + b.H && b.Y < a.Y + a.H;
+    }
+
+    /// Inserts rectangles of random sizes until count have been packed or one does not fit.
+    std::vector<Rectangle> packRandom(SkylinePacker& packer, Helpers::random::Generator& random, size_t count)
+    {
+        std::vector<Rectangle> packed;
+        for (size_t i = 0; i < count; ++i)
+        {
+            const Dimensions2D size = {
+                static_cast<int>(random.FloatInRange(4.0f, 96.0f)),
+                static_cast<int>(random.FloatInRange(4.0f, 48.0f))
+            };
+            Point2D position;
+            if (!packer.Insert(size, position)) {
+                break;
+            }
+            packed.push_back({ position.X, position.Y, size.W, size.H });
+        }
+        return packed;
+    }
+} // end anonymous namespace
+
+
+TEST(SkylinePackerTest, PackedRectanglesAreInsideAndDisjoint)
+{
+    Helpers::random::Generator random(1);
+    SkylinePacker packer({ 512, 512 });
+    const std::vector<Rectangle> packed = packRandom(packer, random, 1000);
+    ASSERT_GT(packed.size(), 50u);
+
+    for (size_t i = 0; i < packed.size(); ++i)
+    {
+        const Rectangle& rect = packed[i];
+        ASSERT_GE(rect.X, 0);
+        ASSERT_GE(rect.Y, 0);
+        ASSERT_LE(rect.X + rect.W, 512);
+        ASSERT_LE(rect.Y + rect.H, 512);
+        for (size_t j = i + 1; j < packed.size(); ++j) {
+            ASSERT_FALSE(overlaps(rect, packed[j])) << "Rectangles " << i << " and " << j;
+        }
+    }
+    EXPECT_GT(packer.GetOccupancy(), 0.6f);
+}
+
+TEST(SkylinePackerTest, FillsTheAreaWithEqualSquares)
+{
+    SkylinePacker packer({ 64, 64 });
+    Point2D position;
+    for (int i = 0; i < 16; ++i) {
+        ASSERT_TRUE(packer.Insert({ 16, 16 }, position)) << "Square " << i;
+    }
+    EXPECT_FLOAT_EQ(1.0f, packer.GetOccupancy());
+    EXPECT_FALSE(packer.Insert({ 1, 1 }, position));
+}
+
+TEST(SkylinePackerTest, PlacesOnTheLowestSegment)
+{
+    SkylinePacker packer({ 100, 100 });
+    Point2D position;
+    ASSERT_TRUE(packer.Insert({ 60, 50 }, position));
+    EXPECT_EQ(0, position.X);
+    EXPECT_EQ(0, position.Y);
+
+    // Fits next to the first one
+    ASSERT_TRUE(packer.Insert({ 40, 10 }, position));
+    EXPECT_EQ(60, position.X);
+    EXPECT_EQ(0, position.Y);
+
+    // Too wide to fit next to the first one, rests on top of it
+    ASSERT_TRUE(packer.Insert({ 70, 10 }, position));
+    EXPECT_EQ(0, position.X);
+    EXPECT_EQ(50, position.Y);
+}
+
+TEST(SkylinePackerTest, RejectsWhatDoesNotFit)
+{
+    SkylinePacker packer({ 100, 50 });
+    Point2D position;
+    EXPECT_FALSE(packer.Insert({ 101, 10 }, position));
+    EXPECT_FALSE(packer.Insert({ 10, 51 }, position));
+    EXPECT_FALSE(packer.Insert({ 0, 10 }, position));
+    EXPECT_TRUE(packer.Insert({ 100, 50 }, position));
+    EXPECT_FALSE(packer.Insert({ 1, 1 }, position));
+}
+
+TEST(SkylinePackerTest, ClearFreesTheArea)
+{
+    SkylinePacker packer({ 32, 32 });
+    Point2D position;
+    ASSERT_TRUE(packer.Insert({ 32, 32 }, position));
+    ASSERT_FALSE(packer.Insert({ 8, 8 }, position));
+
+    packer.Clear();
+    EXPECT_FLOAT_EQ(0.0f, packer.GetOccupancy());
+    ASSERT_TRUE(packer.Insert({ 8, 8 }, position));
+    EXPECT_EQ(0, position.X);
+    EXPECT_EQ(0, position.Y);
+}
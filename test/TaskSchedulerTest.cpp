@@ -0,0 +1,101 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h" //EXPECT_THAT macro, matchers
+
+#include "TaskScheduler.hpp"
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+
+TEST(TaskSchedulerTest, ForEachDoesOneItemPerStep)
+{
+    std::vector<size_t> done;
+    TaskScheduler::Step step = TaskScheduler::ForEach(3, [&done](size_t i) { done.push_back(i); });
+
+    EXPECT_FALSE(step());
+    EXPECT_FALSE(step());
+    EXPECT_TRUE(step());
+    EXPECT_EQ((std::vector<size_t>{ 0, 1, 2 }), done);
+
+    EXPECT_TRUE(TaskScheduler::ForEach(0, [](size_t) { FAIL(); })());
+}
+
+TEST(TaskSchedulerTest, SpentBudgetContinuesNextFrame)
+{
+    TaskScheduler scheduler;
+    size_t steps = 0;
+    const TaskScheduler::TaskId id = scheduler.Add("Slow", TaskScheduler::ForEach(4, [&steps](size_t)
+    {
+        ++steps;
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }), TaskScheduler::Microseconds(1000));
+
+    scheduler.RunFrame();
+    EXPECT_EQ(1u, steps);
+    EXPECT_TRUE(scheduler.IsPending(id));
+
+    scheduler.RunFrame();
+    scheduler.RunFrame();
+    scheduler.RunFrame();
+    EXPECT_EQ(4u, steps);
+    EXPECT_FALSE(scheduler.IsPending(id));
+    EXPECT_EQ(0u, scheduler.GetPendingCount());
+}
+
+TEST(TaskSchedulerTest, OldestTaskProgressesWithoutFrameBudget)
+{
+    TaskScheduler scheduler;
+    size_t first = 0, second = 0;
+    scheduler.Add("First",  TaskScheduler::ForEach(2, [&first](size_t)  { ++first; }));
+    scheduler.Add("Second", TaskScheduler::ForEach(2, [&second](size_t) { ++second; }));
+
+    scheduler.RunFrame(TaskScheduler::Microseconds(0));
+    EXPECT_EQ(1u, first);
+    EXPECT_EQ(0u, second);
+
+    scheduler.RunFrame();
+    EXPECT_EQ(2u, first);
+    EXPECT_EQ(2u, second);
+    EXPECT_EQ(0u, scheduler.GetPendingCount());
+}
+
+TEST(TaskSchedulerTest, FinishAndCancel)
+{
+    TaskScheduler scheduler;
+    size_t finished = 0, cancelled = 0;
+    const TaskScheduler::TaskId finishedId  = scheduler.Add("Finished",  TaskScheduler::ForEach(5, [&finished](size_t)  { ++finished; }));
+    const TaskScheduler::TaskId cancelledId = scheduler.Add("Cancelled", TaskScheduler::ForEach(5, [&cancelled](size_t) { ++cancelled; }));
+    EXPECT_EQ(2u, scheduler.GetPendingCount());
+
+    scheduler.Finish(finishedId);
+    EXPECT_EQ(5u, finished);
+    scheduler.Cancel(cancelledId);
+    EXPECT_EQ(0u, scheduler.GetPendingCount());
+
+    scheduler.RunAll();
+    EXPECT_EQ(0u, cancelled);
+
+    // Unknown and finished tasks are ignored
+    scheduler.Finish(TaskScheduler::NULL_TASK);
+    scheduler.Cancel(finishedId);
+}
+
+TEST(TaskSchedulerTest, StepsCanAddTasks)
+{
+    TaskScheduler scheduler;
+    std::vector<int> order;
+    scheduler.Add("Parent", [&scheduler, &order]()
+    {
+        order.push_back(1);
+        for (int i = 0; i < 100; ++i) { // Grows the vector of the tasks under the running step
+            scheduler.Add("Child", [&order]() { order.push_back(2); return true; });
+        }
+        return true;
+    });
+
+    scheduler.RunAll();
+    EXPECT_EQ(101u, order.size());
+    EXPECT_EQ(1, order.front());
+    EXPECT_EQ(0u, scheduler.GetPendingCount());
+}
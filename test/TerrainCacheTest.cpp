@@ -0,0 +1,300 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h" //EXPECT_THAT macro, matchers
+
+#include "Camera.hpp"
+#include "GameObject.hpp"
+#include "Input.hpp"
+#include "RenderQueue.hpp"
+#include "Renderer.hpp"
+#include "TerrainCache.hpp"
+#include "Window.hpp"
+
+#include <SDL.h>
+#include <memory>
+#include <vector>
+
+
+namespace
+{
+    constexpr float CHUNK_WIDTH = static_cast<float>(TerrainCache::CHUNK_WIDTH);
+    constexpr int   HEIGHT      = 256;
+
+    using Blocks = std::vector<std::unique_ptr<GameObject>>;
+
+    /// Adds a block spanning [x, x + width) on the x-axis.
+    GameObject& addBlock(Blocks& blocks, Input& input, float x, float width)
+    {
+        blocks.push_back(GameObject::CreateBox(input, 0.0f, { x + width / 2.0f, 200.0f }, { width, 40.0f }));
+        return *blocks.back();
+    }
+
+    /// One block in the middle of each of the first count chunks.
+    void addBlockPerChunk(Blocks& blocks, Input& input, int count)
+    {
+        for (int chunk = 0; chunk < count; ++chunk) {
+            addBlock(blocks, input, static_cast<float>(chunk) * CHUNK_WIDTH + 100.0f, 200.0f);
+        }
+    }
+
+    /// Centres a viewport of width on the middle of chunk.
+    void centreOnChunk(Camera& camera, int chunk, int width = TerrainCache::CHUNK_WIDTH)
+    {
+        camera.SetDimensions({ width, HEIGHT });
+        camera.SetCenterPosition(glm::vec3((static_cast<float>(chunk) + 0.5f) * CHUNK_WIDTH, HEIGHT / 2.0f, 0.0f));
+    }
+
+    /// @return The amount of draw commands the cache submits for the viewport of camera.
+    size_t countCommands(const TerrainCache& cache, const Camera& camera)
+    {
+        RenderQueue queue;
+        cache.Draw(queue, camera);
+        return queue.GetCount();
+    }
+
+    /// Bakes into the render targets of the software renderer of the dummy video driver.
+    class TerrainCacheBakeTest : public ::testing::Test
+    {
+    protected:
+        void SetUp(void) override
+        {
+            SDL_setenv("SDL_VIDEODRIVER", "dummy", 1);
+            ASSERT_EQ(0, SDL_Init(SDL_INIT_VIDEO)) << SDL_GetError();
+            _window   = std::make_unique<Window>("TerrainCacheTest", Dimensions2D{ 64, 64 });
+            _renderer = std::make_unique<Renderer>(*_window, false, false);
+            ASSERT_NE(nullptr, _renderer->GetSdlRenderer()) << SDL_GetError();
+            ASSERT_EQ(SDL_TRUE, SDL_RenderTargetSupported(_renderer->GetSdlRenderer()));
+
+            addBlockPerChunk(_blocks, _input, 8);
+            _cache.SetBlocks(_blocks);
+        }
+
+        void TearDown(void) override
+        {
+            _renderer.reset();
+            _window.reset();
+            SDL_Quit();
+        }
+
+        std::unique_ptr<Window>   _window;
+        std::unique_ptr<Renderer> _renderer;
+        Input                     _input;
+        Blocks                    _blocks;
+        TerrainCache              _cache{ HEIGHT };
+        Camera                    _camera;
+    };
+} // end anonymous namespace
+
+
+TEST(TerrainCacheTest, AssignsBlocksToOverlappedChunks)
+{
+    Input  input;
+    Blocks blocks;
+    addBlock(blocks, input, 100.0f, 200.0f);   // Chunk 0
+    addBlock(blocks, input, 900.0f, 300.0f);   // Chunks 0 and 1
+    addBlock(blocks, input, -100.0f, 150.0f);  // Chunk 0, left of the level
+    addBlock(blocks, input, -300.0f, 200.0f);  // Left of the level only, ignored
+    addBlock(blocks, input, 2100.0f, 100.0f);  // Chunk 2
+
+    TerrainCache cache(HEIGHT);
+    cache.SetBlocks(blocks);
+
+    // None of the chunks is baked, so the blocks are filled one by one
+    Camera camera;
+    centreOnChunk(camera, 0);
+    EXPECT_EQ(3u, countCommands(cache, camera));
+    centreOnChunk(camera, 1);
+    EXPECT_EQ(1u, countCommands(cache, camera));
+    centreOnChunk(camera, 2);
+    EXPECT_EQ(1u, countCommands(cache, camera));
+    centreOnChunk(camera, 3);
+    EXPECT_EQ(0u, countCommands(cache, camera));
+
+    // Straddling chunks 0 and 1
+    camera.SetCenterPosition(glm::vec3(CHUNK_WIDTH, HEIGHT / 2.0f, 0.0f));
+    EXPECT_EQ(4u, countCommands(cache, camera));
+
+    // The blocks are assigned again, not appended
+    blocks.resize(1);
+    cache.SetBlocks(blocks);
+    centreOnChunk(camera, 0);
+    EXPECT_EQ(1u, countCommands(cache, camera));
+    centreOnChunk(camera, 2);
+    EXPECT_EQ(0u, countCommands(cache, camera));
+}
+
+TEST(TerrainCacheTest, BakeRangeWidensViewportByHalfAChunk)
+{
+    Input  input;
+    Blocks blocks;
+    addBlockPerChunk(blocks, input, 10);
+    TerrainCache cache(HEIGHT);
+    cache.SetBlocks(blocks);
+
+    Camera camera;
+    int    first = -1;
+    int    last  = -1;
+
+    centreOnChunk(camera, 5);
+    cache.GetBakeRange(camera, first, last);
+    EXPECT_EQ(4, first);
+    EXPECT_EQ(6, last);
+
+    // Clamped to the chunks that have blocks
+    centreOnChunk(camera, 0);
+    cache.GetBakeRange(camera, first, last);
+    EXPECT_EQ(0, first);
+    EXPECT_EQ(1, last);
+
+    centreOnChunk(camera, 9);
+    cache.GetBakeRange(camera, first, last);
+    EXPECT_EQ(8, first);
+    EXPECT_EQ(9, last);
+}
+
+TEST(TerrainCacheTest, BakeRangeIsTrimmedToPoolAroundCentre)
+{
+    Input  input;
+    Blocks blocks;
+    addBlockPerChunk(blocks, input, 10);
+    TerrainCache cache(HEIGHT);
+    cache.SetBlocks(blocks);
+
+    // A viewport of four chunks widens to six, chunks 2 to 7
+    Camera camera;
+    camera.SetDimensions({ 4 * TerrainCache::CHUNK_WIDTH, HEIGHT });
+    camera.SetCenterPosition(glm::vec3(5.0f * CHUNK_WIDTH, HEIGHT / 2.0f, 0.0f));
+
+    int first = -1;
+    int last  = -1;
+    cache.GetBakeRange(camera, first, last);
+    EXPECT_EQ(static_cast<int>(TerrainCache::POOL_SIZE), last - first + 1);
+    EXPECT_EQ(3, first);
+    EXPECT_EQ(6, last);
+
+    // Centred in chunk 4 instead, trimmed from the right
+    camera.SetCenterPosition(glm::vec3(5.0f * CHUNK_WIDTH - 1.0f, HEIGHT / 2.0f, 0.0f));
+    cache.GetBakeRange(camera, first, last);
+    EXPECT_EQ(2, first);
+    EXPECT_EQ(5, last);
+}
+
+TEST(TerrainCacheTest, BakeRangeIsEmptyWithoutBlocks)
+{
+    const Blocks blocks;
+    TerrainCache cache(HEIGHT);
+    cache.SetBlocks(blocks);
+
+    Camera camera;
+    centreOnChunk(camera, 0);
+    int first = -1;
+    int last  = -1;
+    cache.GetBakeRange(camera, first, last);
+    EXPECT_LT(last, first);
+    EXPECT_EQ(0u, countCommands(cache, camera));
+}
+
+TEST_F(TerrainCacheBakeTest, BakesChunksNearViewport)
+{
+    addBlock(_blocks, _input, 400.0f, 100.0f);
+    addBlock(_blocks, _input, 600.0f, 100.0f);
+    _cache.SetBlocks(_blocks);
+
+    centreOnChunk(_camera, 0);
+    EXPECT_EQ(3u, countCommands(_cache, _camera));
+    EXPECT_TRUE(_cache.NeedsBaking(*_renderer, _camera));
+
+    _cache.Bake(*_renderer, _camera);
+    EXPECT_EQ(2u, _cache.GetBakesCount());
+    EXPECT_TRUE(_cache.IsBaked(0));
+    EXPECT_TRUE(_cache.IsBaked(1));
+    EXPECT_FALSE(_cache.IsBaked(2));
+    EXPECT_FALSE(_cache.NeedsBaking(*_renderer, _camera));
+
+    // One copy of the baked chunk instead of its blocks
+    EXPECT_EQ(1u, countCommands(_cache, _camera));
+
+    // Nothing to do until the camera moves
+    _cache.Bake(*_renderer, _camera);
+    EXPECT_EQ(2u, _cache.GetBakesCount());
+}
+
+TEST_F(TerrainCacheBakeTest, EvictsChunksFarthestFromBakeRange)
+{
+    centreOnChunk(_camera, 0);
+    _cache.Bake(*_renderer, _camera); // Chunks 0 and 1
+
+    // Chunks 2 to 4 need three slots, two are free and chunk 0 is farther than chunk 1
+    centreOnChunk(_camera, 3);
+    EXPECT_TRUE(_cache.NeedsBaking(*_renderer, _camera));
+    _cache.Bake(*_renderer, _camera);
+    EXPECT_EQ(5u, _cache.GetBakesCount());
+    EXPECT_FALSE(_cache.IsBaked(0));
+    for (int chunk = 1; chunk <= 4; ++chunk) {
+        EXPECT_TRUE(_cache.IsBaked(chunk)) << "chunk " << chunk;
+    }
+
+    // Back to the start, chunk 1 is still baked and chunk 4 is evicted for chunk 0
+    centreOnChunk(_camera, 0);
+    _cache.Bake(*_renderer, _camera);
+    EXPECT_EQ(6u, _cache.GetBakesCount());
+    for (int chunk = 0; chunk <= 3; ++chunk) {
+        EXPECT_TRUE(_cache.IsBaked(chunk)) << "chunk " << chunk;
+    }
+    EXPECT_FALSE(_cache.IsBaked(4));
+}
+
+TEST_F(TerrainCacheBakeTest, RebakesRecoloredChunks)
+{
+    Blocks straddling;
+    addBlock(straddling, _input, CHUNK_WIDTH - 50.0f, 100.0f); // Chunks 0 and 1
+    _blocks.push_back(std::move(straddling.front()));
+    _cache.SetBlocks(_blocks);
+
+    centreOnChunk(_camera, 0);
+    _cache.Bake(*_renderer, _camera);
+    ASSERT_EQ(2u, _cache.GetBakesCount());
+
+    // The block of chunk 1 only
+    _blocks[1]->SetColor({ 10, 20, 30, 255 });
+    EXPECT_TRUE(_cache.IsBaked(0));
+    EXPECT_FALSE(_cache.IsBaked(1));
+    EXPECT_TRUE(_cache.NeedsBaking(*_renderer, _camera));
+
+    // Drawn block by block until baked again
+    centreOnChunk(_camera, 1);
+    EXPECT_EQ(2u, countCommands(_cache, _camera));
+    centreOnChunk(_camera, 0);
+    _cache.Bake(*_renderer, _camera);
+    EXPECT_EQ(3u, _cache.GetBakesCount());
+    EXPECT_TRUE(_cache.IsBaked(1));
+
+    // Both chunks of the straddling block
+    _blocks.back()->SetColor({ 40, 50, 60, 255 });
+    EXPECT_FALSE(_cache.IsBaked(0));
+    EXPECT_FALSE(_cache.IsBaked(1));
+    _cache.Bake(*_renderer, _camera);
+    EXPECT_EQ(5u, _cache.GetBakesCount());
+    EXPECT_FALSE(_cache.NeedsBaking(*_renderer, _camera));
+}
+
+TEST_F(TerrainCacheBakeTest, RebakesAfterTargetsReset)
+{
+    centreOnChunk(_camera, 3);
+    _cache.Bake(*_renderer, _camera); // Chunks 2 to 4
+    centreOnChunk(_camera, 0);
+    _cache.Bake(*_renderer, _camera); // Chunks 0 and 1, chunk 4 evicted
+    ASSERT_EQ(5u, _cache.GetBakesCount());
+    EXPECT_FALSE(_cache.NeedsBaking(*_renderer, _camera));
+
+    _renderer->NotifyTargetsReset();
+    EXPECT_TRUE(_cache.NeedsBaking(*_renderer, _camera));
+
+    // All the contents are lost, only the chunks near the viewport are baked again
+    _cache.Bake(*_renderer, _camera);
+    EXPECT_EQ(7u, _cache.GetBakesCount());
+    EXPECT_TRUE(_cache.IsBaked(0));
+    EXPECT_TRUE(_cache.IsBaked(1));
+    EXPECT_FALSE(_cache.IsBaked(2));
+    EXPECT_FALSE(_cache.IsBaked(3));
+    EXPECT_FALSE(_cache.NeedsBaking(*_renderer, _camera));
+}
@@ -0,0 +1,99 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h" //EXPECT_THAT macro, matchers
+
+#include "TileMap.hpp"
+
+#include <vector>
+
+
+TEST(TileMapTest, ResetCreatesEmptyGrid)
+{
+    TileMap map;
+    map.Reset({ 0.0f, 0.0f }, 4, 3, 10.0f);
+
+    EXPECT_EQ(4, map.GetColumns());
+    EXPECT_EQ(3, map.GetRows());
+    for (int row = 0; row < map.GetRows(); ++row) {
+        for (int col = 0; col < map.GetColumns(); ++col) {
+            EXPECT_EQ(Tileset::EMPTY, map.GetTile(col, row));
+        }
+    }
+}
+
+TEST(TileMapTest, FillGroundBlockSetsTopAndFillTiles)
+{
+    TileMap map;
+    map.Reset({ 0.0f, 0.0f }, 4, 4, 10.0f);
+    map.FillGroundBlock({ 10.0f, 20.0f, 20.0f, 20.0f }, Tileset::GROUND_TOP, Tileset::GROUND_FILL);
+
+    for (int col = 0; col < 4; ++col)
+    {
+        const bool inside = col == 1 || col == 2;
+        EXPECT_EQ(Tileset::EMPTY, map.GetTile(col, 0));
+        EXPECT_EQ(Tileset::EMPTY, map.GetTile(col, 1));
+        EXPECT_EQ(inside ? Tileset::GROUND_TOP  : Tileset::EMPTY, map.GetTile(col, 2));
+        EXPECT_EQ(inside ? Tileset::GROUND_FILL : Tileset::EMPTY, map.GetTile(col, 3));
+    }
+}
+
+TEST(TileMapTest, FillGroundBlockSnapsToGrid)
+{
+    TileMap map;
+    map.Reset({ 100.0f, 0.0f }, 10, 10, 10.0f);
+    map.FillGroundBlock({ 114.0f, 76.0f, 22.0f, 24.0f }, Tileset::GROUND_TOP, Tileset::GROUND_FILL);
+
+    std::vector<RectangleF> colliders;
+    map.BuildColliders(colliders);
+
+    ASSERT_EQ(1u, colliders.size());
+    EXPECT_FLOAT_EQ(110.0f, colliders[0].X);
+    EXPECT_FLOAT_EQ(80.0f,  colliders[0].Y);
+    EXPECT_FLOAT_EQ(30.0f,  colliders[0].W);
+    EXPECT_FLOAT_EQ(20.0f,  colliders[0].H);
+}
+
+TEST(TileMapTest, FillGroundBlockClipsToGrid)
+{
+    TileMap map;
+    map.Reset({ 0.0f, 0.0f }, 4, 4, 10.0f);
+    map.FillGroundBlock({ -30.0f, 20.0f, 50.0f, 20.0f }, Tileset::GROUND_TOP, Tileset::GROUND_FILL);
+
+    std::vector<RectangleF> colliders;
+    map.BuildColliders(colliders);
+
+    ASSERT_EQ(1u, colliders.size());
+    EXPECT_FLOAT_EQ(0.0f,  colliders[0].X);
+    EXPECT_FLOAT_EQ(20.0f, colliders[0].W);
+}
+
+TEST(TileMapTest, BuildCollidersMergesColumnsOfEqualHeight)
+{
+    TileMap map;
+    map.Reset({ 0.0f, 0.0f }, 8, 5, 10.0f);
+    map.FillGroundBlock({ 0.0f,  30.0f, 30.0f, 20.0f }, Tileset::GROUND_TOP, Tileset::GROUND_FILL);
+    map.FillGroundBlock({ 30.0f, 10.0f, 20.0f, 40.0f }, Tileset::GROUND_TOP, Tileset::GROUND_FILL);
+    map.FillGroundBlock({ 60.0f, 30.0f, 20.0f, 20.0f }, Tileset::GROUND_TOP, Tileset::GROUND_FILL);
+
+    std::vector<RectangleF> colliders;
+    map.BuildColliders(colliders);
+
+    ASSERT_EQ(3u, colliders.size());
+    EXPECT_FLOAT_EQ(0.0f,  colliders[0].X); EXPECT_FLOAT_EQ(30.0f, colliders[0].W); EXPECT_FLOAT_EQ(20.0f, colliders[0].H);
+    EXPECT_FLOAT_EQ(30.0f, colliders[1].X); EXPECT_FLOAT_EQ(20.0f, colliders[1].W); EXPECT_FLOAT_EQ(40.0f, colliders[1].H);
+    EXPECT_FLOAT_EQ(60.0f, colliders[2].X); EXPECT_FLOAT_EQ(20.0f, colliders[2].W); EXPECT_FLOAT_EQ(20.0f, colliders[2].H);
+}
+
+TEST(TileMapTest, TranslateXMovesColliders)
+{
+    TileMap map;
+    map.Reset({ 0.0f, 0.0f }, 4, 4, 10.0f);
+    map.FillGroundBlock({ 0.0f, 20.0f, 10.0f, 20.0f }, Tileset::GROUND_TOP, Tileset::GROUND_FILL);
+    map.TranslateX(-1000.0f);
+
+    std::vector<RectangleF> colliders;
+    map.BuildColliders(colliders);
+
+    ASSERT_EQ(1u, colliders.size());
+    EXPECT_FLOAT_EQ(-1000.0f, colliders[0].X);
+    EXPECT_FLOAT_EQ(-1000.0f, map.GetRectangleF().X);
+}
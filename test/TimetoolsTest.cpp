@@ -212,3 +212,26 @@ TEST(GameloopTimer, 144UPSOneFifthSecondMax)
     EXPECT_DOUBLE_EQ(glt.GetUpdateDeltaTime().GetSeconds(), 1. / UPS);
     EXPECT_DOUBLE_EQ(glt.GetUpdateDeltaTime().GetMilliSeconds(), 1000. / UPS);
 }
+
+TEST(GameloopTimer, FastForwardDoesTheGivenUpdatesWithoutSleeping)
+{
+    GameloopTimer glt(60, 120, 0.5);
+    glt.SetFastForward(7);
+    EXPECT_TRUE(glt.IsFastForward());
+
+    for (size_t iteration = 0; iteration < 3; ++iteration)
+    {
+        glt.InitIteration();
+        size_t updates = 0;
+        while (glt.ShouldDoUpdates()) {
+            ++updates;
+        }
+        EXPECT_EQ(7u, updates);
+        EXPECT_DOUBLE_EQ(0.0, glt.GetLag().GetSeconds());
+        EXPECT_DOUBLE_EQ(0.0, glt.GetSleeptime().GetSeconds());
+    }
+    EXPECT_GT(glt.GetFastForwardSpeed(), 0.0);
+
+    glt.SetFastForward(0);
+    EXPECT_FALSE(glt.IsFastForward());
+}